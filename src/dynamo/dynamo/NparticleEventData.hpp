@@ -18,9 +18,14 @@
 #pragma once
 
 #include <dynamo/2particleEventData.hpp>
-#include <list>
+#include <magnet/containers/small_vector.hpp>
 
 namespace dynamo {
+  /*! \brief The changes to the particles caused by an event.
+
+    The changes are held in SmallVector containers, so the common
+    events of one or two particles do not allocate on the heap.
+   */
   class NEventData
   {
   public:
@@ -31,7 +36,7 @@ namespace dynamo {
     NEventData&  operator+=(const ParticleEventData& p) { L1partChanges.push_back(p); return *this; }
     NEventData&  operator+=(const PairEventData& p) { L2partChanges.push_back(p); return *this; }
 
-    std::list<ParticleEventData> L1partChanges;
-    std::list<PairEventData> L2partChanges;
+    magnet::containers::SmallVector<ParticleEventData, 2> L1partChanges;
+    magnet::containers::SmallVector<PairEventData, 1> L2partChanges;
   };
 }
@@ -49,6 +49,21 @@ namespace dynamo {
        "Sets the system time inbetween saving snapshots of the system.")
       ("snapshot-events", boost::program_options::value<size_t>(),
        "Sets the event count inbetween saving snapshots of the system.")
+#ifdef DYNAMO_png_support
+      ("render", boost::program_options::value<double>(),
+       "Sets the system time inbetween rendering images of the system to PNG files (no display is required).")
+      ("render-resolution", boost::program_options::value<std::string>()->default_value("800x600"),
+       "The size of the rendered images, given as \"WIDTHxHEIGHT\".")
+      ("render-view", boost::program_options::value<std::string>()->default_value("0,0,-1"),
+       "The direction the camera looks along when rendering images, given as \"x,y,z\".")
+#endif
+#ifdef DYNAMO_visualizer
+      ("visualizer-stride", boost::program_options::value<size_t>()->default_value(1),
+       "Only render every n-th particle in the visualizer (useful for large systems).")
+      ("visualizer-region", boost::program_options::value<std::string>(),
+       "Only render the particles initially inside this box in the visualizer, "
+       "given as \"xmin,ymin,zmin,xmax,ymax,zmax\" (in the units of the configuration).")
+#endif
       ;
   
     opts.add(simopts);
@@ -89,13 +104,18 @@ namespace dynamo {
   void 
   Engine::setupSim(Simulation& Sim, const std::string filename)
   {
-    Sim.ranGenerator.seed(std::random_device()());
+    unsigned int seed = std::random_device()();
     if (vm.count("random-seed"))
-      Sim.ranGenerator.seed(vm["random-seed"].as<unsigned int>());
+      seed = vm["random-seed"].as<unsigned int>();
+    Sim.ranGenerator.seed(seed);
   
     ////////////////////////Simulation Initialisation!!!!!!!!!!!!!
     //Now load the config
     Sim.loadXMLfile(filename.c_str());
+
+    //The stream state of the configuration file is only continued if
+    //no seed is given on the command line
+    Sim.randomStreams.startupSeed(seed, vm.count("random-seed"));
     
     Sim.endEventCount = vm["events"].as<size_t>();
   
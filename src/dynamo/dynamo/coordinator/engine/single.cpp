@@ -19,6 +19,9 @@
 #include <dynamo/coordinator/engine/single.hpp>
 #include <dynamo/systems/snapshot.hpp>
 #include <dynamo/systems/visualizer.hpp>
+#include <dynamo/systems/render.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <stdio.h>
 
 namespace dynamo {
@@ -93,9 +96,28 @@ namespace dynamo {
 
     setupSim(simulation, vm["config-file"].as<std::vector<std::string> >()[0]);
 
+    //Only one simulation is running, so it may use the thread pool
+    simulation.threads = &threads;
+
 #ifdef DYNAMO_visualizer
     if (_loadVisualiser)
-      simulation.systems.push_back(shared_ptr<System>(new SVisualizer(&simulation, vm["config-file"].as<std::vector<std::string> >()[0], simulation.lastRunMFT)));
+      {
+	Vector regionMin{-HUGE_VAL, -HUGE_VAL, -HUGE_VAL}, regionMax{HUGE_VAL, HUGE_VAL, HUGE_VAL};
+	if (vm.count("visualizer-region"))
+	  {
+	    std::vector<std::string> bounds;
+	    boost::split(bounds, vm["visualizer-region"].as<std::string>(), boost::is_any_of(","));
+	    if (bounds.size() != 2 * NDIM)
+	      M_throw() << "The visualizer region requires " << 2 * NDIM << " comma separated values";
+	    for (size_t i(0); i < NDIM; ++i)
+	      {
+		regionMin[i] = boost::lexical_cast<double>(bounds[i]);
+		regionMax[i] = boost::lexical_cast<double>(bounds[NDIM + i]);
+	      }
+	  }
+
+	simulation.systems.push_back(shared_ptr<System>(new SVisualizer(&simulation, vm["config-file"].as<std::vector<std::string> >()[0], simulation.lastRunMFT, vm["visualizer-stride"].as<size_t>(), regionMin, regionMax)));
+      }
 #endif
 
     if (vm.count("snapshot"))
@@ -104,6 +126,23 @@ namespace dynamo {
     if (vm.count("snapshot-events"))
       simulation.systems.push_back(shared_ptr<System>(new SysSnapshot(&simulation, vm["snapshot-events"].as<size_t>(), "SnapshotEventTimer", "%COUNTe", !vm.count("unwrapped"))));
 
+#ifdef DYNAMO_png_support
+    if (vm.count("render"))
+      {
+	std::vector<std::string> resolution, view;
+	boost::split(resolution, vm["render-resolution"].as<std::string>(), boost::is_any_of("x"));
+	boost::split(view, vm["render-view"].as<std::string>(), boost::is_any_of(","));
+	if ((resolution.size() != 2) || (view.size() != NDIM))
+	  M_throw() << "The render resolution must be given as WIDTHxHEIGHT and the view as x,y,z";
+
+	Vector viewDirection;
+	for (size_t i(0); i < NDIM; ++i)
+	  viewDirection[i] = boost::lexical_cast<double>(view[i]);
+
+	simulation.systems.push_back(shared_ptr<System>(new SysRender(&simulation, vm["render"].as<double>(), "%COUNT", boost::lexical_cast<size_t>(resolution[0]), boost::lexical_cast<size_t>(resolution[1]), viewDirection)));
+      }
+#endif
+
     simulation.initialise();
 
     postSimInit(simulation);
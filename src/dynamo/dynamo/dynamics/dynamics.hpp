@@ -520,6 +520,15 @@ namespace dynamo {
     virtual bool DSMCSpheresTest(Particle& p1, Particle& p2,
 				 double& maxprob, const double& factor,
 				 Vector rij) const = 0;
+
+    /*! \brief As DSMCSpheresTest(Particle&, Particle&, double&,
+      const double&, Vector), but the acceptance test uses the passed
+      uniform random variate (on [0,1)) instead of drawing one from
+      the simulation's generator.
+     */  
+    virtual bool DSMCSpheresTest(Particle& p1, Particle& p2,
+				 double& maxprob, const double& factor,
+				 Vector rij, double uniform) const = 0;
   
     /*! \brief Performs a hard sphere collision between the two
       particles according to the ESMC (Enskog DSMC)
@@ -569,6 +578,16 @@ namespace dynamo {
 						  const double& sqrtT,
 						  const size_t dimensions) const = 0;
 
+    /*! \brief As randomGaussianEvent(Particle&, const double&, const
+      size_t), but the first dimensions components of the passed
+      vector of standard normal variates are used instead of drawing
+      them from the simulation's generator.
+     */
+    virtual ParticleEventData randomGaussianEvent(Particle& part, 
+						  const double& sqrtT,
+						  const Vector& normals,
+						  const size_t dimensions) const = 0;
+
     /*! \brief An XML output operator for the class. Calls the virtual
       OutputXML member function.
      */
@@ -636,6 +655,12 @@ namespace dynamo {
       return partPecTime + part.getPecTime();
     }
 
+    /*! \brief The time the delayed states lag behind the system
+        time, in addition to the Particle::getPecTime() of each
+        particle.
+     */
+    inline double getSystemDelay() const { return partPecTime; }
+
     /*! \brief Called when the system is moved forward in time to update
       the delayed states state.
      */
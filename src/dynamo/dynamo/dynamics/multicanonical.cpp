@@ -29,7 +29,9 @@
 namespace dynamo {
   DynNewtonianMC::DynNewtonianMC(dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     DynNewtonian(tmp),
-    EnergyPotentialStep(1)
+    EnergyPotentialStep(1),
+    _denseOffset(0),
+    _denseComplete(true)
   {
     if (XML.hasNode("PotentialDeformation"))
       {
@@ -49,6 +51,39 @@ namespace dynamo {
 	    _W[lrint(energy / EnergyPotentialStep)] = Wval;
 	  }
       }
+
+    buildDenseW();
+  }
+
+  void
+  DynNewtonianMC::buildDenseW()
+  {
+    _denseW.clear();
+    _denseOffset = 0;
+    _denseComplete = true;
+
+    if (_W.empty()) return;
+
+    typedef std::pair<const int, double> locpair;
+    long minKey = std::numeric_limits<long>::max(), maxKey = std::numeric_limits<long>::min();
+    for (const locpair& val : _W)
+      {
+	minKey = std::min(minKey, long(val.first));
+	maxKey = std::max(maxKey, long(val.first));
+      }
+
+    //A map with widely spread entries is left sparse
+    const size_t span = size_t(maxKey - minKey) + 1;
+    if (span > _maxDenseRatio * _W.size())
+      {
+	_denseComplete = false;
+	return;
+      }
+
+    _denseOffset = minKey;
+    _denseW.assign(span, 0);
+    for (const locpair& val : _W)
+      _denseW[val.first - minKey] = val.second;
   }
 
   void 
@@ -168,5 +203,8 @@ namespace dynamo {
 
     std::swap(EnergyPotentialStep, ol.EnergyPotentialStep);
     std::swap(_W, ol._W);
+    std::swap(_denseW, ol._denseW);
+    std::swap(_denseOffset, ol._denseOffset);
+    std::swap(_denseComplete, ol._denseComplete);
   }
 }
@@ -18,6 +18,7 @@
 #pragma once
 #include <dynamo/dynamics/newtonian.hpp>
 #include <unordered_map>
+#include <vector>
 
 namespace dynamo {
   /*! \brief A Dynamics which implements Newtonian dynamics, but with
@@ -83,11 +84,26 @@ namespace dynamo {
     inline const double& getEnergyStep() const { return EnergyPotentialStep; }
 
     /*! \brief Returns \f$ W(E)\f$.
+
+      The lookup is performed in the dense table of \f$W(E)\f$ which
+      covers every bin between the lowest and highest bins of the
+      map. Energies outside of this window have \f$W(E)=0\f$. Only
+      if the map is too sparse to be tabulated is it searched
+      directly.
      */
     inline double W(double E) const 
     { 
+      const long key = lrint(E / EnergyPotentialStep);
+      //Keys below the window wrap around to large indices
+      const size_t index = size_t(key - _denseOffset);
+      if (index < _denseW.size())
+	return _denseW[index];
+
+      if (_denseComplete)
+	return 0;
+
       std::unordered_map<int, double>::const_iterator 
-	iPtr = _W.find(lrint(E / EnergyPotentialStep));
+	iPtr = _W.find(key);
       if (iPtr != _W.end())
 	return iPtr->second;
       return 0;
@@ -97,7 +113,20 @@ namespace dynamo {
 
   protected:
     virtual void outputXML(magnet::xml::XmlStream& ) const;
+
+    //! \brief Tabulate the map of \f$W(E)\f$ into the dense table.
+    void buildDenseW();
+
     std::unordered_map<int, double> _W; 
     double EnergyPotentialStep;
+
+    //! \brief The \f$W(E)\f$ of the bins from _denseOffset onwards.
+    std::vector<double> _denseW;
+    long _denseOffset;
+    //! \brief True if every entry of the map is in the dense table.
+    bool _denseComplete;
+
+    //! \brief The largest number of bins in the dense table, per entry of the map.
+    static const size_t _maxDenseRatio = 64;
   };
 }
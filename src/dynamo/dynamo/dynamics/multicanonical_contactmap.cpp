@@ -24,6 +24,8 @@
 #include <dynamo/units/units.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <unordered_map>
+#include <algorithm>
 
 namespace dynamo {
   DynNewtonianMCCMap::DynNewtonianMCCMap(dynamo::Simulation* tmp, const magnet::xml::Node& XML):
@@ -31,6 +33,9 @@ namespace dynamo {
   {
     _interaction_name = XML.getAttribute("Interaction");
 
+    //Duplicate single maps are merged, the last one loaded is used
+    std::unordered_map<detail::CaptureMapKey, double, detail::CaptureMapKeyHash> single_W;
+
     if (XML.hasNode("Potential"))
       {
 	for (magnet::xml::Node map_node = XML.getNode("Potential").findNode("Map"); 
@@ -47,11 +52,15 @@ namespace dynamo {
 	    if (distance)
 	      _W.push_back(std::make_pair(map, WData(distance, Wval)));
 	    else {
-	      _single_W[map] = WData(0, Wval);
+	      single_W[map] = Wval;
 	    }
 	  }
       }
 
+    for (const auto& entry : single_W)
+      _single_W.push_back(SingleW(entry.first, entry.second));
+    std::sort(_single_W.begin(), _single_W.end());
+
     dout << "Loaded " << _W.size() << " distance maps." << std::endl;
     dout << "Loaded " << _single_W.size() << " single maps." << std::endl;
   }
@@ -67,11 +76,11 @@ namespace dynamo {
     for (const auto& entry : _single_W)
       {
 	XML << magnet::xml::tag("Map")
-	    << magnet::xml::attr("W") << entry.second._wval
-	    << magnet::xml::attr("Distance") << entry.second._distance
+	    << magnet::xml::attr("W") << entry._wval
+	    << magnet::xml::attr("Distance") << 0
 	  ;
 
-	for (const auto& val : entry.first)
+	for (const auto& val : entry._map)
 	  XML << magnet::xml::tag("Contact")
 	      << magnet::xml::attr("ID1") << val.first.first
 	      << magnet::xml::attr("ID2") << val.first.second
@@ -141,14 +150,26 @@ namespace dynamo {
     double MCDeltaKE = deltaKE;
 
     //If there are entries for the current and possible future energy, then take them into account
-    detail::CaptureMap contact_map = *_interaction;
+    const detail::PairKey key(particle1, particle2);
+    if (_W.empty())
+      {
+	//Only single maps, these are found using the hash of the
+	//interaction's contact map
+	MCDeltaKE += W(key, static_cast<const detail::CaptureMap&>(*_interaction)[key]) * Sim->ensemble->getEnsembleVals()[2];
+	MCDeltaKE -= W(key, newstate) * Sim->ensemble->getEnsembleVals()[2];
+      }
+    else
+      {
+	//The distance maps need a sorted copy of the contact map
+	detail::CaptureMapKey contact_map(*_interaction);
     
-    //Add the current bias potential
-    MCDeltaKE += W(contact_map) * Sim->ensemble->getEnsembleVals()[2];
+	//Add the current bias potential
+	MCDeltaKE += W(contact_map) * Sim->ensemble->getEnsembleVals()[2];
 
-    //subtract the possible bias potential in the new state
-    contact_map[detail::CaptureMap::key_type(particle1, particle2)] = newstate;
-    MCDeltaKE -= W(contact_map) * Sim->ensemble->getEnsembleVals()[2];
+	//subtract the possible bias potential in the new state
+	setState(contact_map, key, newstate);
+	MCDeltaKE -= W(contact_map) * Sim->ensemble->getEnsembleVals()[2];
+      }
 
     //Test if the deformed energy change allows a capture event to occur
     double sqrtArg = retVal.rvdot * retVal.rvdot + 2.0 * R2 * MCDeltaKE / mu;
@@ -193,24 +214,107 @@ namespace dynamo {
 
     DynNewtonianMCCMap& ol(static_cast<DynNewtonianMCCMap&>(oDynamics));
     std::swap(_W, ol._W);
+    std::swap(_single_W, ol._single_W);
   }
 
   double 
-  DynNewtonianMCCMap::W(const detail::CaptureMap& map) const
+  DynNewtonianMCCMap::W(const detail::CaptureMapKey& map) const
   {
-    /*Iterate over all tether maps, finding the distance between them
-      and looking if the tether applies.*/
     size_t applicable_tethers = 0;
     double accumilated_W = 0;
 
-    auto it = _single_W.find(detail::CaptureMapKey(map));
+    const uint64_t hash = map.hash();
+    const auto range = std::equal_range(_single_W.begin(), _single_W.end(), hash);
+    for (auto it = range.first; it != range.second; ++it)
+      if (it->_map == map)
+	{
+	  ++applicable_tethers;
+	  accumilated_W += it->_wval;
+	  break;
+	}
+
+    distanceW(map, applicable_tethers, accumilated_W);
+    return accumilated_W / (applicable_tethers + (applicable_tethers==0));
+  }
 
-    if (it != _single_W.end()) {
-      ++applicable_tethers;
-      accumilated_W += it->second._wval;
-    }
-      
-    for (auto tethermap : _W)
+  double 
+  DynNewtonianMCCMap::W(const detail::PairKey& key, const size_t state) const
+  {
+    size_t applicable_tethers = 0;
+    double accumilated_W = 0;
+
+    const detail::CaptureMap& map = *_interaction;
+
+    //Determine the hash and size of the map with the pair set to
+    //the new state
+    const size_t oldstate = map[key];
+    uint64_t hash = map.getHash();
+    size_t size = map.size();
+    if (oldstate)
+      {
+	hash -= detail::captureEntryHash(key, oldstate);
+	--size;
+      }
+    if (state)
+      {
+	hash += detail::captureEntryHash(key, state);
+	++size;
+      }
+
+    //Confirm the match of any single maps with the same hash
+    const auto range = std::equal_range(_single_W.begin(), _single_W.end(), hash);
+    for (auto it = range.first; it != range.second; ++it)
+      if (it->_map.size() == size)
+	{
+	  bool match = true;
+	  for (const auto& entry : it->_map)
+	    if (entry.second != ((uint64_t(entry.first) == uint64_t(key)) ? state : map[entry.first]))
+	      {
+		match = false;
+		break;
+	      }
+
+	  if (match)
+	    {
+	      ++applicable_tethers;
+	      accumilated_W += it->_wval;
+	      break;
+	    }
+	}
+
+    //The distance maps need a sorted copy of the contact map
+    if (!_W.empty())
+      {
+	detail::CaptureMapKey contact_map(map);
+	setState(contact_map, key, state);
+	distanceW(contact_map, applicable_tethers, accumilated_W);
+      }
+
+    return accumilated_W / (applicable_tethers + (applicable_tethers==0));
+  }
+
+  void
+  DynNewtonianMCCMap::setState(detail::CaptureMapKey& map, const detail::PairKey& key, const size_t state)
+  {
+    const detail::CaptureMapKey::value_type entry(key, state);
+    auto it = std::lower_bound(map.begin(), map.end(), entry, detail::CaptureMapKey::KeyCompare());
+    if ((it != map.end()) && (uint64_t(it->first) == uint64_t(entry.first)))
+      {
+	if (state)
+	  it->second = state;
+	else
+	  map.erase(it);
+      }
+    else if (state)
+      map.insert(it, entry);
+  }
+
+  void
+  DynNewtonianMCCMap::distanceW(const detail::CaptureMapKey& map, size_t& applicable_tethers, double& accumilated_W) const
+  {
+    /*Iterate over all tether maps, finding the distance between them
+      and looking if the tether applies.*/
+    for (const auto& tethermap : _W)
       {
 	auto il = tethermap.first.begin();
 	auto ir = map.begin();
@@ -218,12 +322,12 @@ namespace dynamo {
 	size_t distance = 0;
 	while (il != tethermap.first.end() && ir != map.end())
 	  {
-	    if ((*il).first < (*ir).first)
+	    if (uint64_t((*il).first) < uint64_t((*ir).first))
 	      {
 		++il;
 		++distance;
 	      }
-	    else if ((*ir).first < (*il).first)
+	    else if (uint64_t((*ir).first) < uint64_t((*il).first))
 	      {
 		++ir;
 		++distance;
@@ -253,8 +357,5 @@ namespace dynamo {
 	    accumilated_W += tethermap.second._wval;
 	  }
       }
-
-    return accumilated_W / (applicable_tethers + (applicable_tethers==0));
   }
-
 }
@@ -18,7 +18,7 @@
 #pragma once
 #include <dynamo/dynamics/newtonian.hpp>
 #include <dynamo/interactions/captures.hpp>
-#include <unordered_map>
+#include <vector>
 
 namespace dynamo {
   /*! \brief A Dynamics which implements Newtonian dynamics, but with
@@ -36,7 +36,29 @@ namespace dynamo {
 
     std::vector<std::pair<detail::CaptureMapKey, WData> > _W;
 
-    std::unordered_map<detail::CaptureMapKey, WData, detail::CaptureMapKeyHash> _single_W;
+    /*! \brief A map which only applies to exactly matching contact
+        maps (a Distance of zero).
+     */
+    struct SingleW {
+      SingleW(const detail::CaptureMapKey& map, double wval):
+	_hash(map.hash()), _map(map), _wval(wval) {}
+      uint64_t _hash;
+      detail::CaptureMapKey _map;
+      double _wval;
+
+      bool operator<(const SingleW& o) const { return _hash < o._hash; }
+      friend bool operator<(const SingleW& a, uint64_t hash) { return a._hash < hash; }
+      friend bool operator<(uint64_t hash, const SingleW& a) { return hash < a._hash; }
+    };
+
+    /*! \brief The single maps, sorted by their hash.
+
+      The hash of the current contact map is maintained by the
+      interaction (detail::CaptureMap::getHash()), so the single maps
+      can be found by a binary search without sorting or hashing the
+      contact map.
+     */
+    std::vector<SingleW> _single_W;
 
     std::string _interaction_name;
     std::shared_ptr<ICapture> _interaction;
@@ -48,7 +70,21 @@ namespace dynamo {
     virtual void initialise();
     virtual void replicaExchange(Dynamics& oDynamics);
 
-    double W(const detail::CaptureMap& map) const;
+    double W(const detail::CaptureMapKey& map) const;
+
+    /*! \brief The bias potential of the current contact map of the
+        interaction, with the state of one pair changed.
+     */
+    double W(const detail::PairKey& key, size_t state) const;
+
+  private:
+    //! \brief Set the state of a pair in a sorted contact map.
+    static void setState(detail::CaptureMapKey& map, const detail::PairKey& key, size_t state);
+
+    /*! \brief Add the W of the distance maps within range of the
+        passed contact map.
+     */
+    void distanceW(const detail::CaptureMapKey& map, size_t& applicable_tethers, double& accumilated_W) const;
 
   protected:
     virtual void outputXML(magnet::xml::XmlStream& ) const;
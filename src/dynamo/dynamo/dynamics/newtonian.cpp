@@ -99,6 +99,18 @@ namespace dynamo {
   DynNewtonian::randomGaussianEvent(Particle& part, const double& sqrtT, 
 				  const size_t dimensions) const
   {
+    std::normal_distribution<> norm_dist;
+    Vector normals{0, 0, 0};
+    for (size_t iDim = 0; iDim < dimensions; iDim++)
+      normals[iDim] = norm_dist(Sim->ranGenerator);
+
+    return randomGaussianEvent(part, sqrtT, normals, dimensions);
+  }
+
+  ParticleEventData 
+  DynNewtonian::randomGaussianEvent(Particle& part, const double& sqrtT, 
+				  const Vector& normals, const size_t dimensions) const
+  {
 #ifdef DYNAMO_DEBUG
     if (dimensions > NDIM)
       M_throw() << "Number of dimensions passed larger than NDIM!";
@@ -119,10 +131,9 @@ namespace dynamo {
     double mass = Sim->species[tmpDat.getSpeciesID()]->getMass(part.getID());
     double factor = sqrtT / std::sqrt(mass);
 
-    std::normal_distribution<> norm_dist;
     //Assign the new velocities
     for (size_t iDim = 0; iDim < dimensions; iDim++)
-      part.getVelocity()[iDim] = norm_dist(Sim->ranGenerator) * factor;
+      part.getVelocity()[iDim] = normals[iDim] * factor;
 
     return tmpDat;
   }
@@ -323,6 +334,24 @@ namespace dynamo {
 
   bool 
   DynNewtonian::DSMCSpheresTest(Particle& p1, Particle& p2, double& maxprob, const double& factor, Vector rij) const
+  {
+    const double prob = DSMCSpheresProbability(p1, p2, maxprob, factor, rij);
+    if (prob < 0)
+      return false; //Positive rvdot
+
+    std::uniform_real_distribution<> uniform_dist;
+    return prob > uniform_dist(Sim->ranGenerator) * maxprob;
+  }
+
+  bool 
+  DynNewtonian::DSMCSpheresTest(Particle& p1, Particle& p2, double& maxprob, const double& factor, Vector rij, double uniform) const
+  {
+    const double prob = DSMCSpheresProbability(p1, p2, maxprob, factor, rij);
+    return prob > uniform * maxprob;
+  }
+
+  double
+  DynNewtonian::DSMCSpheresProbability(Particle& p1, Particle& p2, double& maxprob, const double& factor, Vector rij) const
   {
     updateParticlePair(Sim->particles[p1.getID()], Sim->particles[p2.getID()]);
 
@@ -333,15 +362,14 @@ namespace dynamo {
     double rvdot = (rij | vij);
   
     if (rvdot > 0)
-      return false; //Positive rvdot
+      return -1; //Positive rvdot
 
     double prob = factor * (-rvdot);
 
     if (prob > maxprob)
       maxprob = prob;
 
-    std::uniform_real_distribution<> uniform_dist;
-    return prob > uniform_dist(Sim->ranGenerator) * maxprob;
+    return prob;
   }
 
   PairEventData
@@ -49,6 +49,7 @@ namespace dynamo {
     virtual double getPBCSentinelTime(const Particle&, const double&) const;
     virtual PairEventData SmoothSpheresColl(Event&, const double&, const double&, const EEventType& eType) const;
     virtual bool DSMCSpheresTest(Particle&, Particle&, double&, const double&, Vector) const;
+    virtual bool DSMCSpheresTest(Particle&, Particle&, double&, const double&, Vector, double) const;
     virtual PairEventData DSMCSpheresRun(Particle&, Particle&, const double&, Vector) const;
     virtual PairEventData SphereWellEvent(Event&, const double&, const double&, size_t) const;
     virtual double getPlaneEvent(const Particle&, const Vector &, const Vector &, double) const;
@@ -58,6 +59,7 @@ namespace dynamo {
     virtual ParticleEventData runPlaneEvent(Particle&, const Vector &, const double, const double) const;
     virtual ParticleEventData runAndersenWallCollision(Particle&, const Vector &, const double& T, const double d) const;
     virtual ParticleEventData randomGaussianEvent(Particle&, const double&, const size_t) const;
+    virtual ParticleEventData randomGaussianEvent(Particle&, const double&, const Vector&, const size_t) const;
     virtual NEventData multibdyCollision(const IDRange&, const IDRange&, const double&, const EEventType&) const;
     virtual NEventData multibdyWellEvent(const IDRange&, const IDRange&, const double&, const double&, EEventType&) const;
     virtual PairEventData parallelCubeColl(Event& event, const double& e, const double& d, const EEventType& eType = CORE) const;
@@ -69,6 +71,12 @@ namespace dynamo {
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const;
 
+    /*! \brief The ESMC collision probability of a pair, which also
+        raises maxprob if it is exceeded. Returns a negative value if
+        the pair is receding.
+     */
+    double DSMCSpheresProbability(Particle&, Particle&, double& maxprob, const double& factor, Vector rij) const;
+
     mutable long double lastAbsoluteClock;
     mutable unsigned int lastCollParticle1;
     mutable unsigned int lastCollParticle2;
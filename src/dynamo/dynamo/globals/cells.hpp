@@ -136,6 +136,11 @@ namespace dynamo {
 
     void setConfigOutput(bool val) { _inConfig = val; }
 
+    /*! \brief Set how many cells a neighbourhood extends in each
+        direction (the cells are shrunk to match).
+     */
+    void setOverlink(size_t val) { overlink = val; }
+
   protected:
     virtual void getParticleNeighbours(const std::array<size_t, 3>&, std::vector<size_t>&) const;
 
@@ -22,6 +22,7 @@
 #include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/BC/LEBC.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <algorithm>
 
 namespace dynamo {
   GCellsShearing::GCellsShearing(dynamo::Simulation* nSim, 
@@ -49,8 +50,6 @@ namespace dynamo {
       derr << "You should not use the shearing neighbour list"
 	   << " in a system without Lees Edwards BC's" << std::endl;
 
-    if (overlink != 1) M_throw() << "Cannot shear with overlinking yet";
-
     reinitialise();
   }
 
@@ -86,7 +85,12 @@ namespace dynamo {
     newCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? 1 : -1);
     newCellCoord[cellDirection] %= _ordering.getDimensions()[cellDirection];
 
-    if ((cellDirection == 1) && (oldCellCoord[1] == ((cellDirectionInt < 0) ? 0 : (_ordering.getDimensions()[1] - 1))))
+    const long ol = overlink;
+    const long dir = (cellDirectionInt > 0) ? 1 : -1;
+    const size_t width = 2 * overlink + 1;
+    const auto& dims = _ordering.getDimensions();
+
+    if ((cellDirection == 1) && (oldCellCoord[1] == ((cellDirectionInt < 0) ? 0 : (dims[1] - 1))))
       {
 	//Remove the old x contribution
 	//Calculate the final x value
@@ -110,59 +114,53 @@ namespace dynamo {
 	newCellCoord[0] = getCellCoords(tmpPos)[0];
 
 	_cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
-      
-	//Check the entire neighbourhood, could check just the new
-	//neighbours and the extra LE neighbourhood strip but its a lot
-	//of code
-	std::vector<size_t> neighbours;
-	GCells::getParticleNeighbours(part, neighbours);
-	for (const size_t& id2 : neighbours)
-	  _sigNewNeighbour(part, id2);
+
+	//The particle has passed into the next Lees-Edwards image. The
+	//strips it could see across the boundary are now in its own
+	//image, and cover all of its new neighbourhood apart from the
+	//leading layer of cells.
+	signalNewNeighbours(part, {{long(newCellCoord[0]) - ol, long(newCellCoord[1]) + dir * ol, long(newCellCoord[2]) - ol}}, {{width, 1, width}});
+
+	//Its old image is now across the boundary, and only the part
+	//of the new strips outside of its old neighbourhood is new.
+	size_t stripStart, stripCount;
+	if (getLEStripLayers(newCellCoord[1], stripStart, stripCount))
+	  signalNewNeighbours(part, {{long(oldCellCoord[0]) + ol + 1, long(stripStart), long(newCellCoord[2]) - ol}}, {{dims[0] - width, stripCount, width}});
       }
-    else if ((cellDirection == 1) && (oldCellCoord[1] == ((cellDirectionInt < 0) ? 1 : (_ordering.getDimensions()[1] - 2))))
+    else if (cellDirection == 1)
       {
-	//We're entering the boundary of the y direction
 	//Calculate the end cell, no boundary wrap check required
 	_cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
-            
-	//Check the extra LE neighbourhood strip
-	std::vector<size_t> nbs;
-	getAdditionalLEParticleNeighbourhood(part, nbs);
-	for (const size_t& id2 : nbs)
-	  {
-	    Sim->ptrScheduler->addInteractionEvent(part, id2);
-	    _sigNewNeighbour(part, id2);
-	  }
+
+	const long leading = long(newCellCoord[1]) + dir * ol;
+	if ((leading >= 0) && (leading < long(dims[1])))
+	  signalNewNeighbours(part, {{long(newCellCoord[0]) - ol, leading, long(newCellCoord[2]) - ol}}, {{width, 1, width}});
+	else
+	  //The leading layer is across the y boundary, so its entire
+	  //x strip is new
+	  signalNewNeighbours(part, {{0, leading, long(newCellCoord[2]) - ol}}, {{dims[0], 1, width}});
       }
     else
       {
 	_cellData.moveTo(oldCellIndex, _ordering.toIndex(newCellCoord), part.getID());
 
-	auto newNBCellCoord = newCellCoord;
-	newNBCellCoord[cellDirection] += _ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? 1 : -1);
-	newNBCellCoord[cellDirection] %= _ordering.getDimensions()[cellDirection];
-
-	if ((cellDirection == 2) && ((oldCellCoord[1] == 0) || (oldCellCoord[1] == _ordering.getDimensions()[1] - 1)))
-	  {
-	    //We're at the boundary moving in the z direction, we must
-	    //add the new LE strips as neighbours	
-	    //We just check the entire Extra LE neighbourhood
-	    std::vector<size_t> nbs;
-	    getAdditionalLEParticleNeighbourhood(part, nbs);
-	    for (const size_t& id2 : nbs) _sigNewNeighbour(part, id2);
-	  }
-
-	//Particle has just arrived into a new cell warn the scheduler about
-	//its new neighbours so it can add them to the heap
-	//Holds the displacement in each dimension, the unit is cells!
-
-	//These are the two dimensions to walk in
-	std::array<size_t, 3> steps = {{overlink, overlink, overlink}};
-	steps[cellDirection] = 0;
-	
-	for (auto cellIndex : _ordering.getSurroundingIndices(newNBCellCoord, steps))
-	  for (const size_t& next : _cellData.getCellContents(cellIndex))
-	    _sigNewNeighbour(part, next);
+	//Particle has just arrived into a new cell warn the scheduler
+	//about its new neighbours so it can add them to the heap. Only
+	//the leading face of the layers in this image is new, the
+	//layers across the y boundary are covered by the x strips.
+	const long ylow = std::max(long(newCellCoord[1]) - ol, 0l);
+	const long yhigh = std::min(long(newCellCoord[1]) + ol, long(dims[1]) - 1);
+	std::array<long, 3> start{{long(newCellCoord[0]) - ol, ylow, long(newCellCoord[2]) - ol}};
+	std::array<size_t, 3> extent{{width, size_t(yhigh - ylow + 1), width}};
+	const long face = long(newCellCoord[cellDirection]) + dir * ol;
+	start[cellDirection] = face;
+	extent[cellDirection] = 1;
+	signalNewNeighbours(part, start, extent);
+
+	//Moving in z, the x strips gain a new layer too
+	size_t stripStart, stripCount;
+	if ((cellDirection == 2) && getLEStripLayers(newCellCoord[1], stripStart, stripCount))
+	  signalNewNeighbours(part, {{0, long(stripStart), face}}, {{dims[0], stripCount, 1}});
       }
     
     //Push the next virtual event, this is the reason the scheduler
@@ -174,30 +172,71 @@ namespace dynamo {
   void
   GCellsShearing::getParticleNeighbours(const std::array<size_t, 3>& cellCoords, std::vector<size_t>& retlist) const
   {
-    GCells::getParticleNeighbours(cellCoords, retlist);
-    if ((cellCoords[1] == 0) || (cellCoords[1] == (_ordering.getDimensions()[1] - 1)))
-      getAdditionalLEParticleNeighbourhood(cellCoords, retlist);
+    const long ol = overlink;
+    const size_t width = 2 * overlink + 1;
+    const auto& dims = _ordering.getDimensions();
+
+    //The cells in this image
+    const long ylow = std::max(long(cellCoords[1]) - ol, 0l);
+    const long yhigh = std::min(long(cellCoords[1]) + ol, long(dims[1]) - 1);
+    for (auto cellIndex : getCellBlock({{long(cellCoords[0]) - ol, ylow, long(cellCoords[2]) - ol}}, {{width, size_t(yhigh - ylow + 1), width}}))
+      {
+	const auto& neighbours = _cellData.getCellContents(cellIndex);
+	retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+      }
+
+    //The strips across the y boundary
+    size_t stripStart, stripCount;
+    if (getLEStripLayers(cellCoords[1], stripStart, stripCount))
+      for (auto cellIndex : getCellBlock({{0, long(stripStart), long(cellCoords[2]) - ol}}, {{dims[0], stripCount, width}}))
+	{
+	  const auto& neighbours = _cellData.getCellContents(cellIndex);
+	  retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+	}
   }
-  
-  void
-  GCellsShearing::getAdditionalLEParticleNeighbourhood(const Particle& part, std::vector<size_t>& retlist) const {
-    return getAdditionalLEParticleNeighbourhood(_ordering.toCoord(_cellData.getCellID(part.getID())), retlist);
+
+  bool
+  GCellsShearing::getLEStripLayers(const size_t y, size_t& start, size_t& count) const
+  {
+    const size_t Ny = _ordering.getDimensions()[1];
+    if (y < overlink)
+      {
+	count = overlink - y;
+	start = Ny - count;
+	return true;
+      }
+
+    if (y + overlink > Ny - 1)
+      {
+	count = y + overlink - (Ny - 1);
+	start = 0;
+	return true;
+      }
+
+    return false;
   }
 
-  void
-  GCellsShearing::getAdditionalLEParticleNeighbourhood(std::array<size_t, 3> cellCoords, std::vector<size_t>& retlist) const
-  {  
-#ifdef DYNAMO_DEBUG
-    if ((cellCoords[1] != 0) && (cellCoords[1] != (_ordering.getDimensions()[1] - 1)))
-      M_throw() << "Shouldn't call this function unless the particle is at a border in the y dimension";
-#endif
-    std::array<size_t, 3> start = {{0, (cellCoords[1] > 0) ? 0 : _ordering.getDimensions()[1] - 1, cellCoords[2]}};
-    std::array<size_t, 3> steps = {{_ordering.getDimensions()[0], 0, overlink}};
-    //These are the two dimensions to walk in
-    for (auto cellIndex : _ordering.getSurroundingIndices(start, steps))
+  GCells::Ordering::IndexRange
+  GCellsShearing::getCellBlock(std::array<long, 3> start, std::array<size_t, 3> extent) const
+  {
+    const auto& dims = _ordering.getDimensions();
+    std::array<size_t, 3> corner;
+    for (size_t i(0); i < 3; ++i)
       {
-	const auto neighbours = _cellData.getCellContents(cellIndex);
-	retlist.insert(retlist.end(), neighbours.begin(), neighbours.end());
+	const long dim = dims[i];
+	corner[i] = ((start[i] % dim) + dim) % dim;
+	//An empty block must have no extent in any dimension, or the
+	//iterators never reach the end
+	if (!extent[i]) extent = std::array<size_t, 3>{{0, 0, 0}};
       }
+    return _ordering.getIndices(corner, extent);
+  }
+
+  void
+  GCellsShearing::signalNewNeighbours(const Particle& part, const std::array<long, 3>& start, const std::array<size_t, 3>& extent) const
+  {
+    for (auto cellIndex : getCellBlock(start, extent))
+      for (const size_t& next : _cellData.getCellContents(cellIndex))
+	_sigNewNeighbour(part, next);
   }
 }
@@ -37,7 +37,31 @@ namespace dynamo {
 
   protected:
     void getParticleNeighbours(const std::array<size_t, 3>&, std::vector<size_t>&) const;
-    void getAdditionalLEParticleNeighbourhood(const Particle&, std::vector<size_t>&) const;
-    void getAdditionalLEParticleNeighbourhood(std::array<size_t, 3>, std::vector<size_t>&) const;
+
+    /*! \brief Find the layers of cells across the y boundary which
+        are in the neighbourhood of a cell.
+
+	Cells within overlink cells of the y boundary see across it
+	into the next Lees-Edwards image, which is shifted in x by an
+	arbitrary amount. The entire x strip of these layers must
+	therefore be included in the neighbourhood.
+
+	\param y The y coordinate of the cell.
+	\param start Set to the first y layer across the boundary.
+	\param count Set to the number of y layers across the boundary.
+	\return False if the cell does not see across the boundary.
+     */
+    bool getLEStripLayers(const size_t y, size_t& start, size_t& count) const;
+
+    /*! \brief The indices of a (periodic) block of cells.
+
+	\param start The (possibly negative) cell coordinates of the
+	corner of the block.
+	\param extent The number of cells of the block in each dimension.
+     */
+    Ordering::IndexRange getCellBlock(std::array<long, 3> start, std::array<size_t, 3> extent) const;
+
+    //! \brief Signal all particles in a block of cells as new neighbours.
+    void signalNewNeighbours(const Particle&, const std::array<long, 3>& start, const std::array<size_t, 3>& extent) const;
   };
 }
@@ -53,6 +53,8 @@ namespace dynamo {
 	else
 	  return shared_ptr<Global>(new GCells(XML, Sim));
       }
+    else if (!XML.getAttribute("Type").getValue().compare("MultiCells"))
+      return shared_ptr<Global>(new GMultiCells(XML, Sim));
     else if (!XML.getAttribute("Type").getValue().compare("SOCells"))
       return shared_ptr<Global>(new GSOCells(XML, Sim));
     else if (!XML.getAttribute("Type").getValue().compare("Francesco"))
@@ -17,6 +17,7 @@
 
 #include <dynamo/globals/cells.hpp>
 #include <dynamo/globals/cellsShearing.hpp>
+#include <dynamo/globals/multicells.hpp>
 #include <dynamo/globals/PBCSentinel.hpp>
 #include <dynamo/globals/ParabolaSentinel.hpp>
 #include <dynamo/globals/socells.hpp>
@@ -0,0 +1,413 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/globals/multicells.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/dynamics/compression.hpp>
+#include <dynamo/interactions/interaction.hpp>
+#include <dynamo/units/units.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/BC/LEBC.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace dynamo {
+  GMultiCells::GMultiCells(dynamo::Simulation* nSim, const std::string& name, double lambda, double levelRatio):
+    GNeighbourList(nSim, "MultiCellNeighbourList"),
+    _lambda(lambda),
+    _levelRatio(levelRatio),
+    _maxLevels(8)
+  {
+    globName = name;
+    dout << "Multi-level cells Loaded" << std::endl;
+  }
+
+  GMultiCells::GMultiCells(const magnet::xml::Node& XML, dynamo::Simulation* ptrSim):
+    GNeighbourList(ptrSim, "MultiCellNeighbourList"),
+    _lambda(1),
+    _levelRatio(2),
+    _maxLevels(8)
+  {
+    operator<<(XML);
+
+    dout << "Multi-level cells Loaded" << std::endl;
+  }
+
+  void
+  GMultiCells::operator<<(const magnet::xml::Node& XML)
+  {
+    globName = XML.getAttribute("Name");
+
+    if (XML.hasAttribute("Diameter"))
+      _diameter = Sim->_properties.getProperty(XML.getAttribute("Diameter"), Property::Units::Length());
+
+    if (XML.hasAttribute("Lambda"))
+      _lambda = XML.getAttribute("Lambda").as<double>();
+
+    if (XML.hasAttribute("LevelRatio"))
+      _levelRatio = XML.getAttribute("LevelRatio").as<double>();
+
+    if (XML.hasAttribute("MaxLevels"))
+      _maxLevels = XML.getAttribute("MaxLevels").as<size_t>();
+
+    if (_lambda < 1.0)
+      M_throw() << "The Lambda of the MultiCells neighbour list must be at least 1.0";
+
+    if (_levelRatio <= 1.0)
+      M_throw() << "The LevelRatio of the MultiCells neighbour list must be greater than 1.0";
+
+    if (!_maxLevels)
+      M_throw() << "The MultiCells neighbour list needs at least one level";
+
+    range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
+  }
+
+  void
+  GMultiCells::outputXML(magnet::xml::XmlStream& XML) const
+  {
+    XML << magnet::xml::tag("Global")
+	<< magnet::xml::attr("Type") << "MultiCells"
+	<< magnet::xml::attr("Name") << globName;
+
+    if (_diameter)
+      XML << magnet::xml::attr("Diameter") << _diameter->getName();
+
+    XML << magnet::xml::attr("Lambda") << _lambda
+	<< magnet::xml::attr("LevelRatio") << _levelRatio
+	<< magnet::xml::attr("MaxLevels") << _maxLevels
+	<< range
+	<< magnet::xml::endtag("Global");
+  }
+
+  void
+  GMultiCells::initialise(size_t nID)
+  {
+    Global::initialise(nID);
+
+    if (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics))
+      M_throw() << "The MultiCells neighbour list does not support compression dynamics";
+
+    if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      M_throw() << "The MultiCells neighbour list does not support Lees-Edwards boundary conditions";
+
+    reinitialise();
+  }
+
+  void
+  GMultiCells::reinitialise()
+  {
+    GNeighbourList::reinitialise();
+
+    dout << "Reinitialising on collision " << Sim->eventCount << std::endl;
+
+    buildLevels();
+    buildLinks();
+
+    _sigReInitialise();
+  }
+
+  double
+  GMultiCells::getDiameter(const size_t pid) const
+  {
+    if (_diameter)
+      return _diameter->getProperty(pid);
+
+    const Particle& part = Sim->particles[pid];
+    return Sim->getInteraction(part, part)->getGlyphSize(pid)[0];
+  }
+
+  void
+  GMultiCells::buildLevels()
+  {
+    double maxDiameter = 0;
+    for (const size_t& pid : *range)
+      maxDiameter = std::max(maxDiameter, getDiameter(pid));
+
+    if (maxDiameter <= 0)
+      M_throw() << "The particles of the MultiCells neighbour list have no size";
+
+    if (_lambda * maxDiameter < _maxInteractionRange * (1.0 - 10 * std::numeric_limits<double>::epsilon()))
+      M_throw() << "The MultiCells neighbour list supports interactions up to " << _lambda * maxDiameter / Sim->units.unitLength()
+		<< " but the longest interaction is " << _maxInteractionRange / Sim->units.unitLength()
+		<< ", increase its Lambda";
+
+    //Sort the particles into the size classes
+    const size_t npos = std::numeric_limits<size_t>::max();
+    _particleLevel.assign(Sim->N(), npos);
+    std::vector<size_t> classCount(_maxLevels, 0);
+    std::vector<double> classDiameter(_maxLevels, 0);
+    for (const size_t& pid : *range)
+      {
+	const double d = getDiameter(pid);
+	size_t sizeClass = _maxLevels - 1;
+	if (d > 0)
+	  sizeClass = std::min(sizeClass, size_t(std::max(0.0, std::floor(std::log(maxDiameter / d) / std::log(_levelRatio)))));
+	_particleLevel[pid] = sizeClass;
+	++classCount[sizeClass];
+	classDiameter[sizeClass] = std::max(classDiameter[sizeClass], d);
+      }
+
+    //Only the occupied size classes get a level
+    std::vector<size_t> classLevel(_maxLevels, npos);
+    _levels.clear();
+    size_t indexOffset = 0;
+    for (size_t sizeClass(0); sizeClass < _maxLevels; ++sizeClass)
+      {
+	if (!classCount[sizeClass]) continue;
+	classLevel[sizeClass] = _levels.size();
+	_levels.push_back(Level());
+	Level& level = _levels.back();
+
+	//A class of point particles still needs cells of a finite size
+	double diameter = classDiameter[sizeClass];
+	if (diameter <= 0)
+	  diameter = maxDiameter / std::pow(_levelRatio, sizeClass + 1);
+	level.range = _lambda * diameter * (1.0 + 10 * std::numeric_limits<double>::epsilon());
+
+	//The cells are built as in GCells::addCells
+	const double overlap = 0.9;
+	std::array<size_t, 3> cellCount;
+	for (size_t iDim = 0; iDim < NDIM; iDim++)
+	  {
+	    cellCount[iDim] = std::max(size_t(Sim->primaryCellSize[iDim] / (level.range * (1.0 + 10 * std::numeric_limits<double>::epsilon()))), size_t(3));
+	    level.cellLatticeWidth[iDim] = Sim->primaryCellSize[iDim] / cellCount[iDim];
+	    level.cellDimension[iDim] = level.cellLatticeWidth[iDim] + (level.cellLatticeWidth[iDim] - level.range) * overlap;
+	    level.cellOffset[iDim] = -(level.cellLatticeWidth[iDim] - level.range) * overlap * 0.5;
+	  }
+	level.ordering = Ordering(cellCount);
+	level.indexOffset = indexOffset;
+	indexOffset += level.ordering.size();
+	level.cellData.resize(level.ordering.size(), Sim->N());
+
+	dout << "Level " << _levels.size() - 1
+	     << "\nParticles " << classCount[sizeClass]
+	     << "\nCells " << cellCount[0] << "," << cellCount[1] << "," << cellCount[2]
+	     << "\nSupported Interaction range " << level.range / Sim->units.unitLength()
+	     << std::endl;
+      }
+
+    //Required so particles find the right owning cell
+    Sim->dynamics->updateAllParticles();
+    for (const size_t& pid : *range)
+      {
+	_particleLevel[pid] = classLevel[_particleLevel[pid]];
+	Level& level = _levels[_particleLevel[pid]];
+	level.cellData.add(level.ordering.toIndex(getCellCoords(level, Sim->particles[pid].getPosition())), pid);
+      }
+  }
+
+  void
+  GMultiCells::buildLinks()
+  {
+    const size_t levels = _levels.size();
+    _links.assign(levels, std::vector<std::array<LinkTable, 3> >(levels));
+
+    //The tables of smaller particles around larger particles are
+    //built first, the remainder are their transpose.
+    for (size_t a(0); a < levels; ++a)
+      for (size_t b(a); b < levels; ++b)
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  {
+	    const Level& la = _levels[a];
+	    const Level& lb = _levels[b];
+	    const long na = la.ordering.getDimensions()[iDim];
+	    const long nb = lb.ordering.getDimensions()[iDim];
+	    LinkTable& table = _links[a][b][iDim];
+	    table.resize(na);
+
+	    for (long c(0); c < na; ++c)
+	      {
+		std::vector<size_t>& linked = table[c];
+		long first = c - 1, last = c + 1;
+		if (a != b)
+		  {
+		    //The cells of level b which come within the
+		    //interaction range of the cell of level a
+		    const double interactionRange = 0.5 * (la.range + lb.range);
+		    const double cellStart = c * la.cellLatticeWidth[iDim] + la.cellOffset[iDim] - lb.cellOffset[iDim];
+		    first = std::floor((cellStart - interactionRange - lb.cellDimension[iDim]) / lb.cellLatticeWidth[iDim]);
+		    last = std::floor((cellStart + la.cellDimension[iDim] + interactionRange) / lb.cellLatticeWidth[iDim]);
+		  }
+
+		if (last - first + 1 >= nb)
+		  { first = 0; last = nb - 1; }
+
+		for (long coord(first); coord <= last; ++coord)
+		  linked.push_back(((coord % nb) + nb) % nb);
+		std::sort(linked.begin(), linked.end());
+		linked.erase(std::unique(linked.begin(), linked.end()), linked.end());
+	      }
+
+	    if (a == b) continue;
+
+	    LinkTable& transpose = _links[b][a][iDim];
+	    transpose.resize(nb);
+	    for (long c(0); c < na; ++c)
+	      for (const size_t& coord : table[c])
+		transpose[coord].push_back(c);
+	  }
+  }
+
+  GMultiCells::Coords
+  GMultiCells::getCellCoords(const Level& level, Vector pos) const
+  {
+    Sim->BCs->applyBC(pos);
+
+    Coords retval;
+    for (size_t iDim = 0; iDim < NDIM; iDim++)
+      {
+	long coord = std::floor((pos[iDim] - level.cellOffset[iDim]) / level.cellLatticeWidth[iDim] + 0.5 * level.ordering.getDimensions()[iDim]);
+	coord %= long(level.ordering.getDimensions()[iDim]);
+	if (coord < 0) coord += level.ordering.getDimensions()[iDim];
+	retval[iDim] = coord;
+      }
+
+    return retval;
+  }
+
+  Vector
+  GMultiCells::calcPosition(const Level& level, const Coords& coords, const Particle& part) const
+  {
+    //We always return the cell that is periodically nearest to the particle
+    Vector imageCell;
+    for (size_t i = 0; i < NDIM; ++i)
+      {
+	const double primaryCell = coords[i] * level.cellLatticeWidth[i] - 0.5 * Sim->primaryCellSize[i] + level.cellOffset[i];
+	imageCell[i] = primaryCell - Sim->primaryCellSize[i] * lrint((primaryCell - part.getPosition()[i]) / Sim->primaryCellSize[i]);
+      }
+    return imageCell;
+  }
+
+  Event
+  GMultiCells::getEvent(const Particle& part) const
+  {
+#ifdef ISSS_DEBUG
+    if (!Sim->dynamics->isUpToDate(part))
+      M_throw() << "Particle is not up to date";
+#endif
+
+    const Level& level = _levels[_particleLevel[part.getID()]];
+    const Coords coords = level.ordering.toCoord(level.cellData.getCellID(part.getID()));
+    return Event(part, Sim->dynamics->getSquareCellCollision2(part, calcPosition(level, coords, part), level.cellDimension) - Sim->dynamics->getParticleDelay(part), GLOBAL, CELL, ID);
+  }
+
+  void
+  GMultiCells::runEvent(Particle& part, const double)
+  {
+    //See GCells::runEvent
+    Sim->dynamics->updateParticle(part);
+    Sim->ptrScheduler->popNextEvent();
+
+    const size_t levelID = _particleLevel[part.getID()];
+    Level& level = _levels[levelID];
+    const size_t oldCellIndex = level.cellData.getCellID(part.getID());
+    const Coords oldCellCoord = level.ordering.toCoord(oldCellIndex);
+
+    //Determine the cell transition direction
+    const int cellDirectionInt(Sim->dynamics->getSquareCellCollision3(part, calcPosition(level, oldCellCoord, part), level.cellDimension));
+    const size_t cellDirection = abs(cellDirectionInt) - 1;
+
+    //Calculate which cell the particle ends up in
+    Coords newCellCoord = oldCellCoord;
+    newCellCoord[cellDirection] += level.ordering.getDimensions()[cellDirection] + ((cellDirectionInt > 0) ? 1 : -1);
+    newCellCoord[cellDirection] %= level.ordering.getDimensions()[cellDirection];
+
+    level.cellData.moveTo(oldCellIndex, level.ordering.toIndex(newCellCoord), part.getID());
+
+    //Signal the particles of the cells of each level which have just
+    //entered the neighbourhood
+    for (size_t otherID(0); otherID < _levels.size(); ++otherID)
+      {
+	const std::array<LinkTable, 3>& links = _links[levelID][otherID];
+	const std::vector<size_t>& newLinks = links[cellDirection][newCellCoord[cellDirection]];
+	const std::vector<size_t>& oldLinks = links[cellDirection][oldCellCoord[cellDirection]];
+	_enteredCoords.clear();
+	std::set_difference(newLinks.begin(), newLinks.end(), oldLinks.begin(), oldLinks.end(), std::back_inserter(_enteredCoords));
+	if (_enteredCoords.empty()) continue;
+
+	std::array<const std::vector<size_t>*, 3> cells;
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  cells[iDim] = &links[iDim][newCellCoord[iDim]];
+	cells[cellDirection] = &_enteredCoords;
+
+	_newNeighbours.clear();
+	addCellContents(_levels[otherID], cells, _newNeighbours);
+	for (const size_t& next : _newNeighbours)
+	  _sigNewNeighbour(part, next);
+      }
+
+    //Push the next virtual event
+    Sim->ptrScheduler->pushEvent(getEvent(part));
+    _sigCellChange(part, level.indexOffset + oldCellIndex);
+  }
+
+  void
+  GMultiCells::addCellContents(const Level& level, const std::array<const std::vector<size_t>*, 3>& cells, std::vector<size_t>& retlist) const
+  {
+    for (const size_t& z : *cells[2])
+      for (const size_t& y : *cells[1])
+	for (const size_t& x : *cells[0])
+	  {
+	    const auto& contents = level.cellData.getCellContents(level.ordering.toIndex(Coords{{x, y, z}}));
+	    retlist.insert(retlist.end(), contents.begin(), contents.end());
+	  }
+  }
+
+  void
+  GMultiCells::getParticleNeighbours(size_t levelID, const Coords& coords, std::vector<size_t>& retlist) const
+  {
+    for (size_t otherID(0); otherID < _levels.size(); ++otherID)
+      {
+	const std::array<LinkTable, 3>& links = _links[levelID][otherID];
+	addCellContents(_levels[otherID], {{&links[0][coords[0]], &links[1][coords[1]], &links[2][coords[2]]}}, retlist);
+      }
+  }
+
+  void
+  GMultiCells::getParticleNeighbours(const Particle& part, std::vector<size_t>& retlist) const
+  {
+    const size_t levelID = _particleLevel[part.getID()];
+    const Level& level = _levels[levelID];
+    getParticleNeighbours(levelID, level.ordering.toCoord(level.cellData.getCellID(part.getID())), retlist);
+  }
+
+  void
+  GMultiCells::getParticleNeighbours(const Vector& vec, std::vector<size_t>& retlist) const
+  {
+    getParticleNeighbours(0, getCellCoords(_levels[0], vec), retlist);
+  }
+
+  double
+  GMultiCells::getMaxSupportedInteractionLength() const
+  {
+    if (_levels.empty()) return 0;
+
+    //As GCells::getMaxSupportedInteractionLength for the first level
+    const Level& level = _levels[0];
+    double retval(std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i < NDIM; ++i)
+      {
+	double supported_length = 2 * level.cellLatticeWidth[i] - level.cellDimension[i];
+	if (level.ordering.getDimensions()[i] == 3)
+	  supported_length = Sim->primaryCellSize[i];
+	retval = std::min(retval, supported_length);
+      }
+    return retval;
+  }
+}
@@ -0,0 +1,165 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/globals/cells.hpp>
+#include <dynamo/property.hpp>
+#include <array>
+#include <vector>
+
+namespace dynamo {
+  /*! \brief A hierarchical cell neighbour list for polydisperse
+      systems.
+
+    GCells sizes its cells by the longest interaction in the system,
+    so in a mixture of a few large particles with many small
+    particles, the cells contain many small particles which are
+    tested against each other at every event. This neighbour list
+    instead sorts the particles into size classes (levels), and each
+    level has its own grid of cells sized for the largest particle
+    of that level. The cells of each level overlap their neighbours
+    as in GCells.
+
+    The size of each particle is taken from a Property (usually the
+    diameter of its Interaction), or if no Diameter is given, from the
+    glyph size of the Interaction of the particle with itself. The
+    interaction range of two
+    particles is assumed to be at most Lambda times their mean
+    diameter (e.g., Lambda is the well width of square well
+    interactions). Level k holds the particles with a diameter in
+    the range \f$(d_{max}/r^{k+1},d_{max}/r^k]\f$, where \f$r\f$ is
+    the LevelRatio and \f$d_{max}\f$ is the largest diameter.
+
+    The neighbourhood of a particle is found by scanning the cells of
+    every level which lie within the cross-level interaction range
+    of its own cell. These cells are tabulated, one dimension at a
+    time, when the levels are built. The table of level b around the
+    cells of level a is the transpose of the table of level a around
+    the cells of level b, so that two particles always agree if they
+    are neighbours. This is needed as a particle only reports the
+    particles in the cells which have entered its neighbourhood when
+    it changes cell.
+
+    \code
+    <Global Type="MultiCells" Name="SchedulerNBList" Diameter="D" Lambda="1.0" LevelRatio="2">
+      <IDRange Type="All"/>
+    </Global>
+    \endcode
+   */
+  class GMultiCells: public GNeighbourList
+  {
+  public:
+    GMultiCells(const magnet::xml::Node&, dynamo::Simulation*);
+    GMultiCells(dynamo::Simulation*, const std::string& name, double lambda = 1, double levelRatio = 2);
+
+    virtual ~GMultiCells() {}
+
+    virtual Event getEvent(const Particle &) const;
+
+    virtual void runEvent(Particle&, const double);
+
+    virtual void initialise(size_t);
+
+    virtual void reinitialise();
+
+    void getParticleNeighbours(const Particle&, std::vector<size_t>&) const;
+
+    /*! \brief Returns the particles in the neighbourhood of a point,
+        as if it were a particle of the largest size class.
+     */
+    void getParticleNeighbours(const Vector&, std::vector<size_t>&) const;
+
+    virtual void operator<<(const magnet::xml::Node&);
+
+    /*! \brief The longest interaction supported between the particles
+        of the largest size class.
+
+      Smaller particles are only supported up to the range of their
+      own size class.
+     */
+    virtual double getMaxSupportedInteractionLength() const;
+
+    //! \brief The number of size classes currently in use.
+    size_t getLevelCount() const { return _levels.size(); }
+
+  protected:
+    typedef magnet::containers::RowMajorOrdering<3> Ordering;
+    typedef std::array<size_t, 3> Coords;
+
+    //! \brief The cells of a single size class.
+    struct Level
+    {
+      Ordering ordering;
+      Vector cellDimension;
+      Vector cellLatticeWidth;
+      Vector cellOffset;
+      //! \brief The longest interaction of two particles of this level.
+      double range;
+      //! \brief Added to the cell indices of this level to make them unique.
+      size_t indexOffset;
+
+#ifdef DYNAMO_JUDY
+      detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			       magnet::containers::JudyMap<size_t, size_t>> cellData;
+#else
+      detail::CellParticleList<magnet::containers::Vector_Multimap<magnet::containers::VectorSet<size_t>>,
+			       std::unordered_map<size_t, size_t> > cellData;
+#endif
+    };
+
+    /*! \brief The table of neighbouring cell coordinates.
+
+      _links[a][b][dim][c] is the sorted list of the coordinates (in
+      dimension dim) of the cells of level b which neighbour the cells
+      of level a with the coordinate c.
+     */
+    typedef std::vector<std::vector<size_t> > LinkTable;
+    std::vector<std::vector<std::array<LinkTable, 3> > > _links;
+
+    std::vector<Level> _levels;
+    //! \brief The level of each particle (indexed by ID).
+    std::vector<size_t> _particleLevel;
+
+    shared_ptr<Property> _diameter;
+    double _lambda;
+    double _levelRatio;
+    size_t _maxLevels;
+
+    //! \brief Work space of runEvent, kept to avoid reallocations.
+    std::vector<size_t> _enteredCoords;
+    std::vector<size_t> _newNeighbours;
+
+    GMultiCells(const GMultiCells&);
+
+    virtual void outputXML(magnet::xml::XmlStream&) const;
+
+    //! \brief The diameter which decides the level of a particle.
+    double getDiameter(const size_t) const;
+
+    void buildLevels();
+    void buildLinks();
+
+    //! \brief Add the contents of the cells in the product of the coordinate lists.
+    void addCellContents(const Level&, const std::array<const std::vector<size_t>*, 3>&, std::vector<size_t>&) const;
+
+    void getParticleNeighbours(size_t level, const Coords&, std::vector<size_t>&) const;
+
+    Coords getCellCoords(const Level&, Vector) const;
+
+    Vector calcPosition(const Level&, const Coords&, const Particle&) const;
+  };
+}
@@ -33,7 +33,12 @@ namespace dynamo {
     virtual std::vector<Vector> placeObjects(const Vector & centre)
     {
       std::vector<Vector> retval;
+      appendObjects(centre, retval);
+      return retval;
+    }
 
+    virtual void appendObjects(const Vector& centre, std::vector<Vector>& sites)
+    {
       Vector  cellWidth;
       for (size_t iDim = 0; iDim < NDIM; ++iDim)
 	cellWidth[iDim] = dimensions[iDim] / cells[iDim];
@@ -47,14 +52,12 @@ namespace dynamo {
 	    position[iDim] = cellWidth[iDim] * (static_cast<double>(iterVec[iDim]) + 0.25) - 0.5 * dimensions[iDim] 
 	      + centre[iDim];
 	
-	  for (const Vector & vec : uc->placeObjects(position))
-	    retval.push_back(vec);
+	  uc->appendObjects(position, sites);
 	
 	  for (size_t iDim = 0; iDim < NDIM; iDim++)
 	    position[iDim] += cellWidth[iDim]/2.0;
 	
-	  const std::vector<Vector>& newsites = uc->placeObjects(position);
-	  retval.insert(retval.end(), newsites.begin(), newsites.end());
+	  uc->appendObjects(position, sites);
 	
 	  //Now update the displacement vector
 	  iterVec[0]++;
@@ -69,8 +72,6 @@ namespace dynamo {
 		}
 	    }
 	}
-    
-      return retval;
     }
   };
 }
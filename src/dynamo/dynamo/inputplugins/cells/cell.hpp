@@ -30,6 +30,20 @@ namespace dynamo {
     virtual void initialise() { uc->initialise(); }
 
     virtual std::vector<Vector> placeObjects(const Vector & ) = 0;  
+
+    /*! \brief Append the positions of the objects placed around a
+        point to a buffer.
+
+      Unit cells which generate large numbers of objects override
+      this, so that the positions are written straight into a single
+      (preallocated) buffer, rather than into a temporary vector at
+      every level of the chain of cells.
+     */
+    virtual void appendObjects(const Vector& centre, std::vector<Vector>& sites)
+    {
+      const std::vector<Vector> newsites = placeObjects(centre);
+      sites.insert(sites.end(), newsites.begin(), newsites.end());
+    }
   
     const std::unique_ptr<UCell> uc;
   };
@@ -50,6 +64,9 @@ namespace dynamo {
       retval.push_back(center);
       return retval;
     }
+
+    virtual void appendObjects(const Vector& center, std::vector<Vector>& sites)
+    { sites.push_back(center); }
   };
 
   /*! \brief A simple terminator, used to place a particle at this
@@ -76,14 +93,14 @@ namespace dynamo {
     virtual std::vector<Vector  > placeObjects(const Vector & center)
     {
       std::vector<Vector> retval;
+      appendObjects(center, retval);
+      return retval;
+    }
 
+    virtual void appendObjects(const Vector& center, std::vector<Vector>& sites)
+    {
       for (const Vector& vec : _list)
-	{
-	  const std::vector<Vector>& newsites = uc->placeObjects(vec + center);
-	  retval.insert(retval.end(), newsites.begin(), newsites.end());
-	}
-
-      return retval;
+	uc->appendObjects(vec + center, sites);
     }
 
     std::vector<Vector> _list;
@@ -32,10 +32,15 @@ namespace dynamo {
     std::array<long, 3> cells;
     Vector  dimensions;
 
-    virtual std::vector<Vector  > placeObjects(const Vector & centre)
+    virtual std::vector<Vector> placeObjects(const Vector & centre)
     {
-      std::vector<Vector  > retval;
+      std::vector<Vector> retval;
+      appendObjects(centre, retval);
+      return retval;
+    }
 
+    virtual void appendObjects(const Vector& centre, std::vector<Vector>& sites)
+    {
       Vector  cellWidth;
     
       for (size_t iDim = 0; iDim < NDIM; ++iDim)
@@ -77,11 +82,8 @@ namespace dynamo {
 		    rcoord[iRef][iDim] + cellWidth[iDim] * iterVec[iDim] - 0.5 * dimensions[iDim] + centre[iDim];
 	      
 		//Get the next unit cells positions and push them to your list
-		const std::vector<Vector>& newsites = uc->placeObjects(position);
-		retval.insert(retval.end(), newsites.begin(), newsites.end());
+		uc->appendObjects(position, sites);
 	      }
-
-      return retval;    
     }
   };
 }
@@ -25,6 +25,7 @@
 #include <dynamo/inputplugins/cells/ringSnake.hpp>
 #include <dynamo/inputplugins/cells/randomise.hpp>
 #include <dynamo/inputplugins/cells/random.hpp>
+#include <dynamo/inputplugins/cells/rsa.hpp>
 #include <dynamo/inputplugins/cells/linearRod.hpp>
 #include <dynamo/inputplugins/cells/binary.hpp>
 #include <dynamo/inputplugins/cells/triangleIntersection.hpp>
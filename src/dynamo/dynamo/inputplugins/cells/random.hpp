@@ -37,7 +37,12 @@ namespace dynamo {
     virtual std::vector<Vector> placeObjects(const Vector & centre)
     {
       std::vector<Vector> retval;
-      
+      appendObjects(centre, retval);
+      return retval;
+    }
+
+    virtual void appendObjects(const Vector& centre, std::vector<Vector>& sites)
+    {
       std::uniform_real_distribution<> uniform_dist;
       for (size_t i(0); i < N; ++i)
 	{
@@ -46,11 +51,8 @@ namespace dynamo {
 	    position[iDim] = centre[iDim] - (uniform_dist(_rng) - 0.5) * dimensions[iDim];
 	
 	  //Get the next unit cells positions and push them to your list
-	  const std::vector<Vector>& newsites = uc->placeObjects(position);
-	  retval.insert(retval.end(), newsites.begin(), newsites.end());
+	  uc->appendObjects(position, sites);
 	}
-
-      return retval;    
     }
   };
 }
@@ -0,0 +1,208 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/inputplugins/cells/cell.hpp>
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace dynamo {
+  /*! \brief Places spheres at random, non-overlapping positions by
+      random sequential addition (RSA).
+
+    Each sphere is inserted in turn at uniformly random trial
+    positions in a periodic box of size dimensions, until a position
+    is found where it does not overlap any of the previously placed
+    spheres. The spheres may have different diameters. The overlap
+    test uses a grid of cells at least as wide as the largest
+    diameter, so each trial only checks the spheres in the 27
+    surrounding cells and the packing of N spheres is O(N).
+
+    RSA jams at a packing fraction of around 0.38 for monodisperse
+    spheres, and placing the largest spheres first helps polydisperse
+    packings approach this. Denser configurations need to be
+    compressed from the RSA configuration.
+   */
+  struct CURSA: public UCell
+  {
+    /*! \param diameters The diameter of each sphere to be placed (in
+        the same units as the dimensions).
+      \param ndimensions The size of the periodic box.
+      \param nextCell The unit cell placed at the centre of each sphere.
+      \param maxAttempts The maximum number of trial positions for
+      each sphere, before the packing is abandoned.
+     */
+    CURSA(const std::vector<double>& diameters, Vector ndimensions,
+	  UCell* nextCell, size_t maxAttempts = 1000000):
+      UCell(nextCell),
+      _diameters(diameters),
+      dimensions(ndimensions),
+      _maxAttempts(maxAttempts),
+      _rng(std::random_device()())
+    {}
+
+    std::vector<double> _diameters;
+    Vector dimensions;
+    size_t _maxAttempts;
+    std::mt19937 _rng;
+
+    virtual std::vector<Vector> placeObjects(const Vector & centre)
+    {
+      std::vector<Vector> retval;
+      appendObjects(centre, retval);
+      return retval;
+    }
+
+    virtual void appendObjects(const Vector& centre, std::vector<Vector>& sites)
+    {
+      const size_t N = _diameters.size();
+      if (!N) return;
+      sites.reserve(sites.size() + N);
+
+      const double maxDiameter = *std::max_element(_diameters.begin(), _diameters.end());
+
+      //Build a grid of cells at least maxDiameter wide. The number of
+      //cells is limited to around 2N, so low densities do not
+      //generate huge, empty grids.
+      const size_t maxCells = size_t(std::cbrt(2.0 * N)) + 1;
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	{
+	  _cellCount[iDim] = 1;
+	  if (maxDiameter > 0)
+	    _cellCount[iDim] = std::max(size_t(1), std::min(maxCells, size_t(dimensions[iDim] / maxDiameter)));
+	}
+
+      _cellHead.assign(_cellCount[0] * _cellCount[1] * _cellCount[2], std::numeric_limits<size_t>::max());
+      _spheres.resize(N);
+
+      std::uniform_real_distribution<> uniform_dist(-0.5, 0.5);
+      for (size_t i(0); i < N; ++i)
+	{
+	  Sphere& sphere = _spheres[i];
+	  sphere.radius = 0.5 * _diameters[i];
+
+	  size_t attempt(0);
+	  for (; attempt < _maxAttempts; ++attempt)
+	    {
+	      for (size_t iDim(0); iDim < NDIM; ++iDim)
+		sphere.position[iDim] = uniform_dist(_rng) * dimensions[iDim];
+
+	      if (!overlaps(sphere))
+		break;
+	    }
+
+	  if (attempt == _maxAttempts)
+	    M_throw() << "Random sequential addition could not place sphere " << i << " of " << N
+		      << " after " << _maxAttempts << " attempts. The requested density is probably above the RSA jamming limit.";
+
+	  const size_t cell = cellCoord(sphere.position, 0)
+	    + _cellCount[0] * (cellCoord(sphere.position, 1) + _cellCount[1] * cellCoord(sphere.position, 2));
+	  sphere.next = _cellHead[cell];
+	  _cellHead[cell] = i;
+
+	  uc->appendObjects(sphere.position + centre, sites);
+	}
+
+      //Release the grid
+      _cellHead = std::vector<size_t>();
+      _spheres = std::vector<Sphere>();
+    }
+
+  private:
+    static const size_t NONE = std::numeric_limits<size_t>::max();
+
+    //! \brief A placed sphere, stored together for locality.
+    struct Sphere
+    {
+      Vector position;
+      double radius;
+      //! \brief The next sphere in the same cell, or NONE.
+      size_t next;
+    };
+
+    std::array<size_t, 3> _cellCount;
+    //! \brief The first sphere of each cell, or NONE.
+    std::vector<size_t> _cellHead;
+    std::vector<Sphere> _spheres;
+
+    size_t cellCoord(const Vector& pos, size_t iDim) const
+    {
+      const size_t coord = size_t((pos[iDim] / dimensions[iDim] + 0.5) * _cellCount[iDim]);
+      return std::min(coord, _cellCount[iDim] - 1);
+    }
+
+    /*! \brief Test if a trial sphere overlaps any of the spheres
+        already placed.
+     */
+    bool overlaps(const Sphere& trial) const
+    {
+      //The cells to search in each dimension. If there are fewer
+      //than three cells in a dimension, all of them are searched
+      //(once). The strides of the cell index are folded in, so the
+      //cell IDs are just sums.
+      std::array<std::array<size_t, 3>, 3> cells;
+      std::array<size_t, 3> extent;
+      size_t stride(1);
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	{
+	  const size_t n = _cellCount[iDim];
+	  if (n < 3)
+	    {
+	      extent[iDim] = n;
+	      for (size_t j(0); j < n; ++j)
+		cells[iDim][j] = j * stride;
+	    }
+	  else
+	    {
+	      const size_t c = cellCoord(trial.position, iDim);
+	      extent[iDim] = 3;
+	      cells[iDim][0] = c * stride;
+	      cells[iDim][1] = ((c ? c : n) - 1) * stride;
+	      cells[iDim][2] = ((c + 1 == n) ? 0 : c + 1) * stride;
+	    }
+	  stride *= n;
+	}
+
+      for (size_t z(0); z < extent[2]; ++z)
+	for (size_t y(0); y < extent[1]; ++y)
+	  for (size_t x(0); x < extent[0]; ++x)
+	    for (size_t j(_cellHead[cells[0][x] + cells[1][y] + cells[2][z]]); j != NONE; j = _spheres[j].next)
+	      {
+		const Sphere& other = _spheres[j];
+		double r2(0);
+		for (size_t iDim(0); iDim < NDIM; ++iDim)
+		  {
+		    //Minimum image, both positions are inside the box
+		    double rij = std::abs(trial.position[iDim] - other.position[iDim]);
+		    if (rij > 0.5 * dimensions[iDim])
+		      rij = dimensions[iDim] - rij;
+		    r2 += rij * rij;
+		  }
+
+		const double d = trial.radius + other.radius;
+		if (r2 < d * d)
+		  return true;
+	      }
+
+      return false;
+    }
+  };
+}
@@ -30,10 +30,15 @@ namespace dynamo {
     std::array<long, 3> cells;
     Vector  dimensions;
 
-    virtual std::vector<Vector  > placeObjects(const Vector & centre)
+    virtual std::vector<Vector> placeObjects(const Vector & centre)
+    {
+      std::vector<Vector> retval;
+      appendObjects(centre, retval);
+      return retval;
+    }
+
+    virtual void appendObjects(const Vector& centre, std::vector<Vector>& sites)
     {
-      std::vector<Vector  > retval;
-  
       Vector  cellWidth;
       for (size_t iDim = 0; iDim < NDIM; ++iDim)
 	cellWidth[iDim] = dimensions[iDim] / cells[iDim];
@@ -50,11 +55,8 @@ namespace dynamo {
 		position[iDim] = cellWidth[iDim] * (iterVec[iDim] + 0.5) - 0.5 * dimensions[iDim] + centre[iDim];
 
 	      //Get the next unit cells positions and push them to your list
-	      const std::vector<Vector>& newsites = uc->placeObjects(position);
-	      retval.insert(retval.end(), newsites.begin(), newsites.end());
+	      uc->appendObjects(position, sites);
 	    }
-    
-      return retval;
     }
   };
 }
@@ -45,7 +45,9 @@
 #include <magnet/math/matrix.hpp>
 #include <magnet/exception.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
 
 namespace dynamo {
@@ -112,6 +114,7 @@ namespace dynamo {
        "\n26: Polydisperse (Gaussian) hard spheres in LEBC (shearing)"
        "\n27: Crystal pack of snowmen molecules"
        "\n28: Rotating drum made out of particles."
+       "\n29: Disordered polydisperse hard spheres (random sequential addition)"
        );
 
     return retval;
@@ -3120,6 +3123,108 @@ namespace dynamo {
 	    Sim->dynamics->initOrientations(1);
 	  break;
 	}
+      case 29:
+	{
+	  if (vm.count("help"))
+	    {
+	      std::cout<<
+		"Mode specific options:\n"
+		"  29: Disordered polydisperse (Gaussian) hard spheres, placed by random sequential addition\n"
+		"      Note: Generated particle diameters are restricted to the range (0,1].\n"
+		"            Mass is distributed according to volume (constant density).\n"
+		"            A particle with diameter of 1 has a mass of 1.\n"
+		"            The density (-d) is the number density in units of the largest diameter.\n"
+		"            Random sequential addition jams at a packing fraction around 0.38, so\n"
+		"            denser systems must be compressed (see dynarun --engine=3).\n"
+		"       --i1 : Number of spheres [1000]\n"
+		"       --f1 : Inelasticity [1.0]\n"
+		"       --f2 : Mean size [1.0]\n"
+		"       --f3 : Standard deviation [0.0]\n";
+	      exit(1);
+	    }
+
+	  size_t N = 1000;
+	  if (vm.count("i1"))
+	    N = vm["i1"].as<size_t>();
+
+	  double elasticity = 1.0;
+	  if (vm.count("f1"))
+	    elasticity = vm["f1"].as<double>();
+
+	  double mean = 1.0;
+	  if (vm.count("f2"))
+	    mean = vm["f2"].as<double>();
+
+	  double variance = 0.0;
+	  if (vm.count("f3"))
+	    variance = vm["f3"].as<double>();
+
+	  if (vm.count("rectangular-box"))
+	    Sim->primaryCellSize = getNormalisedCellDimensions();
+
+	  double simVol = 1.0;
+	  for (size_t iDim = 0; iDim < NDIM; ++iDim)
+	    simVol *= Sim->primaryCellSize[iDim];
+
+	  const double particleDiam = std::cbrt(simVol * vm["density"].as<double>() / N);
+
+	  //Generate the diameters, the largest are placed first as this
+	  //allows denser packings to be reached
+	  std::vector<double> diameters(N, mean);
+	  if (variance > 0)
+	    {
+	      std::normal_distribution<> normal_dist(mean, variance);
+	      for (double& diameter : diameters)
+		{
+		  diameter = normal_dist(Sim->ranGenerator);
+		  for (size_t attempt(0); ((diameter <= 0) || (diameter > 1)) && (attempt < 100); ++attempt)
+		    diameter = normal_dist(Sim->ranGenerator);
+
+		  if ((diameter <= 0) || (diameter > 1))
+		    M_throw() << "After 100 attempts, not a single valid particle diameter could be generated."
+			      << "Please recheck the distribution parameters";
+		}
+	      std::sort(diameters.begin(), diameters.end(), std::greater<double>());
+	    }
+	  else if ((mean <= 0) || (mean > 1))
+	    M_throw() << "The mean size must be in the range (0,1]";
+
+	  std::vector<double> boxDiameters(diameters);
+	  for (double& diameter : boxDiameters)
+	    diameter *= particleDiam;
+
+	  std::vector<Vector> latticeSites;
+	  latticeSites.reserve(N);
+	  {
+	    CURSA packroutine(boxDiameters, Sim->primaryCellSize, new UParticle());
+	    packroutine.initialise();
+	    packroutine.appendObjects(Vector{0,0,0}, latticeSites);
+	  }
+
+	  shared_ptr<ParticleProperty> D(new ParticleProperty(N, Property::Units::Length(), "D", particleDiam));
+	  shared_ptr<ParticleProperty> M(new ParticleProperty(N, Property::Units::Mass(), "M", 1.0));
+	  Sim->_properties.push(D);
+	  Sim->_properties.push(M);
+
+	  for (size_t i(0); i < N; ++i)
+	    {
+	      D->getProperty(i) = boxDiameters[i];
+	      //A particle with unit diameter has unit mass
+	      M->getProperty(i) = diameters[i] * diameters[i] * diameters[i];
+	    }
+
+	  Sim->interactions.push_back(shared_ptr<Interaction>(new IHardSphere(Sim, "D", elasticity, new IDPairRangeAll(), "Bulk")));
+	  Sim->addSpecies(shared_ptr<Species>(new SpPoint(Sim, new IDRangeAll(Sim), "M", "Bulk", 0)));
+	  Sim->units.setUnitLength(particleDiam);
+
+	  unsigned long nParticles = 0;
+	  Sim->particles.reserve(latticeSites.size());
+	  for (const Vector & position : latticeSites)
+	    Sim->particles.push_back(Particle(position, getRandVelVec() * Sim->units.unitVelocity(), nParticles++));
+
+	  Sim->setCOMVelocity();
+	  break;
+	}
       default:
 	M_throw() << "Did not recognise the packer mode you wanted";
       }
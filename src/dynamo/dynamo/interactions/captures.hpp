@@ -20,11 +20,15 @@
 #include <dynamo/particle.hpp>
 #include <dynamo/interactions/interaction.hpp>
 #include <magnet/exception.hpp>
-#ifdef DYNAMO_JUDY
+#include <magnet/containers/vector_set.hpp>
+#if defined(DYNAMO_FLAT_CAPTURE_MAP)
+# include <magnet/containers/flat_hash_map.hpp>
+#elif defined(DYNAMO_JUDY)
 # include <magnet/containers/judy.hpp>
 #else
 # include <unordered_map>
 #endif
+#include <algorithm>
 #include <map>
 #include <unordered_set>
 
@@ -37,6 +41,7 @@ namespace dynamo {
       \code assert(cMapKey(a,b) == cMapKey(b,a)); \endcode
     */
     struct PairKey {
+      inline PairKey(): _key(0) {}
       inline PairKey(const PairKey& o) { _key = o._key; }
       inline PairKey(uint64_t val) { _key = val; }
       inline PairKey(const size_t p1, size_t p2):
@@ -69,12 +74,19 @@ namespace std
 
 namespace dynamo {
   namespace detail {
-    namespace {
-      ::std::size_t
-      hash_combine(const ::std::size_t hash1, const ::std::size_t hash2)
-      {
-	return hash1 ^ (hash2 + 0x9e3779b9 + (hash1 << 6) + (hash1 >> 2));
-      }
+    /*! \brief The hash of a single entry of a CaptureMap.
+
+      The hash of a whole map is the sum of the hashes of its
+      entries. This is independent of the order of the entries, and
+      can be updated as entries are added and removed.
+     */
+    inline uint64_t captureEntryHash(const PairKey key, const size_t state)
+    {
+      //The splitmix64 finaliser
+      uint64_t z = uint64_t(key) + 0x9e3779b97f4a7c15ULL * (state + 1);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
     }
     
     /*!\brief This is a container that stores a single size_t
@@ -82,18 +94,29 @@ namespace dynamo {
        
       To efficiently store the state of all possible particle
       pairings, a map is used and entries are only stored if the
-      state is non-zero. Although an unordered_map may be slightly
-      faster, a map is used to allow comparison of CaptureMaps and a
-      rapid hashing if CaptureMaps are to be used as an index of the
-      simulation state.
+      state is non-zero. The underlying container is selected at
+      build time: the open addressing FlatHashMap
+      (DYNAMO_FLAT_CAPTURE_MAP), a Judy array (DYNAMO_JUDY), or
+      a std::unordered_map. As the iteration order is not sorted for
+      all of these, the \ref CaptureMapKey must be used to compare
+      CaptureMaps or to use them as an index of the simulation state.
        
       To facilitate the storage only if non-zero behaviour, the array
       access operator is overloaded to automatically return a size_t
       0 for any entry which is missing. It also returns a proxy which
       deletes entries when they are set to 0.
+
+      Alongside the map, an adjacency index of the captured partners
+      of each particle is maintained. This allows the captured pairs
+      of a single particle to be visited without scanning the map. An
+      order independent hash of the contents (see captureEntryHash) is
+      also maintained, so that the current map can be identified
+      without sorting it into a \ref CaptureMapKey.
     */
 
-#ifdef DYNAMO_JUDY
+#if defined(DYNAMO_FLAT_CAPTURE_MAP)
+    typedef magnet::containers::FlatHashMap<PairKey, size_t> CaptureMapContainer;
+#elif defined(DYNAMO_JUDY)
     typedef magnet::containers::JudyMap<PairKey, size_t> CaptureMapContainer;
 #else
     typedef std::unordered_map<PairKey, size_t> CaptureMapContainer;
@@ -102,29 +125,27 @@ namespace dynamo {
     {
       typedef CaptureMapContainer Container;
     public:
+      typedef magnet::containers::VectorSet<size_t> PartnerList;
+
       /*!\brief This proxy is used to double check if an assignment of
 	zero is done, and delete the entry if it is. */
       struct EntryProxy {
       public:
-	EntryProxy(Container& container, const PairKey& key):
-	  _container(container), _key(key) {}
+	EntryProxy(CaptureMap& map, const PairKey& key):
+	  _map(map), _key(key) {}
 
 	operator const size_t() const {
-	  const auto it (_container.find(_key));
-	  return (it == _container.end()) ? 0 : (it->second);
+	  const auto it (_map.find(_key));
+	  return (it == _map.end()) ? 0 : (it->second);
 	}
 	
 	EntryProxy& operator=(size_t newval) {
-	  if (newval == 0)
-	    _container.erase(_key);
-	  else
-	    _container[_key] = newval;
-
+	  _map.set(_key, newval);
 	  return *this;
 	}
 	
       private:
-	Container& _container;
+	CaptureMap& _map;
 	const PairKey _key;
       };
       
@@ -140,20 +161,89 @@ namespace dynamo {
 	Container::const_iterator it = Container::find(key);
 	return (it == Container::end()) ? 0 : (it->second);
       }
+
+      /*! \brief Set the state of a pair, removing the entry if the
+          new state is zero. */
+      void set(const PairKey& key, size_t newval) {
+	const auto it = Container::find(key);
+	const size_t oldval = (it == Container::end()) ? 0 : it->second;
+	if (oldval == newval) return;
+	if (oldval) _hash -= captureEntryHash(key, oldval);
+	if (newval) _hash += captureEntryHash(key, newval);
+
+	//The container size is used to detect if an entry was
+	//added/removed.
+	const size_t oldsize = Container::size();
+	if (newval == 0)
+	  {
+	    Container::erase(key);
+	    if (Container::size() != oldsize)
+	      {
+		_partners[key.first].erase(key.second);
+		_partners[key.second].erase(key.first);
+	      }
+	  }
+	else
+	  {
+	    Container::operator[](key) = newval;
+	    if (Container::size() != oldsize)
+	      {
+		const size_t maxID = std::max(key.first, key.second);
+		if (maxID >= _partners.size())
+		  _partners.resize(maxID + 1);
+		_partners[key.first].insert(key.second);
+		_partners[key.second].insert(key.first);
+	      }
+	  }
+      }
+
+      //! \brief Remove all entries in the map.
+      void clear() {
+	Container::clear();
+	_partners.clear();
+	_hash = 0;
+      }
+
+      //! \brief The sum of the captureEntryHash of every entry.
+      uint64_t getHash() const { return _hash; }
+
+      /*! \brief The IDs of the particles which have a non-zero state
+          with the particle ID. */
+      const PartnerList& getPartners(size_t ID) const {
+	static const PartnerList empty;
+	return (ID < _partners.size()) ? _partners[ID] : empty;
+      }
+
+    private:
+      std::vector<PartnerList> _partners;
+      uint64_t _hash = 0;
     };
 
-    struct CaptureMapKey: public std::vector<CaptureMap::value_type>
+    /*! \brief A sorted copy of the contents of a CaptureMap.
+
+      This is used to compare CaptureMaps and to store them in
+      containers, as the iteration order of the CaptureMap itself
+      depends on the container selected at build time.
+     */
+    struct CaptureMapKey: public std::vector<std::pair<PairKey, size_t> >
     {
-      typedef std::vector<CaptureMap::value_type> Container;
+      typedef std::vector<std::pair<PairKey, size_t> > Container;
       CaptureMapKey(const CaptureMap& map):
-      Container(map.begin(), map.end()) {}
+	Container(map.begin(), map.end())
+      { std::sort(Container::begin(), Container::end(), KeyCompare()); }
 
+      //! \brief The hash of the map, equal to CaptureMap::getHash() of the original map.
       std::size_t hash() const {
-	std::size_t hash(0);
+	uint64_t hash(0);
 	for (const Container::value_type& val : *this)
-	  hash = hash_combine(hash, hash_combine(size_t(val.first), size_t(val.second)));
+	  hash += captureEntryHash(val.first, val.second);
 	return hash;
       }
+
+      struct KeyCompare {
+	bool operator()(const Container::value_type& a, const Container::value_type& b) const
+	{ return uint64_t(a.first) < uint64_t(b.first); }
+      };
     };
 
     /*! \brief A functor to allow the storage of CaptureMapKey types
@@ -41,6 +41,10 @@ namespace dynamo {
   { 
     Interaction::initialise(nID);
 
+    _diameterColumn = _diameter->getColumn();
+    if (_e) _eColumn = _e->getColumn();
+    if (_et) _etColumn = _et->getColumn();
+
     if (_et && !Sim->dynamics->hasOrientationData())
       M_throw() << "Interaction'" << getName() 
 		<< "': To use a tangential coefficient of restitution, you must have orientation data for the particles in your configuration file.";
@@ -92,7 +96,7 @@ namespace dynamo {
       M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
 #endif 
 
-    const double d = _diameter->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
     const double dt = Sim->dynamics->SphereSphereInRoot(p1, p2, d);
 
     if (dt != std::numeric_limits<float>::infinity())
@@ -106,16 +110,16 @@ namespace dynamo {
   {
     ++Sim->eventCount;
 
-    const double d1 = _diameter->getProperty(p1);
-    const double d2 = _diameter->getProperty(p2);
-    const double d = _diameter->getProperty(p1, p2);
+    const double d1 = _diameterColumn(p1);
+    const double d2 = _diameterColumn(p2);
+    const double d = _diameterColumn(p1, p2);
 
     double e = 1.0;
-    if (_e) e = _e->getProperty(p1, p2);
+    if (_e) e = _eColumn(p1, p2);
    
     PairEventData EDat;
     if (_et)
-      return Sim->dynamics->RoughSpheresColl(iEvent, e, _et->getProperty(p1, p2), d1, d2);
+      return Sim->dynamics->RoughSpheresColl(iEvent, e, _etColumn(p1, p2), d1, d2);
     else
       return Sim->dynamics->SmoothSpheresColl(iEvent, e, d * d);
   }
@@ -134,7 +138,7 @@ namespace dynamo {
   bool
   IHardSphere::validateState(const Particle& p1, const Particle& p2, bool textoutput) const
   {
-    const double d = _diameter->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
     if (Sim->dynamics->sphereOverlap(p1, p2, d))
       {
 	if (textoutput)
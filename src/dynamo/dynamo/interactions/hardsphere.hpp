@@ -79,9 +79,16 @@ namespace dynamo {
 
     void outputData(magnet::xml::XmlStream& XML) const;
 
+    const shared_ptr<Property>& getDiameterProperty() const { return _diameter; }
+
   protected:
     shared_ptr<Property> _diameter;
     shared_ptr<Property> _e;
     shared_ptr<Property> _et;
+
+    //! \brief Direct access to the property values, bound in initialise().
+    PropertyColumn _diameterColumn;
+    PropertyColumn _eColumn;
+    PropertyColumn _etColumn;
   };
 }
@@ -51,6 +51,15 @@ namespace dynamo {
       _e = Sim->_properties.getProperty(1.0, Property::Units::Dimensionless());
   }
 
+  void 
+  ISquareBond::initialise(size_t nID)
+  {
+    Interaction::initialise(nID);
+    _diameterColumn = _diameter->getColumn();
+    _lambdaColumn = _lambda->getColumn();
+    _eColumn = _e->getColumn();
+  }
+
   double 
   ISquareBond::getCaptureEnergy() const 
   { return 0.0; }
@@ -63,8 +72,8 @@ namespace dynamo {
   bool 
   ISquareBond::captureTest(const Particle& p1, const Particle& p2) const
   {
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
   
 #ifdef DYNAMO_DEBUG
     if (Sim->dynamics->sphereOverlap(p1, p2, d))
@@ -80,8 +89,8 @@ namespace dynamo {
   bool
   ISquareBond::validateState(const Particle& p1, const Particle& p2, bool textoutput) const
   {
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
     if (!Sim->dynamics->sphereOverlap(p1, p2, d * l))
       {
@@ -144,8 +153,8 @@ namespace dynamo {
       M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
 #endif 
 
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
     Event retval(p1, std::numeric_limits<float>::infinity(), INTERACTION, NONE, ID, p2);
 
@@ -170,8 +179,8 @@ namespace dynamo {
       M_throw() << "Unknown type found";
 #endif
 
-    const double d = _diameter->getProperty(p1, p2);
-    return Sim->dynamics->SmoothSpheresColl(iEvent, _e->getProperty(p1, p2), d * d, iEvent._type);
+    const double d = _diameterColumn(p1, p2);
+    return Sim->dynamics->SmoothSpheresColl(iEvent, _eColumn(p1, p2), d * d, iEvent._type);
   }
     
   void 
@@ -47,6 +47,8 @@ namespace dynamo {
 
     virtual double maxIntDist() const;
 
+    virtual void initialise(size_t);
+
     virtual double getCaptureEnergy() const;
 
     virtual bool captureTest(const Particle&, const Particle&) const;
@@ -66,5 +68,10 @@ namespace dynamo {
     shared_ptr<Property> _diameter;
     shared_ptr<Property> _lambda;
     shared_ptr<Property> _e;
+
+    //! \brief Direct access to the property values, bound in initialise().
+    PropertyColumn _diameterColumn;
+    PropertyColumn _lambdaColumn;
+    PropertyColumn _eColumn;
   };
 }
@@ -77,6 +77,10 @@ namespace dynamo {
   ISquareWell::initialise(size_t nID)
   {
     Interaction::initialise(nID);
+    _diameterColumn = _diameter->getColumn();
+    _lambdaColumn = _lambda->getColumn();
+    _wellDepthColumn = _wellDepth->getColumn();
+    _eColumn = _e->getColumn();
     ICapture::initCaptureMap();
   }
 
@@ -85,8 +89,8 @@ namespace dynamo {
   {
     if (&(*(Sim->getInteraction(p1, p2))) != this) return false;
 
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
 #ifdef DYNAMO_DEBUG
     if (Sim->dynamics->sphereOverlap(p1, p2, d))
@@ -113,8 +117,8 @@ namespace dynamo {
       M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
 #endif 
 
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
  
     Event retval(p1, std::numeric_limits<float>::infinity(), INTERACTION, NONE, ID, p2);
 
@@ -144,12 +148,12 @@ namespace dynamo {
   {
     ++Sim->eventCount;
 
-    const double d = _diameter->getProperty(p1,p2);
+    const double d = _diameterColumn(p1, p2);
     const double d2 = d * d;
-    const double e = _e->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double e = _eColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
     const double ld2 = d * l * d * l;
-    const double wd = _wellDepth->getProperty(p1, p2);
+    const double wd = _wellDepthColumn(p1, p2);
 
     PairEventData retVal;
     switch (iEvent._type)
@@ -176,8 +180,8 @@ namespace dynamo {
   bool
   ISquareWell::validateState(const Particle& p1, const Particle& p2, bool textoutput) const
   {
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
     if (isCaptured(p1, p2))
       {
@@ -249,6 +253,6 @@ namespace dynamo {
   double 
   ISquareWell::getInternalEnergy(const Particle& p1, const Particle& p2) const
   {
-    return - _wellDepth->getProperty(p1, p2) * isCaptured(p1, p2);
+    return - _wellDepthColumn(p1, p2) * isCaptured(p1, p2);
   }
 }
@@ -66,5 +66,11 @@ namespace dynamo {
     shared_ptr<Property> _lambda;
     shared_ptr<Property> _wellDepth;
     shared_ptr<Property> _e;
+
+    //! \brief Direct access to the property values, bound in initialise().
+    PropertyColumn _diameterColumn;
+    PropertyColumn _lambdaColumn;
+    PropertyColumn _wellDepthColumn;
+    PropertyColumn _eColumn;
   };
 }
@@ -31,6 +31,8 @@
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 #include <boost/math/special_functions/pow.hpp>
+#include <algorithm>
+#include <limits>
 #include <cmath>
 #include <iomanip>
 
@@ -38,7 +40,8 @@ namespace dynamo {
   IStepped::IStepped(const magnet::xml::Node& XML, dynamo::Simulation* tmp):
     ICapture(tmp, NULL),
     _lengthScale(Sim->_properties.getProperty(Sim->units.unitLength(), Property::Units::Length())),
-    _energyScale(Sim->_properties.getProperty(Sim->units.unitEnergy(), Property::Units::Energy()))
+    _energyScale(Sim->_properties.getProperty(Sim->units.unitEnergy(), Property::Units::Energy())),
+    _uniformSpacing(0)
   {
     operator<<(XML);
   }
@@ -79,7 +82,106 @@ namespace dynamo {
   IStepped::initialise(size_t nID)
   {
     Interaction::initialise(nID);
+    _lengthScaleColumn = _lengthScale->getColumn();
+    _energyScaleColumn = _energyScale->getColumn();
+
+    _steps.clear();
+    _radii.clear();
+    _uniformSpacing = 0;
+
+    const size_t steps = _potential->steps();
+    if (steps == std::numeric_limits<size_t>::max())
+      //The potential has an unbounded number of steps, just compile
+      //what has been calculated so far. The table is extended below
+      //to cover the initial configuration.
+      compileSteps(_potential->cached_steps() + 1);
+    else
+      {
+	compileSteps(steps + 1);
+
+	//Check if the discontinuities are evenly spaced, so that the
+	//step ID can be directly calculated from the separation.
+	if (_radii.size() > 2)
+	  {
+	    const double spacing = (_radii.back() - _radii.front()) / (_radii.size() - 1);
+	    bool uniform = (spacing != 0);
+	    for (size_t i(1); uniform && (i + 1 < _radii.size()); ++i)
+	      uniform = std::abs(_radii[i] - (_radii.front() + i * spacing)) <= 1e-10 * std::abs(spacing);
+	    if (uniform) _uniformSpacing = spacing;
+	  }
+      }
+
     ICapture::initCaptureMap();
+
+    //The pairs of the initial configuration may be on deeper steps
+    //of an unbounded potential. Cover these, and leave some room for
+    //the pairs to move deeper before runEvent extends the table.
+    if (steps == std::numeric_limits<size_t>::max())
+      {
+	size_t deepest = _potential->cached_steps();
+	for (const auto& entry : static_cast<const detail::CaptureMap&>(*this))
+	  deepest = std::max(deepest, entry.second);
+	compileSteps(2 * (deepest + 1));
+      }
+  }
+
+  void
+  IStepped::compileSteps(size_t count)
+  {
+    //The step IDs run from 0 to steps() inclusive
+    const size_t steps = _potential->steps();
+    count = std::min(count - 1, steps) + 1;
+
+    for (size_t ID(_steps.size()); ID < count; ++ID)
+      _steps.push_back(calculateStep(ID));
+
+    for (size_t ID(_radii.size()); ID < std::min(count, steps); ++ID)
+      _radii.push_back((*_potential)[ID].first);
+  }
+
+  IStepped::StepData
+  IStepped::calculateStep(const size_t ID) const
+  {
+    std::lock_guard<std::mutex> lock(_potentialLock);
+    const std::pair<double, double> bounds = _potential->getStepBounds(ID);
+    StepData data;
+    data.inner = bounds.first;
+    data.outer = bounds.second;
+    data.inner2 = bounds.first * bounds.first;
+    data.outer2 = bounds.second * bounds.second;
+    data.energy = _potential->getEnergyChange(0, ID);
+    return data;
+  }
+
+  size_t
+  IStepped::calculateStepID(const double r) const
+  {
+    //The step ID is the number of discontinuities which have been
+    //crossed moving from the zeroth step to r.
+    const bool outward = _potential->direction();
+    auto crossed = [=](const double edge) { return outward ? (r > edge) : (r < edge); };
+
+    if (_uniformSpacing != 0)
+      {
+	const double estimate = std::ceil((r - _radii.front()) / _uniformSpacing);
+	size_t ID = 0;
+	if (estimate > 0)
+	  ID = (estimate >= _radii.size()) ? _radii.size() : size_t(estimate);
+	//Correct for any rounding at the discontinuities
+	while ((ID > 0) && !crossed(_radii[ID - 1])) --ID;
+	while ((ID < _radii.size()) && crossed(_radii[ID])) ++ID;
+	return ID;
+      }
+
+    size_t ID = std::partition_point(_radii.begin(), _radii.end(), crossed) - _radii.begin();
+    if ((ID < _radii.size()) || (_radii.size() == _potential->steps()))
+      return ID;
+
+    //The separation is beyond the compiled steps of an unbounded
+    //potential, search the remaining steps directly.
+    std::lock_guard<std::mutex> lock(_potentialLock);
+    while ((ID < _potential->steps()) && crossed((*_potential)[ID].first)) ++ID;
+    return ID;
   }
 
   size_t 
@@ -87,12 +189,12 @@ namespace dynamo {
   {
     if (&(*(Sim->getInteraction(p1, p2))) != this) return false;
   
-    const double length_scale = _lengthScale->getProperty(p1, p2);
+    const double length_scale = _lengthScaleColumn(p1, p2);
 
     Vector rij = p1.getPosition() - p2.getPosition();
     Sim->BCs->applyBC(rij);
     
-    return _potential->calculateStepID(rij.nrm() / length_scale);
+    return calculateStepID(rij.nrm() / length_scale);
   }
 
   double 
@@ -109,8 +211,8 @@ namespace dynamo {
   {
     size_t capstat = ICapture::operator[](ICapture::key_type(p1, p2));
     if (capstat == 0) return 0;
-    const double energy_scale = _energyScale->getProperty(p1, p2);
-    return (*_potential)[capstat - 1].second * energy_scale;
+    const double energy_scale = _energyScaleColumn(p1, p2);
+    return getStep(capstat).energy * energy_scale;
   }
 
   Event
@@ -128,21 +230,20 @@ namespace dynamo {
       M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
 #endif 
 
-    const size_t current_step_ID = ICapture::operator[](ICapture::key_type(p1, p2));
-    const std::pair<double, double> step_bounds = _potential->getStepBounds(current_step_ID);
-    const double length_scale = _lengthScale->getProperty(p1, p2);
+    const StepData& step = getStep(ICapture::operator[](ICapture::key_type(p1, p2)));
+    const double length_scale = _lengthScaleColumn(p1, p2);
 
     Event retval(p1, std::numeric_limits<float>::infinity(), INTERACTION, NONE, ID, p2);
-    if (step_bounds.first != 0)
+    if (step.inner != 0)
       {//Test for the inner step capture
-	const double dt = Sim->dynamics->SphereSphereInRoot(p1, p2, step_bounds.first * length_scale);
+	const double dt = Sim->dynamics->SphereSphereInRoot(p1, p2, step.inner * length_scale);
 	if (dt != std::numeric_limits<float>::infinity())
 	  retval = Event(p1, dt, INTERACTION, STEP_IN, ID, p2);
       }
 
-    if (!std::isinf(step_bounds.second))
+    if (!std::isinf(step.outer))
       {//Test for the outer step capture
-	const double dt = Sim->dynamics->SphereSphereOutRoot(p1, p2, step_bounds.second * length_scale);
+	const double dt = Sim->dynamics->SphereSphereOutRoot(p1, p2, step.outer * length_scale);
 	if (retval._dt > dt)
 	  retval = Event(p1, dt, INTERACTION, STEP_OUT, ID, p2);
       }
@@ -155,36 +256,44 @@ namespace dynamo {
   {
     ++Sim->eventCount;
 
-    const double length_scale = _lengthScale->getProperty(p1, p2);
-    const double energy_scale = _energyScale->getProperty(p1, p2);
+    const double length_scale = _lengthScaleColumn(p1, p2);
+    const double energy_scale = _energyScaleColumn(p1, p2);
 
     const size_t old_step_ID = ICapture::operator[](ICapture::key_type(p1, p2));
-    const std::pair<double, double> step_bounds = _potential->getStepBounds(old_step_ID);
+    //Copied, as compiling the new step may reallocate the table
+    const StepData old_step = getStep(old_step_ID);
 
     size_t new_step_ID;
     size_t edge_ID;
-    double diameter;
+    double diameter2;
     switch (iEvent._type)
       {
       case STEP_OUT:
 	{
 	  new_step_ID = _potential->outer_step_ID(old_step_ID);
 	  edge_ID = _potential->outer_edge_ID(old_step_ID);
-	  diameter = step_bounds.second * length_scale;
+	  diameter2 = old_step.outer2 * length_scale * length_scale;
 	  break;
 	}
       case STEP_IN:
 	{
 	  new_step_ID = _potential->inner_step_ID(old_step_ID);
 	  edge_ID = _potential->inner_edge_ID(old_step_ID);
-	  diameter = step_bounds.first * length_scale;
+	  diameter2 = old_step.inner2 * length_scale * length_scale;
 	  break;
 	}
       default:
 	M_throw() << "Unknown event type";
       } 
 
-    PairEventData retVal = Sim->dynamics->SphereWellEvent(iEvent, _potential->getEnergyChange(new_step_ID, old_step_ID) * energy_scale, diameter * diameter, new_step_ID);
+    //Extend the table of an unbounded potential before the pair
+    //reaches its last step. Events are executed serially, so this
+    //never races with the (possibly parallel) event predictions.
+    if (new_step_ID + 1 >= _steps.size())
+      compileSteps(2 * (new_step_ID + 1));
+
+    const double deltaKE = (old_step.energy - getStep(new_step_ID).energy) * energy_scale;
+    PairEventData retVal = Sim->dynamics->SphereWellEvent(iEvent, deltaKE, diameter2, new_step_ID);
     EdgeData& data = _edgedata[std::pair<size_t, EEventType>(edge_ID, retVal.getType())];
     ++data.counter;
     data.rdotv_sum += retVal.rvdot;
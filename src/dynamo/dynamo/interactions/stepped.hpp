@@ -21,9 +21,25 @@
 #include <dynamo/interactions/potentials/potential.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/eventtypes.hpp>
+#include <mutex>
 #include <vector>
 
 namespace dynamo {
+  /*! \brief An interaction described by a stepped Potential.
+
+    The step ID of each captured pair is stored in the capture
+    map. Looking up the bounds and energy of a step through the
+    Potential searches (and possibly extends) its step cache, so the
+    steps are compiled at initialise() into a flat table which is
+    used when the events are calculated and executed. Potentials
+    with an unbounded number of steps (e.g., Lennard-Jones with
+    energy stepping) start with a table covering the steps of the
+    initial configuration, which is extended by runEvent() as pairs
+    approach its end. The table is never modified while events are
+    predicted, so the predictions may run in parallel. Steps beyond
+    the table (e.g., of pairs captured directly by the capture map)
+    are calculated from the Potential under a lock.
+   */
   class IStepped: public ICapture
   {
   public:
@@ -32,7 +48,8 @@ namespace dynamo {
       ICapture(tmp,nR),
       _lengthScale(Sim->_properties.getProperty(length, Property::Units::Length())),
       _energyScale(Sim->_properties.getProperty(energy, Property::Units::Energy())),
-      _potential(potential)
+      _potential(potential),
+      _uniformSpacing(0)
     { intName = name; }
 
     IStepped(const magnet::xml::Node&, dynamo::Simulation*);
@@ -69,8 +86,50 @@ namespace dynamo {
     //!This class is used to track how the energy scale changes in the system
     shared_ptr<Property> _energyScale;
 
+    //! \brief Direct access to the property values, bound in initialise().
+    PropertyColumn _lengthScaleColumn;
+    PropertyColumn _energyScaleColumn;
+
     shared_ptr<Potential> _potential;
-    
+
+    //! \brief The compiled form of a single step of the potential.
+    struct StepData {
+      //! \brief The inner and outer radii of the step (zero and infinity if unbounded).
+      double inner, outer;
+      //! \brief The squared radii of the step.
+      double inner2, outer2;
+      //! \brief The energy of a pair on this step.
+      double energy;
+    };
+
+    //! \brief The compiled steps, indexed by the step ID.
+    std::vector<StepData> _steps;
+    //! \brief The discontinuity radii, in the order of the step IDs.
+    std::vector<double> _radii;
+    //! \brief The spacing of the discontinuities if they are uniform, otherwise zero.
+    double _uniformSpacing;
+    /*! \brief Serialises the access to the step cache of the
+        Potential for the steps beyond the compiled table.
+     */
+    mutable std::mutex _potentialLock;
+
+    /*! \brief Returns the data of a step, from the compiled table
+        if it is present.
+     */
+    StepData getStep(const size_t ID) const {
+      if (ID < _steps.size()) return _steps[ID];
+      return calculateStep(ID);
+    }
+
+    //! \brief Compile the steps of the potential up to (but not including) the passed step ID.
+    void compileSteps(size_t);
+
+    //! \brief Calculate the data of a step directly from the Potential.
+    StepData calculateStep(size_t) const;
+
+    //! \brief Determine the step ID of a pair at a separation (in units of the length scale).
+    size_t calculateStepID(double) const;
+
     struct EdgeData {
       EdgeData(): counter(0), rdotv_sum(0) {}
       size_t counter;
@@ -145,7 +145,7 @@ namespace dynamo {
   ISWSequence::getInternalEnergy(const Particle& p1, const Particle& p2) const
   {
     return -alphabet[sequence[p1.getID() % sequence.size()]][sequence[p2.getID() % sequence.size()]]
-      * _unitEnergy->getProperty(p1, p2) * isCaptured(p1, p2);
+      * _unitEnergyColumn(p1, p2) * isCaptured(p1, p2);
   }
 
 
@@ -165,6 +165,10 @@ namespace dynamo {
   ISWSequence::initialise(size_t nID)
   {
     Interaction::initialise(nID);
+    _diameterColumn = _diameter->getColumn();
+    _lambdaColumn = _lambda->getColumn();
+    _unitEnergyColumn = _unitEnergy->getColumn();
+    _eColumn = _e->getColumn();
     ICapture::initCaptureMap();
   }
 
@@ -173,8 +177,8 @@ namespace dynamo {
   {
     if (&(*(Sim->getInteraction(p1, p2))) != this) return false;
 
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
 #ifdef DYNAMO_DEBUG
     if (Sim->dynamics->sphereOverlap(p1, p2, d))
@@ -205,8 +209,8 @@ namespace dynamo {
       M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
 #endif 
 
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
     const double pairenergy = alphabet[sequence[p1.getID() % sequence.size()]][sequence[p2.getID() % sequence.size()]] * _unitEnergy->getMaxValue();
 
     /* Check if there is no well here at all, and just use a hard core interaction */
@@ -246,10 +250,10 @@ namespace dynamo {
   {  
     ++Sim->eventCount;
 
-    const double e = _e->getProperty(p1, p2);
-    const double d = _diameter->getProperty(p1, p2);
+    const double e = _eColumn(p1, p2);
+    const double d = _diameterColumn(p1, p2);
     const double d2 = d * d;
-    const double l = _lambda->getProperty(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
     const double ld2 = d * l * d * l;
     const double pairenergy = alphabet[sequence[p1.getID() % sequence.size()]][sequence[p2.getID() % sequence.size()]] * _unitEnergy->getMaxValue();
     
@@ -279,8 +283,8 @@ namespace dynamo {
   bool
   ISWSequence::validateState(const Particle& p1, const Particle& p2, bool textoutput) const
   {
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
     
     const double pairenergy = alphabet[sequence[p1.getID() % sequence.size()]][sequence[p2.getID() % sequence.size()]] * _unitEnergy->getMaxValue();
 
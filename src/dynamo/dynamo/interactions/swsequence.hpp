@@ -90,6 +90,12 @@ namespace dynamo {
     //!This class is used to track how the energy scale changes in the system
     shared_ptr<Property> _unitEnergy;
     shared_ptr<Property> _e;
+
+    //! \brief Direct access to the property values, bound in initialise().
+    PropertyColumn _diameterColumn;
+    PropertyColumn _lambdaColumn;
+    PropertyColumn _unitEnergyColumn;
+    PropertyColumn _eColumn;
   
     std::vector<size_t> sequence;
     std::vector<std::vector<double> > alphabet;
@@ -67,8 +67,8 @@ namespace dynamo {
       M_throw() << "You shouldn't pass p1==p2 events to the interactions!";
 #endif 
 
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
     Event retval(p1, std::numeric_limits<float>::infinity(), INTERACTION, NONE, ID, p2);
 
@@ -98,12 +98,12 @@ namespace dynamo {
   {
     ++Sim->eventCount;
 
-    const double d = _diameter->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
     const double d2 = d * d;
-    const double e = _e->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double e = _eColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
     const double ld2 = d * l * d * l;
-    const double wd = _wellDepth->getProperty(p1, p2);
+    const double wd = _wellDepthColumn(p1, p2);
 
     switch (iEvent._type)
       {
@@ -131,8 +131,8 @@ namespace dynamo {
   bool
   IThinThread::validateState(const Particle& p1, const Particle& p2, bool textoutput) const
   {
-    const double d = _diameter->getProperty(p1, p2);
-    const double l = _lambda->getProperty(p1, p2);
+    const double d = _diameterColumn(p1, p2);
+    const double l = _lambdaColumn(p1, p2);
 
     if (isCaptured(p1, p2))
       {
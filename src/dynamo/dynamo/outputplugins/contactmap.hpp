@@ -63,21 +63,25 @@ namespace dynamo {
 
     struct MapData
     {
-      MapData(double discovery_time = 0, double energy=0, size_t id = 0): 
-        _weight(0), _energy(energy), _discovery_time(discovery_time), _id(id) {}
+      MapData(const detail::CaptureMapKey& key, double discovery_time = 0, double energy=0, size_t id = 0): 
+        _key(key), _weight(0), _energy(energy), _discovery_time(discovery_time), _id(id) {}
+      //! \brief The sorted list of the captured pairs of this map.
+      detail::CaptureMapKey _key;
       double _weight;
       double _energy;
       double _discovery_time;
       size_t _id;
     };
 
-    typedef std::unordered_map<detail::CaptureMapKey, MapData,  detail::CaptureMapKeyHash> CollectedMapType;
+    typedef std::unordered_map<uint64_t, MapData> CollectedMapType;
     typedef std::unordered_map<std::pair<size_t, size_t>, size_t, detail::OPContactMapPairHash> LinksMapType;
     /*! \brief A hash table storing the histogram of the contact maps.
       
-      The key of this map is a sorted list of the captured pairs in
-      the system. This sorting is implicitly carried out by the
-      _current_map.
+      The key of this table is the hash of the capture map, which the
+      ICapture maintains as pairs are captured and released (see
+      detail::CaptureMap::getHash). The map only has to be sorted
+      into a \ref detail::CaptureMapKey when it is first
+      discovered, rather than on every change.
      */
     CollectedMapType _collected_maps;
     CollectedMapType::iterator _current_map;
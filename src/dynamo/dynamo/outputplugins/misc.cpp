@@ -495,6 +495,11 @@ namespace dynamo {
     
     XML << endtag("EventCounters")
 
+	<< tag("EventQueue")
+	<< attr("StaleEvents") << Sim->ptrScheduler->getSorter()->getStaleEventCount()
+	<< attr("RecalculateEvents") << Sim->ptrScheduler->getRecalculateCount()
+	<< endtag("EventQueue")
+
 	<< tag("PrimaryImageSimulationSize")
 	<< Sim->primaryCellSize / Sim->units.unitLength()
 	<< endtag("PrimaryImageSimulationSize")
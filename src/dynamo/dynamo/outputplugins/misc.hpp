@@ -64,6 +64,9 @@ namespace dynamo {
     double getMeanSqrUConfigurational() const;
     inline double getConfigurationalU() const { return _internalE.current(); }
 
+    //! \brief The current internal energy of a particle (half of its interaction energies).
+    inline double getParticleInternalEnergy(size_t ID) const { return _internalEnergy[ID]; }
+
     Matrix getPressureTensor() const;
 
   protected:
@@ -24,6 +24,7 @@
 #include <dynamo/particle.hpp>
 #include <magnet/xmlreader.hpp>
 #include <boost/tokenizer.hpp>
+#include <boost/algorithm/string.hpp>
 
 namespace dynamo {
   OutputPlugin::OutputPlugin(const dynamo::Simulation* tmp, const char *aName, unsigned char order):
@@ -47,6 +48,16 @@ namespace dynamo {
     return std::cout;
   }
 
+  std::vector<std::string>
+  OutputPlugin::splitList(const std::string& list)
+  {
+    std::vector<std::string> entries;
+    const std::string trimmed = boost::trim_copy(list);
+    if (!trimmed.empty())
+      boost::split(entries, trimmed, boost::is_any_of(", "), boost::token_compress_on);
+    return entries;
+  }
+
   shared_ptr<OutputPlugin>
   OutputPlugin::getPlugin(std::string Details, const dynamo::Simulation* Sim)
   {
@@ -160,6 +171,8 @@ namespace dynamo {
       return testGeneratePlugin<OPSHCrystal>(Sim, XML);
     else if (!Name.compare("SCParameter"))
       return testGeneratePlugin<OPSCParameter>(Sim, XML);
+    else if (!Name.compare("StructureFactor"))
+      return testGeneratePlugin<OPStructureFactor>(Sim, XML);
     else if (!Name.compare("MSDOrientational"))
       return testGeneratePlugin<OPMSDOrientational>(Sim, XML);
     else if (!Name.compare("MSDOrientationalCorrelator"))
@@ -18,6 +18,8 @@
 #pragma once
 #include <dynamo/base.hpp>
 #include <dynamo/eventtypes.hpp>
+#include <string>
+#include <vector>
 
 namespace magnet { namespace xml { class Node; class XmlStream; } }
 
@@ -61,6 +63,15 @@ namespace dynamo {
   
   protected:
     std::ostream& I_Pcout() const;
+
+    /*! \brief Split a list valued attribute into its entries.
+
+      The entries may be separated by spaces or commas. Only spaces
+      can be used for plugins loaded from the command line (e.g.,
+      \c -L "StructureFactor:Direction=1 1 1"), as commas separate
+      the options of the plugin.
+     */
+    static std::vector<std::string> splitList(const std::string&);
   
     // This sets the order in which these things are updated
     // 0 is first
@@ -55,9 +55,41 @@ namespace dynamo {
 
     runningsum.resize(maxWaveNumber + 1, 0);
 
+    beginSweep(1);
+    sweepParticles(0, 0, Sim->N());
     ticker();
   }
 
+  bool
+  OPSCParameter::beginSweep(size_t blocks)
+  {
+    _blockSums.resize(blocks);
+    for (std::vector<std::complex<double> >& sums : _blockSums)
+      sums.assign(maxWaveNumber + 1, std::complex<double>(0, 0));
+    return true;
+  }
+
+  void
+  OPSCParameter::sweepParticles(size_t block, size_t begin, size_t end)
+  {
+    std::vector<std::complex<double> >& sums = _blockSums[block];
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	double psum(0);
+	for (size_t iDim(0); iDim < NDIM; ++iDim)
+	  psum += Sim->particles[ID].getPosition()[iDim];
+	
+	//The phases of the wave numbers are generated by recurrence
+	const std::complex<double> phase = std::polar(1.0, 2.0 * M_PI * psum);
+	std::complex<double> e(1, 0);
+	for (size_t k(0); k <= maxWaveNumber; ++k)
+	  {
+	    sums[k] += e;
+	    e *= phase;
+	  }
+      }
+  }
+
   void 
   OPSCParameter::ticker()
   {
@@ -66,17 +98,8 @@ namespace dynamo {
     for (size_t k(0); k <= maxWaveNumber; ++k)
       {
 	std::complex<double> sum(0, 0);
-
-	for (const Particle& part : Sim->particles)
-	  {
-	    double psum(0);
-	  
-	    for (size_t iDim(0); iDim < NDIM; ++iDim)
-	      psum += part.getPosition()[iDim];
-	  
-	    psum *= 2.0 * M_PI * k;
-	    sum += std::complex<double>(std::cos(psum), std::sin(psum));
-	  }
+	for (const std::vector<std::complex<double> >& sums : _blockSums)
+	  sum += sums[k];
       
 	runningsum[k] += std::abs(sum);
       }
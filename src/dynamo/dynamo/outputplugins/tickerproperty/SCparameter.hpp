@@ -17,9 +17,18 @@
 
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <complex>
 #include <vector>
 
 namespace dynamo {
+  /*! \brief Measures the simple cubic order parameter, the mean
+      amplitude of the density modes along the (1,1,1) direction of a
+      unit box.
+
+    This is a special case of OPStructureFactor (with
+    Direction="1 1 1"), which should be used for general wave
+    vectors.
+   */
   class OPSCParameter: public OPTicker
   {
   public:
@@ -30,6 +39,10 @@ namespace dynamo {
     virtual void stream(double) {}
 
     virtual void ticker();
+
+    virtual bool beginSweep(size_t blocks);
+
+    virtual void sweepParticles(size_t block, size_t begin, size_t end);
   
     virtual void output(magnet::xml::XmlStream&);
 
@@ -40,5 +53,7 @@ namespace dynamo {
     size_t maxWaveNumber;
     size_t count;
     std::vector<double> runningsum;
+    //! \brief The partial sums of each block of the particle sweep, indexed by [block][k].
+    std::vector<std::vector<std::complex<double> > > _blockSums;
   };
 }
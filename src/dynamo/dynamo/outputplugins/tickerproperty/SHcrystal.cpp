@@ -15,25 +15,64 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <boost/math/special_functions/spherical_harmonic.hpp>
 #include <dynamo/outputplugins/tickerproperty/SHcrystal.hpp>
-#include <dynamo/schedulers/scheduler.hpp>
 #include <dynamo/globals/neighbourList.hpp>
 #include <dynamo/units/units.hpp>
 #include <dynamo/BC/BC.hpp>
-#include <boost/math/special_functions/spherical_harmonic.hpp>
 #include <magnet/math/wigner3J.hpp>
+#include <magnet/thread/threadpool.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
-#include <fstream>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <functional>
 #include <cmath>
 #include <limits>
 
 namespace dynamo {
+  namespace {
+    typedef magnet::math::SphericalHarmonics SH;
+
+    /*! \brief The coefficient of m from the coefficients with m >= 0,
+        using \f$q_{l,-m}=(-1)^m q_{lm}^*\f$.
+     */
+    inline std::complex<double> coefficient(const std::complex<double>* q, int m)
+    {
+      if (m >= 0) return q[m];
+      return (m % 2) ? -std::conj(q[-m]) : std::conj(q[-m]);
+    }
+
+    //! \brief The sum of |q_lm|^2 over all m.
+    inline double normSquared(const std::complex<double>* q, size_t l)
+    {
+      double sum = std::norm(q[0]);
+      for (size_t m(1); m <= l; ++m)
+	sum += 2 * std::norm(q[m]);
+      return sum;
+    }
+
+    //! \brief The sum of q_lm * conj(p_lm) over all m (which is real).
+    inline double product(const std::complex<double>* q, const std::complex<double>* p, size_t l)
+    {
+      double sum = (q[0] * std::conj(p[0])).real();
+      for (size_t m(1); m <= l; ++m)
+	sum += 2 * (q[m] * std::conj(p[m])).real();
+      return sum;
+    }
+  }
+
   OPSHCrystal::OPSHCrystal(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     OPTicker(tmp,"SHCrystal"), rg(1.2), maxl(7),
     nblistID(std::numeric_limits<size_t>::max()),
-    count(0)
+    count(0),
+    _ticks(0),
+    _localL{4, 6},
+    _bondL(6),
+    _bondThreshold(0.7),
+    _minBonds(7),
+    _particleSamples(0),
+    _solidSum(0)
   {
     operator<<(XML);
   }
@@ -47,14 +86,36 @@ namespace dynamo {
     if (XML.hasAttribute("MaxL"))
       maxl = XML.getAttribute("MaxL").as<size_t>();
 
+    if (XML.hasAttribute("LocalL"))
+      {
+	std::vector<std::string> values;
+	boost::split(values, XML.getAttribute("LocalL").getValue(), boost::is_any_of(","));
+	_localL.clear();
+	for (const std::string& value : values)
+	  _localL.push_back(boost::lexical_cast<size_t>(boost::trim_copy(value)));
+      }
+
+    if (XML.hasAttribute("BondL"))
+      _bondL = XML.getAttribute("BondL").as<size_t>();
+
+    if (XML.hasAttribute("BondThreshold"))
+      _bondThreshold = XML.getAttribute("BondThreshold").as<double>();
+
+    if (XML.hasAttribute("MinBonds"))
+      _minBonds = XML.getAttribute("MinBonds").as<size_t>();
+
     rg *= Sim->units.unitLength();
 
+    //The bond order is calculated from the local coefficients
+    if (std::find(_localL.begin(), _localL.end(), _bondL) == _localL.end())
+      _localL.push_back(_bondL);
+    std::sort(_localL.begin(), _localL.end());
+    _localL.erase(std::unique(_localL.begin(), _localL.end()), _localL.end());
 
     dout << "Cut off radius of " 
 	 << rg / Sim->units.unitLength() << std::endl;
   }
 
-
   void 
   OPSHCrystal::initialise() 
   { 
@@ -76,31 +137,190 @@ namespace dynamo {
       M_throw() << "There is not a suitable neighbourlist for the cut-off radius selected."
 	"\nR_g = " << rg / Sim->units.unitLength();
 
-    globalcoeff.resize(maxl);
-    for (size_t l=0; l < maxl; ++l)
-      globalcoeff[l].resize(2*l+1,std::complex<double>(0,0));
+    //Evaluate the harmonics for every l required
+    const size_t harmonicsL = std::max(maxl, _localL.back() + 1);
+    _harmonics = SH(harmonicsL);
+    globalcoeff.assign(_harmonics.size(), std::complex<double>(0, 0));
+
+    _threeJ.resize(harmonicsL);
+    for (int l(0); l < int(harmonicsL); ++l)
+      for (int m1(-l); m1 <= l; ++m1)
+	for (int m2(-l); m2 <= l; ++m2)
+	  if (std::abs(m1 + m2) <= l)
+	    {
+	      const double value = magnet::math::wignerThreej(l, l, l, m1, m2, -(m1 + m2));
+	      if (value != 0)
+		_threeJ[l].push_back(ThreeJ{m1, m2, value});
+	    }
+
+    _localOffset.clear();
+    _localSize = 0;
+    for (size_t i(0); i < _localL.size(); ++i)
+      {
+	_localOffset.push_back(_localSize);
+	_localSize += _localL[i] + 1;
+	if (_localL[i] == _bondL)
+	  _bondLocal = i;
+      }
 
+    _qlm.assign(Sim->N() * _localSize, std::complex<double>(0, 0));
+    _neighbours.resize(Sim->N());
+    _localQSum.assign(_localL.size(), 0);
+    _averagedQSum.assign(_localL.size(), 0);
+    _averagedWSum.assign(_localL.size(), 0);
+
+    beginSweep(1);
+    sweepParticles(0, 0, Sim->N());
     ticker();
   }
 
+  bool
+  OPSHCrystal::beginSweep(size_t blocks)
+  {
+    _blocks.resize(blocks);
+    for (Block& block : _blocks)
+      {
+	block.bondSum.assign(_harmonics.size(), std::complex<double>(0, 0));
+	block.bonds = 0;
+	block.localQ.assign(_localL.size(), 0);
+	block.averagedQ.assign(_localL.size(), 0);
+	block.averagedW.assign(_localL.size(), 0);
+	block.particles = 0;
+	block.solid = 0;
+	block.Y.resize(_harmonics.size());
+	block.qsum.resize(_harmonics.size());
+      }
+    return true;
+  }
+
+  void
+  OPSHCrystal::sweepParticles(size_t blockID, size_t begin, size_t end)
+  {
+    Block& block = _blocks[blockID];
+    const GNeighbourList& nblist = static_cast<const GNeighbourList&>(*Sim->globals[nblistID]);
+    const double rg2 = rg * rg;
+
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const Particle& part = Sim->particles[ID];
+	std::vector<size_t>& neighbours = _neighbours[ID];
+	neighbours.clear();
+	std::fill(block.qsum.begin(), block.qsum.end(), std::complex<double>(0, 0));
+
+	block.candidates.clear();
+	nblist.getParticleNeighbours(part, block.candidates);
+	for (const size_t& id2 : block.candidates)
+	  {
+	    if (id2 == ID) continue;
+	    Vector rij = part.getPosition() - Sim->particles[id2].getPosition();
+	    Sim->BCs->applyBC(rij);
+	    const double r2 = rij.nrm2();
+	    if (r2 > rg2) continue;
+
+	    neighbours.push_back(id2);
+	    _harmonics(rij / std::sqrt(r2), block.Y.data());
+	    for (size_t i(0); i < block.Y.size(); ++i)
+	      block.qsum[i] += block.Y[i];
+	  }
+
+	for (size_t i(0); i < block.qsum.size(); ++i)
+	  block.bondSum[i] += block.qsum[i];
+	block.bonds += neighbours.size();
+
+	const double factor = neighbours.empty() ? 0.0 : 1.0 / neighbours.size();
+	std::complex<double>* q = &_qlm[ID * _localSize];
+	for (size_t i(0); i < _localL.size(); ++i)
+	  for (size_t m(0); m <= _localL[i]; ++m)
+	    q[_localOffset[i] + m] = block.qsum[SH::index(_localL[i], m)] * factor;
+      }
+  }
+
+  void
+  OPSHCrystal::analyseParticles(size_t blockID, size_t begin, size_t end)
+  {
+    Block& block = _blocks[blockID];
+    std::vector<std::complex<double> >& qbar = block.qsum;
+
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const std::vector<size_t>& neighbours = _neighbours[ID];
+	if (neighbours.empty()) continue;
+	++block.particles;
+
+	const std::complex<double>* q = &_qlm[ID * _localSize];
+	for (size_t i(0); i < _localL.size(); ++i)
+	  {
+	    const size_t l = _localL[i];
+	    const double prefactor = 4.0 * M_PI / (2.0 * l + 1.0);
+	    block.localQ[i] += std::sqrt(prefactor * normSquared(q + _localOffset[i], l));
+
+	    //The Lechner-Dellago average over the particle and its neighbours
+	    for (size_t m(0); m <= l; ++m)
+	      qbar[m] = q[_localOffset[i] + m];
+	    for (const size_t& id2 : neighbours)
+	      for (size_t m(0); m <= l; ++m)
+		qbar[m] += _qlm[id2 * _localSize + _localOffset[i] + m];
+
+	    const double norm2 = normSquared(qbar.data(), l);
+	    if (norm2 == 0) continue;
+	    block.averagedQ[i] += std::sqrt(prefactor * norm2) / (neighbours.size() + 1);
+
+	    double w = 0;
+	    for (const ThreeJ& symbol : _threeJ[l])
+	      w += symbol.value * (coefficient(qbar.data(), symbol.m1) * coefficient(qbar.data(), symbol.m2)
+				   * coefficient(qbar.data(), -(symbol.m1 + symbol.m2))).real();
+	    block.averagedW[i] += w / std::pow(norm2, 1.5);
+	  }
+
+	//Count the solid-like connections
+	const std::complex<double>* qb = q + _localOffset[_bondLocal];
+	const double norm = std::sqrt(normSquared(qb, _bondL));
+	if (norm == 0) continue;
+	size_t connections = 0;
+	for (const size_t& id2 : neighbours)
+	  {
+	    const std::complex<double>* qb2 = &_qlm[id2 * _localSize + _localOffset[_bondLocal]];
+	    const double norm2 = std::sqrt(normSquared(qb2, _bondL));
+	    if ((norm2 > 0) && (product(qb, qb2, _bondL) > _bondThreshold * norm * norm2))
+	      ++connections;
+	  }
+	if (connections >= _minBonds)
+	  ++block.solid;
+      }
+  }
+
   void 
   OPSHCrystal::ticker()
   {
-    sphericalsum ssum(Sim, rg, maxl);
-  
-    for (const Particle& part : Sim->particles)
+    //The second pass needs the local coefficients of all particles
+    //from the sweep, so it is carried out here.
+    const size_t N = Sim->N();
+    const size_t blocks = _blocks.size();
+    if (!Sim->threads || (blocks == 1))
+      for (size_t block(0); block < blocks; ++block)
+	analyseParticles(block, block * N / blocks, (block + 1) * N / blocks);
+    else
       {
-	std::unique_ptr<IDRange> ids(Sim->ptrScheduler->getParticleNeighbours(part));
-	for (const size_t& id1 : *ids)
-	  ssum(part, id1);
-      
-	for (size_t l(0); l < maxl; ++l)
-	  for (int m(-l); m <= static_cast<int>(l); ++m)
-	    globalcoeff[l][m+l] += ssum.coeffsum[l][m+l];
-      
-	count += ssum.count;
+	for (size_t block(0); block < blocks; ++block)
+	  Sim->threads->queueTask(std::bind(&OPSHCrystal::analyseParticles, this, block, block * N / blocks, (block + 1) * N / blocks));
+	Sim->threads->wait();
+      }
 
-	ssum.clear();
+    ++_ticks;
+    for (const Block& block : _blocks)
+      {
+	for (size_t i(0); i < globalcoeff.size(); ++i)
+	  globalcoeff[i] += block.bondSum[i];
+	count += block.bonds;
+
+	for (size_t i(0); i < _localL.size(); ++i)
+	  {
+	    _localQSum[i] += block.localQ[i];
+	    _averagedQSum[i] += block.averagedQ[i];
+	    _averagedWSum[i] += block.averagedW[i];
+	  }
+	_particleSamples += block.particles;
+	_solidSum += block.solid;
       }
   }
 
@@ -113,11 +333,10 @@ namespace dynamo {
       {
 	XML << magnet::xml::tag("Q")
 	    << magnet::xml::attr("l") << l;
-      
-	double Qsum(0);
-	for (int m(-l); m <= l; ++m)
-	  Qsum += std::norm(globalcoeff[l][m+l] / std::complex<double>(count, 0));
-      
+
+	const std::complex<double>* coeffs = &globalcoeff[SH::index(l, 0)];
+	const double Qsum = normSquared(coeffs, l) / (double(count) * count);
+
 	XML << magnet::xml::attr("val")
 	    << std::sqrt(Qsum * 4.0 * M_PI / (2.0 * l + 1.0))
 	    << magnet::xml::endtag("Q");
@@ -126,75 +345,32 @@ namespace dynamo {
 	    << magnet::xml::attr("l") << l;
 
 	std::complex<double> Wsum(0, 0);
-	for (int m1(-l); m1 <= l; ++m1)
-	  for (int m2(-l); m2 <= l; ++m2)
-	    {
-	      int m3 = -(m1+m2);
-	      if (std::abs(m3) <= l)
-		Wsum += std::complex<double>(magnet::math::wignerThreej(l,l,l,m1,m2,m3) 
-					     * std::pow(count,-3.0), 0)
-		  * globalcoeff[l][m1+l]
-		  * globalcoeff[l][m2+l]
-		  * globalcoeff[l][l-(m1+m2)]
-		  ;
-	    }
+	for (const ThreeJ& symbol : _threeJ[l])
+	  Wsum += std::complex<double>(symbol.value * std::pow(count, -3.0), 0)
+	    * coefficient(coeffs, symbol.m1)
+	    * coefficient(coeffs, symbol.m2)
+	    * coefficient(coeffs, -(symbol.m1 + symbol.m2));
       
 	XML << magnet::xml::attr("val")
 	    << Wsum * std::pow(Qsum, -1.5)
 	    << magnet::xml::endtag("W");
       }
 
-    XML << magnet::xml::endtag("SHCrystal");
-  }
-
-  OPSHCrystal::sphericalsum::sphericalsum
-  (const dynamo::Simulation * const nSim, const double& nrg, const size_t& nl):
-    Sim(nSim), rg(nrg), maxl(nl), count(0)
-  {
-    coeffsum.resize(maxl);
-    for (size_t l=0; l < maxl; ++l)
-      coeffsum[l].resize(2*l+1,std::complex<double>(0,0));
-  }
+    for (size_t i(0); i < _localL.size(); ++i)
+      XML << magnet::xml::tag("LocalOrder")
+	  << magnet::xml::attr("l") << _localL[i]
+	  << magnet::xml::attr("q") << _localQSum[i] / _particleSamples
+	  << magnet::xml::attr("AveragedQ") << _averagedQSum[i] / _particleSamples
+	  << magnet::xml::attr("AveragedW") << _averagedWSum[i] / _particleSamples
+	  << magnet::xml::endtag("LocalOrder");
 
-  void 
-  OPSHCrystal::sphericalsum::operator()
-    (const Particle& part, const size_t& ID) const
-  {
-    if (part.getID() == ID) return;
-    Vector rij = part.getPosition() - Sim->particles[ID].getPosition();
-    Sim->BCs->applyBC(rij);
-  
-    double norm = rij.nrm();
-    if (norm <= rg)
-      {
-	++count;
-	rij /= norm;
-	double theta = std::acos(rij[0]);
-	double sintheta = std::sin(theta);
-	double phi = rij[1] / sintheta;
-      
-	if (fabs(phi) > 1.0)
-	  phi = (phi > 0) ? 0.5 * M_PI : 1.5 * M_PI;
-	else
-	  phi = std::asin(phi);
+    XML << magnet::xml::tag("SolidParticles")
+	<< magnet::xml::attr("l") << _bondL
+	<< magnet::xml::attr("BondThreshold") << _bondThreshold
+	<< magnet::xml::attr("MinBonds") << _minBonds
+	<< magnet::xml::attr("Fraction") << double(_solidSum) / (double(_ticks) * Sim->N())
+	<< magnet::xml::endtag("SolidParticles");
 
-	if (std::sin(theta) == 0) phi = 0;
-      
-	if (phi < 0) phi += 2.0 * M_PI;
-
-	for (size_t l(0); l < maxl; ++l)
-	  for (int m(-l); m <= static_cast<int>(l); ++m)
-	    coeffsum[l][m+l] += boost::math::spherical_harmonic(l,m,theta,phi);
-      }
-  }
-
-  void
-  OPSHCrystal::sphericalsum::clear()
-  {
-    count = 0;
-
-    for (size_t l(0); l < maxl; ++l)
-      for (int m(-l); m <= static_cast<int>(l); ++m)
-	coeffsum[l][m+l] = std::complex<double>(0,0);
+    XML << magnet::xml::endtag("SHCrystal");
   }
 }
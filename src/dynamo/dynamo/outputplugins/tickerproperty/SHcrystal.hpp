@@ -17,11 +17,45 @@
 
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <magnet/math/spherical_harmonics.hpp>
 #include <vector>
 #include <complex>
 
 namespace dynamo {
   class Particle;
+
+  /*! \brief Measures the Steinhardt bond-orientational order
+      parameters.
+
+    Every pair of particles closer than the cut-off radius (CutOffR)
+    forms a bond. The spherical harmonics of the bond directions are
+    evaluated for all \f$l<\f$ MaxL at once using a
+    magnet::math::SphericalHarmonics, and the Wigner 3j symbols of
+    the \f$W_l\f$ invariants are tabulated when the plugin is
+    initialised.
+
+    Three sets of measurements are collected:
+
+    - The global \f$Q_l\f$ and \f$W_l\f$ of the average of all bonds
+      over all ticks, for all \f$l<\f$ MaxL.
+
+    - For each \f$l\f$ in the comma separated LocalL list (default
+      "4,6"), the mean over the particles of their local \f$q_l\f$,
+      and of the averaged \f$\bar{q}_l\f$ and \f$\bar{w}_l\f$ of
+      Lechner and Dellago (J. Chem. Phys. 129, 114707 (2008)), which
+      also average over the neighbours of each particle.
+
+    - The fraction of solid-like particles of ten Wolde, Ruiz-Montero
+      and Frenkel (J. Chem. Phys. 104, 9932 (1996)). Two bonded
+      particles are connected if the normalised product of their
+      \f$q_{lm}\f$ (for \f$l=\f$ BondL) exceeds BondThreshold, and a
+      particle is solid-like if it has at least MinBonds
+      connections.
+
+    The bonds and local \f$q_{lm}\f$ of each particle are calculated
+    in the particle sweep of the SysTicker, and the averaged and
+    bond measurements in a second parallel pass in ticker().
+   */
   class OPSHCrystal: public OPTicker
   {
   public:
@@ -32,37 +66,84 @@ namespace dynamo {
     virtual void stream(double) {}
 
     virtual void ticker();
+
+    virtual bool beginSweep(size_t blocks);
+
+    virtual void sweepParticles(size_t block, size_t begin, size_t end);
   
     virtual void output(magnet::xml::XmlStream&);
 
     virtual void operator<<(const magnet::xml::Node&);
 
   protected:
+    //! \brief Calculate the averaged and bond measurements of the particles with IDs in [begin, end).
+    void analyseParticles(size_t block, size_t begin, size_t end);
 
-    std::complex<double> localq(const Particle& part, int l, int m);
+    //! \brief A non-zero Wigner 3j symbol (l l l, m1 m2 -m1-m2).
+    struct ThreeJ
+    {
+      int m1;
+      int m2;
+      double value;
+    };
+
+    //! \brief The accumulators and work space of a block of particles.
+    struct Block
+    {
+      std::vector<std::complex<double> > bondSum;
+      size_t bonds;
+      std::vector<double> localQ;
+      std::vector<double> averagedQ;
+      std::vector<double> averagedW;
+      size_t particles;
+      size_t solid;
+
+      std::vector<size_t> candidates;
+      std::vector<std::complex<double> > Y;
+      std::vector<std::complex<double> > qsum;
+    };
 
     //! Cut-off radius 
     double rg;
     size_t maxl;
     size_t nblistID;
-    long count;
-  
-    std::vector<std::vector<std::complex<double> > > globalcoeff;
+    //! \brief The number of bonds sampled.
+    size_t count;
+    //! \brief The number of ticks sampled.
+    size_t _ticks;
 
-    struct sphericalsum
-    {
-      sphericalsum(const dynamo::Simulation * const, 
-		   const double&, const size_t&);
-    
-      void operator()(const Particle&, const size_t&) const;
-    
-      void clear();
-
-      const dynamo::Simulation* const Sim;
-      const double rg;
-      const size_t maxl;
-      mutable size_t count;
-      mutable std::vector<std::vector<std::complex<double> > > coeffsum;
-    };
+    //! \brief The sum of the harmonics of all bonds, indexed by SphericalHarmonics::index.
+    std::vector<std::complex<double> > globalcoeff;
+
+    magnet::math::SphericalHarmonics _harmonics;
+    //! \brief The non-zero Wigner 3j symbols of each l.
+    std::vector<std::vector<ThreeJ> > _threeJ;
+
+    //! \brief The l of the per-particle measurements.
+    std::vector<size_t> _localL;
+    //! \brief The offset of the coefficients of each local l in the per-particle data.
+    std::vector<size_t> _localOffset;
+    //! \brief The number of coefficients stored for each particle.
+    size_t _localSize;
+    //! \brief The index of the bond l in _localL.
+    size_t _bondLocal;
+    size_t _bondL;
+    double _bondThreshold;
+    size_t _minBonds;
+
+    //! \brief The local q_lm (m >= 0) of each particle for each local l.
+    std::vector<std::complex<double> > _qlm;
+    //! \brief The bonded neighbours of each particle.
+    std::vector<std::vector<size_t> > _neighbours;
+
+    std::vector<Block> _blocks;
+
+    //! \brief The running sums of the per-particle measurements, for each local l.
+    std::vector<double> _localQSum;
+    std::vector<double> _averagedQSum;
+    std::vector<double> _averagedWSum;
+    //! \brief The number of particles (with bonds) sampled.
+    size_t _particleSamples;
+    size_t _solidSum;
   };
 }
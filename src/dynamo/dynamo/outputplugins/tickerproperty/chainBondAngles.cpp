@@ -59,36 +59,73 @@ namespace dynamo {
 			       binwidth));
   }
 
-  void 
-  OPChainBondAngles::ticker()
+  bool
+  OPChainBondAngles::beginChainSweep(size_t blocks)
   {
-    for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
-      if (range->size() > 2)
+    if (_blockChains.size() != blocks)
+      {
+	_blockChains.clear();
+	_blockChains.resize(blocks);
+	for (std::list<Cdata>& blockData : _blockChains)
+	  for (const Cdata& dat : chains)
+	    blockData.push_back(Cdata(dat.chainID, Sim->topology[dat.chainID]->getMolecules().front()->size(), binwidth));
+	_blockBonds.resize(blocks);
+      }
+    return !chains.empty();
+  }
+
+  void
+  OPChainBondAngles::sweepChain(size_t block, const TChain& chain, size_t, const IDRange& range, const std::vector<Vector>& positions)
+  {
+    if (range.size() <= 2) return;
+
+    for (Cdata& dat : _blockChains[block])
+      if (dat.chainID == chain.getID())
 	{
-	  //Walk the polymer
-	  for (size_t j = 0; j < range->size()-2; ++j)
+	  //Each bond is normalised once, then correlated with all
+	  //the bonds further along the polymer
+	  std::vector<Vector>& bonds = _blockBonds[block];
+	  bonds.resize(range.size() - 1);
+	  for (size_t j = 0; j < bonds.size(); ++j)
 	    {
-	      Vector  bond1 = Sim->particles[(*range)[j+1]].getPosition()
-		- Sim->particles[(*range)[j]].getPosition();
-
-	      bond1 /= bond1.nrm();
-
-	      for (size_t i = j+2; i < range->size(); ++i)
-		{
-		  Vector  bond2 = Sim->particles[(*range)[i]].getPosition()
-		    -Sim->particles[(*range)[i-1]].getPosition();
-		
-		  bond2 /= bond2.nrm();
-		
-		  dat.BondCorrelations[i-j-2].addVal(bond1 | bond2);
-		  dat.BondCorrelationsAvg[i-j-2] += (bond1 | bond2);
-		  ++(dat.BondCorrelationsSamples[i-j-2]);
-		}
+	      bonds[j] = positions[j+1] - positions[j];
+	      bonds[j] /= bonds[j].nrm();
 	    }
+
+	  for (size_t j = 0; j < range.size()-2; ++j)
+	    for (size_t i = j+2; i < range.size(); ++i)
+	      {
+		const double correlation = bonds[j] | bonds[i-1];
+		dat.BondCorrelations[i-j-2].addVal(correlation);
+		dat.BondCorrelationsAvg[i-j-2] += correlation;
+		++(dat.BondCorrelationsSamples[i-j-2]);
+	      }
 	}
   }
 
+  void 
+  OPChainBondAngles::ticker()
+  {
+    //Reduce the blocks of the chain sweep in order
+    for (std::list<Cdata>& blockData : _blockChains)
+      {
+	std::list<Cdata>::iterator it = blockData.begin();
+	for (Cdata& dat : chains)
+	  {
+	    for (size_t i = 0; i < dat.BondCorrelations.size(); ++i)
+	      {
+		dat.BondCorrelations[i] += it->BondCorrelations[i];
+		dat.BondCorrelationsAvg[i] += it->BondCorrelationsAvg[i];
+		dat.BondCorrelationsSamples[i] += it->BondCorrelationsSamples[i];
+		it->BondCorrelations[i] = magnet::math::Histogram<>(binwidth);
+		it->BondCorrelationsAvg[i] = 0;
+		it->BondCorrelationsSamples[i] = 0;
+	      }
+	    ++it;
+	  }
+      }
+  }
+
   void 
   OPChainBondAngles::output(magnet::xml::XmlStream& XML)
   {
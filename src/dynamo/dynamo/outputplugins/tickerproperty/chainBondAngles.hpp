@@ -33,6 +33,10 @@ namespace dynamo {
 
     virtual void ticker();
 
+    virtual bool beginChainSweep(size_t);
+
+    virtual void sweepChain(size_t, const TChain&, size_t, const IDRange&, const std::vector<Vector>&);
+
     virtual void output(magnet::xml::XmlStream&);
 
     virtual void operator<<(const magnet::xml::Node&);
@@ -50,5 +54,10 @@ namespace dynamo {
 
     std::list<Cdata> chains;
     double binwidth;
+
+    //! \brief The accumulators of each block of the chain sweep.
+    std::vector<std::list<Cdata> > _blockChains;
+    //! \brief The unit bond vectors of the current molecule of each block.
+    std::vector<std::vector<Vector> > _blockBonds;
   };
 }
@@ -44,17 +44,49 @@ namespace dynamo {
 	chains.push_back(Cdata(plugPtr->getID(), plugPtr->getMolecules().front()->size()));
   }
 
+  bool
+  OPChainBondLength::beginChainSweep(size_t blocks)
+  {
+    if (_blockChains.size() != blocks)
+      {
+	_blockChains.clear();
+	_blockChains.resize(blocks);
+	for (std::list<Cdata>& blockData : _blockChains)
+	  for (const Cdata& dat : chains)
+	    blockData.push_back(Cdata(dat.chainID, Sim->topology[dat.chainID]->getMolecules().front()->size()));
+      }
+    return !chains.empty();
+  }
+
+  void
+  OPChainBondLength::sweepChain(size_t block, const TChain& chain, size_t, const IDRange& range, const std::vector<Vector>& positions)
+  {
+    if (range.size() <= 2) return;
+
+    for (Cdata& dat : _blockChains[block])
+      if (dat.chainID == chain.getID())
+	//Walk the polymer
+	for (size_t j = 0; j < range.size()-1; ++j)
+	  dat.BondLengths[j].addVal((positions[j+1] - positions[j]).nrm());
+  }
+
   void 
   OPChainBondLength::ticker()
   {
-    for (Cdata& dat : chains)
-      for (const shared_ptr<IDRange>& range : Sim->topology[dat.chainID]->getMolecules())
-      if (range->size() > 2)
-	//Walk the polymer
-	for (size_t j = 0; j < range->size()-1; ++j)
-	  dat.BondLengths[j].addVal
-	    ((Sim->particles[(*range)[j+1]].getPosition()
-	      - Sim->particles[(*range)[j]].getPosition()).nrm());
+    //Reduce the blocks of the chain sweep in order
+    for (std::list<Cdata>& blockData : _blockChains)
+      {
+	std::list<Cdata>::iterator it = blockData.begin();
+	for (Cdata& dat : chains)
+	  {
+	    for (size_t i = 0; i < dat.BondLengths.size(); ++i)
+	      {
+		dat.BondLengths[i] += it->BondLengths[i];
+		it->BondLengths[i] = magnet::math::Histogram<>(it->BondLengths[i].getBinWidth());
+	      }
+	    ++it;
+	  }
+      }
   }
 
   void 
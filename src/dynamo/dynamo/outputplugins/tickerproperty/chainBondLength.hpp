@@ -33,6 +33,10 @@ namespace dynamo {
 
     virtual void ticker();
 
+    virtual bool beginChainSweep(size_t);
+
+    virtual void sweepChain(size_t, const TChain&, size_t, const IDRange&, const std::vector<Vector>&);
+
     virtual void output(magnet::xml::XmlStream&);
   
   protected:
@@ -45,5 +49,8 @@ namespace dynamo {
     };
 
     std::list<Cdata> chains;
+
+    //! \brief The accumulators of each block of the chain sweep.
+    std::vector<std::list<Cdata> > _blockChains;
   };
 }
@@ -21,7 +21,11 @@
 #include <dynamo/simulation.hpp>
 #include <dynamo/topology/include.hpp>
 #include <dynamo/interactions/captures.hpp>
+#include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/BC/BC.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <limits>
 #include <vector>
 
 namespace dynamo {
@@ -34,9 +38,19 @@ namespace dynamo {
       array[i] = 0;
   }
 
-  OPCContactMap::OPCContactMap(const dynamo::Simulation* tmp, const magnet::xml::Node&):
-    OPTicker(tmp,"ContactMap")
-  {}
+  OPCContactMap::OPCContactMap(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
+    OPTicker(tmp,"ContactMap"),
+    _cutoff(0)
+  {
+    operator<<(XML);
+  }
+
+  void 
+  OPCContactMap::operator<<(const magnet::xml::Node& XML)
+  {
+    if (XML.hasAttribute("CutOff"))
+      _cutoff = XML.getAttribute("CutOff").as<double>() * Sim->units.unitLength();
+  }
 
   void 
   OPCContactMap::initialise()
@@ -44,6 +58,42 @@ namespace dynamo {
     for (const shared_ptr<Topology>& plugPtr : Sim->topology)
       if (std::dynamic_pointer_cast<TChain>(plugPtr))
 	chains.push_back(Cdata(static_cast<const TChain*>(plugPtr.get()), plugPtr->getMolecules().front()->size()));
+
+    _captures.clear();
+    for (const shared_ptr<Interaction>& ptr : Sim->interactions)
+      if (std::dynamic_pointer_cast<ICapture>(ptr))
+	_captures.push_back(static_cast<const ICapture*>(std::dynamic_pointer_cast<ICapture>(ptr).get()));
+
+    _moleculeOf.assign(Sim->N(), std::numeric_limits<size_t>::max());
+    _positionOf.assign(Sim->N(), 0);
+    size_t molecule(0);
+    for (const Cdata& dat : chains)
+      for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
+	{
+	  for (size_t i(0); i < range->size(); ++i)
+	    {
+	      _moleculeOf[(*range)[i]] = molecule;
+	      _positionOf[(*range)[i]] = i;
+	    }
+	  ++molecule;
+	}
+
+    if (_cutoff > Sim->getLongestInteraction())
+      M_throw() << "The ContactMap CutOff (" << _cutoff / Sim->units.unitLength() 
+		<< ") is longer than the longest interaction (" << Sim->getLongestInteraction() / Sim->units.unitLength()
+		<< "), so the neighbour list cannot be used to find the contacts";
+
+    _capturePairs.clear();
+  }
+
+  bool
+  OPCContactMap::isCapturePair(size_t ID1, size_t ID2)
+  {
+    const detail::PairKey key(ID1, ID2);
+    auto it = _capturePairs.find(key);
+    if (it == _capturePairs.end())
+      it = _capturePairs.insert(std::make_pair(key, bool(std::dynamic_pointer_cast<ICapture>(Sim->getInteraction(Sim->particles[ID1], Sim->particles[ID2]))))).first;
+    return it->second;
   }
 
   void 
@@ -66,25 +116,36 @@ namespace dynamo {
   void 
   OPCContactMap::ticker()
   {
+    size_t molecule(0);
     for (Cdata& dat : chains)
       for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
       {
 	dat.counter++;
 	for (unsigned long i = 0; i < dat.chainlength; i++)
 	  {
-	    const Particle& part1 = Sim->particles[(*range)[i]];
-	 
-	    for (unsigned long j = i+1; j < dat.chainlength; j++)
-	      {
-		const Particle& part2 = Sim->particles[(*range)[j]];
-
-		for (const shared_ptr<Interaction>& ptr : Sim->interactions)
-		  if (ptr->isInteraction(part1,part2))
-		    if (std::dynamic_pointer_cast<ICapture>(ptr))
-		      if (dynamic_cast<const ICapture*>(ptr.get())->isCaptured(part1,part2))
-			dat.array[i * dat.chainlength + j]++;
-	      }
+	    const size_t ID1 = (*range)[i];
+
+	    //The captured partners of the bead, which are only in the
+	    //capture map of the Interaction handling the pair
+	    for (const ICapture* capture : _captures)
+	      for (const size_t ID2 : capture->getPartners(ID1))
+		if ((_moleculeOf[ID2] == molecule) && (_positionOf[ID2] > i))
+		  dat.array[i * dat.chainlength + _positionOf[ID2]]++;
+
+	    if (_cutoff == 0) continue;
+
+	    const Particle& part1 = Sim->particles[ID1];
+	    std::unique_ptr<IDRange> ids(Sim->ptrScheduler->getParticleNeighbours(part1));
+	    for (const size_t ID2 : *ids)
+	      if ((_moleculeOf[ID2] == molecule) && (_positionOf[ID2] > i))
+		{
+		  Vector rij = part1.getPosition() - Sim->particles[ID2].getPosition();
+		  Sim->BCs->applyBC(rij);
+		  if ((rij.nrm2() < _cutoff * _cutoff) && !isCapturePair(ID1, ID2))
+		    dat.array[i * dat.chainlength + _positionOf[ID2]]++;
+		}
 	  }
+	++molecule;
       }
   }
 
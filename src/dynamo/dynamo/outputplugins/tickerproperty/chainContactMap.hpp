@@ -17,14 +17,31 @@
 
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <dynamo/interactions/captures.hpp>
 #include <magnet/math/histogram.hpp>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace dynamo {
   class TChain;
   class IDRange;
 
+  /*! \brief Collects the contact map of each chain Topology.
+
+    Two beads of a chain are in contact if they are captured by their
+    ICapture Interaction (e.g., within the well of a square well).
+    Rather than testing every pair of beads of a chain, the captured
+    partners of each bead are read from the capture maps of the
+    ICapture interactions, so the cost of each tick scales with the
+    number of contacts instead of the square of the chain length.
+
+    If a CutOff distance is given, the beads closer than this
+    distance are also counted as in contact if their Interaction is
+    not an ICapture. These pairs are found using the neighbour list
+    of the scheduler, and the CutOff cannot be longer than the
+    longest Interaction.
+   */
   class OPCContactMap: public OPTicker
   {
   public:
@@ -39,8 +56,12 @@ namespace dynamo {
     virtual void replicaExchange(OutputPlugin&);
 
     virtual void output(magnet::xml::XmlStream&);
+
+    virtual void operator<<(const magnet::xml::Node&);
   
   protected:
+    //! \brief Test if a pair of particles is handled by an ICapture Interaction.
+    bool isCapturePair(size_t, size_t);
 
     struct Cdata
     {
@@ -54,5 +75,16 @@ namespace dynamo {
 
     std::vector<Cdata> chains;
 
+    //! \brief The ICapture Interactions of the system.
+    std::vector<const ICapture*> _captures;
+    //! \brief The index of the chain molecule of each particle (or -1 if it is not in a chain).
+    std::vector<size_t> _moleculeOf;
+    //! \brief The position of each particle in its chain.
+    std::vector<size_t> _positionOf;
+    //! \brief The contact distance of the pairs without an ICapture Interaction (zero if disabled).
+    double _cutoff;
+    //! \brief A cache of isCapturePair() for the pairs found within the cut off.
+    std::unordered_map<detail::PairKey, bool> _capturePairs;
+
   };
 }
@@ -21,7 +21,6 @@
 #include <dynamo/simulation.hpp>
 #include <dynamo/topology/include.hpp>
 #include <dynamo/dynamics/dynamics.hpp>
-#include <dynamo/BC/None.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <vector>
 
@@ -37,10 +36,6 @@ namespace dynamo {
       if (std::dynamic_pointer_cast<TChain>(plugPtr))
 	chains.push_back(CTCdata(static_cast<const TChain*>(plugPtr.get()), 
 				 0.005, 0.005, 0.01));
-
-    if (!std::dynamic_pointer_cast<BCNone>(Sim->BCs))
-      M_throw() << "Can only use this plugin with Null BC's"
-		<< "\nPositions must be unwrapped";
   }
 
 //  void 
@@ -71,110 +66,118 @@ namespace dynamo {
 //      }
 //  }
 
-  void 
-  OPCTorsion::ticker()
+  bool
+  OPCTorsion::beginChainSweep(size_t)
   {
     for (CTCdata& dat : chains)
       {
-	double sysGamma  = 0.0;
-	long count = 0;
-	for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
-	  {
-	    if (range->size() < 3)//Need three for curv and torsion
-	      break;
+	//Need three for curv and torsion
+	if (!dat.chainPtr->getMoleculeCount() || (dat.chainPtr->getMolecules().front()->size() < 3))
+	  dat.molecules.clear();
+	else
+	  dat.molecules.resize(dat.chainPtr->getMoleculeCount());
+      }
+    return !chains.empty();
+  }
+
+  void
+  OPCTorsion::sweepChain(size_t, const TChain& chain, size_t molecule, const IDRange& range, const std::vector<Vector>& pos)
+  {
+    if (range.size() < 3) return;
 
 #ifdef DYNAMO_DEBUG
-	    if (NDIM != 3)
-	      M_throw() << "Not implemented chain curvature in non 3 dimensional systems";
+    if (NDIM != 3)
+      M_throw() << "Not implemented chain curvature in non 3 dimensional systems";
 #endif
+
+    CTCdata* dat = NULL;
+    for (CTCdata& data : chains)
+      if (data.chainPtr == &chain)
+	dat = &data;
+    if (!dat) return;
+
+    const size_t L = range.size();
+    std::vector<Vector> dr1;
+    std::vector<Vector> dr2;
+    std::vector<Vector> dr3;
+    std::vector<Vector> vec;
+
+    //Calc first and second derivatives
+    for (size_t k = 1; k < L - 1; ++k)
+      {
+	dr1.push_back(0.5 * (pos[k+1] - pos[k-1]));
+	dr2.push_back(pos[k+1] - (2.0 * pos[k]) + pos[k-1]);
+	vec.push_back(dr1.back() ^ dr2.back());
+      }
 	  
-	    Vector tmp;
-	    std::vector<Vector> dr1;
-	    std::vector<Vector> dr2;
-	    std::vector<Vector> dr3;
-	    std::vector<Vector> vec;
-
-	    //Calc first and second derivatives
-	    for (IDRange::iterator it = range->begin() + 1; it != range->end() - 1; it++)
-	      {
-		tmp = 0.5 * (Sim->particles[*(it+1)].getPosition()
-			     - Sim->particles[*(it-1)].getPosition());
-
-		dr1.push_back(tmp);
-	      
-		tmp = Sim->particles[*(it+1)].getPosition() 
-		  - (2.0 * Sim->particles[*it].getPosition())
-		  + Sim->particles[*(it-1)].getPosition();
-	      
-		dr2.push_back(tmp);
-	      
-		vec.push_back(dr1.back() ^ dr2.back());
-	      }
-	  
-	    //Create third derivative
-	    for (std::vector<Vector  >::iterator it2 = dr2.begin() + 1; it2 != dr2.end() - 1; it2++)
-	      dr3.push_back(0.5 * (*(it2+1) - *(it2-1)));
+    //Create third derivative
+    for (size_t k = 1; k + 1 < dr2.size(); ++k)
+      dr3.push_back(0.5 * (dr2[k+1] - dr2[k-1]));
 	  
-	    size_t derivsize = dr3.size();
-
-	    //Gamma Calc
-	    double gamma = 0.0;
-	    double fsum = 0.0;
-
-	    for (unsigned int i = 0; i < derivsize; i++)
-	      {
-		double torsion = ((vec[i+1]) | (dr3[i])) / (vec[i+1].nrm2()); //Torsion
-		double curvature = (vec[i+1].nrm()) / pow(dr1[i+1].nrm(), 3); //Curvature
-
-		double instGamma = torsion / curvature;
-		gamma += instGamma;
-
-		double helixradius = 1.0/(curvature * (1.0+instGamma*instGamma));
-
-		double minradius = std::numeric_limits<float>::infinity();
-
-		for (IDRange::iterator it1 = range->begin(); 
-		     it1 != range->end(); it1++)
-		  //Check this particle is not the same, or adjacent
-		  if (*it1 != *(range->begin()+2+i)
-		      && *it1 != *(range->begin()+1+i)
-		      && *it1 != *(range->begin()+3+i))
-		    for (IDRange::iterator it2 = range->begin() + 1; 
-			 it2 != range->end() - 1; it2++)
-		      //Check this particle is not the same, or adjacent to the studied particle
-		      if (*it1 != *it2
-			  && *it2 != *(range->begin()+2+i)
-			  && *it2 != *(range->begin()+1+i)
-			  && *it2 != *(range->begin()+3+i))
-			{
-			  //We have three points, calculate the lengths
-			  //of the triangle sides
-			  double a = (Sim->particles[*it1].getPosition() 
-				      - Sim->particles[*it2].getPosition()).nrm(),
-			    b = (Sim->particles[*(range->begin()+2+i)].getPosition() 
-				 - Sim->particles[*it2].getPosition()).nrm(),
-			    c = (Sim->particles[*it1].getPosition() 
-				 - Sim->particles[*(range->begin()+2+i)].getPosition()).nrm();
-
-			  //Now calc the area of the triangle
-			  double s = (a + b + c) / 2.0;
-			  double A = std::sqrt(s * (s - a) * (s - b) * (s - c));
-			  double R = a * b * c / (4.0 * A);
-			  if (R < minradius) minradius = R;			 
-			}
-		fsum += minradius / helixradius;
-	      }
-
-	    gamma /= derivsize;
-	    sysGamma += gamma;
-	    fsum /= derivsize;
+    size_t derivsize = dr3.size();
+
+    //Gamma Calc
+    double gamma = 0.0;
+    double fsum = 0.0;
+
+    for (size_t i = 0; i < derivsize; i++)
+      {
+	double torsion = ((vec[i+1]) | (dr3[i])) / (vec[i+1].nrm2()); //Torsion
+	double curvature = (vec[i+1].nrm()) / pow(dr1[i+1].nrm(), 3); //Curvature
+
+	double instGamma = torsion / curvature;
+	gamma += instGamma;
+
+	double helixradius = 1.0/(curvature * (1.0+instGamma*instGamma));
+
+	double minradius = std::numeric_limits<float>::infinity();
+
+	//The studied bead, which with its neighbours is excluded below
+	const size_t mid = i + 2;
+	for (size_t i1 = 0; i1 < L; ++i1)
+	  //Check this particle is not the same, or adjacent
+	  if ((i1 + 1 < mid) || (i1 > mid + 1))
+	    for (size_t i2 = 1; i2 < L - 1; ++i2)
+	      //Check this particle is not the same, or adjacent to the studied particle
+	      if ((i1 != i2) && ((i2 + 1 < mid) || (i2 > mid + 1)))
+		{
+		  //We have three points, calculate the lengths
+		  //of the triangle sides
+		  double a = (pos[i1] - pos[i2]).nrm(),
+		    b = (pos[mid] - pos[i2]).nrm(),
+		    c = (pos[i1] - pos[mid]).nrm();
+
+		  //Now calc the area of the triangle
+		  double s = (a + b + c) / 2.0;
+		  double A = std::sqrt(s * (s - a) * (s - b) * (s - c));
+		  double R = a * b * c / (4.0 * A);
+		  if (R < minradius) minradius = R;
+		}
+	fsum += minradius / helixradius;
+      }
+
+    gamma /= derivsize;
+    fsum /= derivsize;
+    dat->molecules[molecule] = std::make_pair(gamma, fsum);
+  }
 
+  void 
+  OPCTorsion::ticker()
+  {
+    for (CTCdata& dat : chains)
+      {
+	double sysGamma  = 0.0;
+	long count = 0;
+	for (const std::pair<double, double>& mol : dat.molecules)
+	  {
+	    const double gamma = mol.first;
+	    sysGamma += gamma;
 	    ++count;
 	    //Restrict the data collection to reasonable bounds
 	    if (gamma < 10 && gamma > -10)
 	      dat.gammaMol.addVal(gamma);
 
-	    dat.f.addVal(fsum);
+	    dat.f.addVal(mol.second);
 	  }
 
 	if (sysGamma < 10 && sysGamma > -10)
@@ -19,6 +19,7 @@
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
 #include <magnet/math/histogram.hpp>
 #include <list>
+#include <vector>
 
 namespace dynamo {
   class TChain;
@@ -34,6 +35,10 @@ namespace dynamo {
 
     virtual void ticker();
 
+    virtual bool beginChainSweep(size_t);
+
+    virtual void sweepChain(size_t, const TChain&, size_t, const IDRange&, const std::vector<Vector>&);
+
     virtual void output(magnet::xml::XmlStream&);
   
   protected:
@@ -44,6 +49,8 @@ namespace dynamo {
       magnet::math::Histogram<> gammaMol;
       magnet::math::Histogram<> gammaSys;
       magnet::math::Histogram<> f;
+      //! \brief The mean torsion and helix fraction of each molecule, from the chain sweep.
+      std::vector<std::pair<double, double> > molecules;
       CTCdata(const TChain* ptr, double binwidth1, double binwidth2, double binwidth3):
 	chainPtr(ptr), gammaMol(binwidth1),
 	gammaSys(binwidth2), f(binwidth3)
@@ -30,6 +30,7 @@
 #include <dynamo/outputplugins/tickerproperty/structureImage.hpp>
 #include <dynamo/outputplugins/tickerproperty/SHcrystal.hpp>
 #include <dynamo/outputplugins/tickerproperty/SCparameter.hpp>
+#include <dynamo/outputplugins/tickerproperty/structureFactor.hpp>
 #include <dynamo/outputplugins/tickerproperty/msdOrientationalCorrelator.hpp>
 #include <dynamo/outputplugins/tickerproperty/OrientationalOrder.hpp>
 #include <dynamo/outputplugins/tickerproperty/vacf.hpp>
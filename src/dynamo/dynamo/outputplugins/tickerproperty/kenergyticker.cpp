@@ -39,27 +39,42 @@ namespace dynamo {
 	sum[iDim][jDim] = 0.0;
   }
 
+  bool
+  OPKEnergyTicker::beginSweep(size_t blocks)
+  {
+    matrix zero;
+    for (size_t iDim = 0; iDim < NDIM; ++iDim)
+      for (size_t jDim = 0; jDim < NDIM; ++jDim)
+	zero[iDim][jDim] = 0.0;
+
+    _blockE.assign(blocks, zero);
+    return true;
+  }
+
+  void
+  OPKEnergyTicker::sweepParticles(size_t block, size_t begin, size_t end)
+  {
+    matrix& localE = _blockE[block];
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const Particle& part = Sim->particles[ID];
+	const double mass = Sim->species(part)->getMass(ID);
+	for (size_t iDim = 0; iDim < NDIM; ++iDim)
+	  for (size_t jDim = 0; jDim < NDIM; ++jDim)
+	    localE[iDim][jDim] += part.getVelocity()[iDim] * part.getVelocity()[jDim] * mass;
+      }
+  }
+
   void 
   OPKEnergyTicker::ticker()
   {
     ++count;
 
-    matrix localE;
-
-    for (size_t iDim = 0; iDim < NDIM; ++iDim)
-      for (size_t jDim = 0; jDim < NDIM; ++jDim)
-	localE[iDim][jDim] = 0.0;
-
-    for (const Particle& part : Sim->particles)
+    //Try and stop round off error by summing each block separately
+    for (const matrix& localE : _blockE)
       for (size_t iDim = 0; iDim < NDIM; ++iDim)
 	for (size_t jDim = 0; jDim < NDIM; ++jDim)
-	  localE[iDim][jDim] += part.getVelocity()[iDim] * part.getVelocity()[jDim]
-	    * Sim->species(part)->getMass(part.getID());
-
-    //Try and stop round off error this way
-    for (size_t iDim = 0; iDim < NDIM; ++iDim)
-      for (size_t jDim = 0; jDim < NDIM; ++jDim)
-	sum[iDim][jDim] += localE[iDim][jDim];
+	  sum[iDim][jDim] += localE[iDim][jDim];
   }
 
   void
@@ -21,6 +21,7 @@
 #include <magnet/math/histogram.hpp>
 #include <magnet/math/vector.hpp>
 #include <array>
+#include <vector>
 
 namespace dynamo {
   class OPKEnergyTicker: public OPTicker
@@ -36,6 +37,10 @@ namespace dynamo {
     virtual void stream(double) {}
 
     virtual void ticker();
+
+    virtual bool beginSweep(size_t blocks);
+
+    virtual void sweepParticles(size_t block, size_t begin, size_t end);
   
     virtual void output(magnet::xml::XmlStream&);
 
@@ -46,5 +51,7 @@ namespace dynamo {
   protected:
     size_t count;
     matrix sum;
+    //! \brief The kinetic energy tensor of each block of the particle sweep.
+    std::vector<matrix> _blockE;
   };
 }
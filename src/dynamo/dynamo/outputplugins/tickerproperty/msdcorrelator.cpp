@@ -30,7 +30,8 @@ namespace dynamo {
     length(20),
     currCorrLength(0),
     ticksTaken(0),
-    notReady(true)
+    notReady(true),
+    _accumulating(false)
   {
     operator<<(XML);
   }
@@ -56,12 +57,39 @@ namespace dynamo {
     structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
   }
 
+  bool
+  OPMSDCorrelator::beginSweep(size_t blocks)
+  {
+    //The correlator is accumulated once the history is full
+    _accumulating = !notReady || (currCorrLength + 1 == length);
+    _blockSpeciesData.resize(blocks);
+    for (std::vector<double>& data : _blockSpeciesData)
+      data.assign(Sim->species.size() * length, 0.0);
+    return true;
+  }
+
+  void
+  OPMSDCorrelator::sweepParticles(size_t block, size_t begin, size_t end)
+  {
+    for (size_t ID(begin); ID < end; ++ID)
+      posHistory[ID].push_front(Sim->particles[ID].getPosition());
+
+    if (!_accumulating) return;
+
+    std::vector<double>& data = _blockSpeciesData[block];
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const size_t offset = Sim->species(Sim->particles[ID])->getID() * length;
+	const boost::circular_buffer<Vector>& history = posHistory[ID];
+	for (size_t step(1); step < length; ++step)
+	  data[offset + step] += (history[step] - history[0]).nrm2();
+      }
+  }
+
   void 
   OPMSDCorrelator::ticker()
   {
-    for (const Particle& part : Sim->particles)
-      posHistory[part.getID()].push_front(part.getPosition());
-  
+    //The position history is updated in the particle sweep
     if (notReady)
       {
 	if (++currCorrLength != length)
@@ -78,10 +106,10 @@ namespace dynamo {
   {
     ++ticksTaken;
   
-    for (const shared_ptr<Species>& sp : Sim->species)
-      for (const size_t& ID : *sp->getRange())
-      for (size_t step(1); step < length; ++step)
-	speciesData[sp->getID()][step] += (posHistory[ID][step] - posHistory[ID][0]).nrm2();
+    for (const std::vector<double>& data : _blockSpeciesData)
+      for (const shared_ptr<Species>& sp : Sim->species)
+	for (size_t step(1); step < length; ++step)
+	  speciesData[sp->getID()][step] += data[sp->getID() * length + step];
   
     for (const shared_ptr<Topology>& topo : Sim->topology)
       for (const shared_ptr<IDRange>& range : topo->getMolecules())
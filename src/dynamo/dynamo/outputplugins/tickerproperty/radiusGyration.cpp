@@ -84,43 +84,34 @@ namespace dynamo {
   }
 
   OPRGyration::molGyrationDat
-  OPRGyration::getGyrationEigenSystem(const shared_ptr<IDRange>& range, const dynamo::Simulation* Sim)
+  OPRGyration::getGyrationEigenSystem(const IDRange& range, const std::vector<Vector>& positions, const dynamo::Simulation* Sim)
   {
-    //Determine the centre of mass. Watch for periodic images
-    Vector  tmpVec;  
-  
     molGyrationDat retVal;
     retVal.MassCentre = Vector{0,0,0};
 
-    double totmass = Sim->species(Sim->particles[*(range->begin())])->getMass(*(range->begin()));
-    //Walk along the chain
-    Vector origin_position = Vector{0,0,0};
+    //The first bead is at the origin
+    double totmass = Sim->species(Sim->particles[range[0]])->getMass(range[0]);
     Matrix inertiaTensor;
     
-    for (IDRange::iterator iPtr = range->begin()+1; iPtr != range->end(); iPtr++)
+    for (size_t i(1); i < range.size(); ++i)
       {
-	Vector currRelPos = Sim->particles[*iPtr].getPosition() - Sim->particles[*(iPtr - 1)].getPosition();
-	Sim->BCs->applyBC(currRelPos);
+	const Vector& pos = positions[i];
+	const double mass = Sim->species(Sim->particles[range[i]])->getMass(range[i]);
 
-	const Vector unfolded_pos = currRelPos + origin_position;
-
-	const double mass = Sim->species(Sim->particles[*iPtr])->getMass(*iPtr);
-
-	retVal.MassCentre += origin_position * mass;
-	inertiaTensor += mass * ((unfolded_pos * unfolded_pos) * Matrix::identity() - Dyadic(unfolded_pos, unfolded_pos));
+	retVal.MassCentre += pos * mass;
+	inertiaTensor += mass * ((pos * pos) * Matrix::identity() - Dyadic(pos, pos));
 	totmass += mass;
-	origin_position = unfolded_pos;
       }
 
     retVal.MassCentre /= totmass;
-    retVal.MassCentre += Sim->particles[*(range->begin())].getPosition();
+    retVal.MassCentre += Sim->particles[range[0]].getPosition();
     
     std::pair<std::array<Vector, 3>, std::array<double, 3> > result
       = magnet::math::symmetric_eigen_decomposition(inertiaTensor / totmass);
 
     for (size_t i = 0; i < NDIM; i++)
       {	
-	retVal.EigenVal[i] = result.second[i] / range->size();
+	retVal.EigenVal[i] = result.second[i] / range.size();
 
 	//EigenVec Components
 	for (size_t j = 0; j < NDIM; j++)
@@ -156,6 +147,22 @@ namespace dynamo {
     return Vector{result.second[0], result.second[1], result.second[2]};
   }
 
+  bool
+  OPRGyration::beginChainSweep(size_t)
+  {
+    for (CTCdata& dat : chains)
+      dat.molecules.resize(dat.chainPtr->getMoleculeCount());
+    return !chains.empty();
+  }
+
+  void
+  OPRGyration::sweepChain(size_t, const TChain& chain, size_t molecule, const IDRange& range, const std::vector<Vector>& positions)
+  {
+    for (CTCdata& dat : chains)
+      if (dat.chainPtr == &chain)
+	dat.molecules[molecule] = getGyrationEigenSystem(range, positions, Sim);
+  }
+
   void 
   OPRGyration::ticker()
   {
@@ -163,9 +170,8 @@ namespace dynamo {
       {
 	std::list<Vector  > molAxis;
 
-	for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
+	for (const molGyrationDat& vals : dat.molecules)
 	  {
-	    molGyrationDat vals = getGyrationEigenSystem(range, Sim);	  
 	    //Take the largest eigenvector as the molecular axis
 	    molAxis.push_back(vals.EigenVec[NDIM-1]);
 	    //Now add the radius of gyration
@@ -200,8 +206,12 @@ namespace dynamo {
 
 	std::list<Vector  > molAxis;
 
+	std::vector<Vector> positions;
 	for (const shared_ptr<IDRange>& range : dat.chainPtr->getMolecules())
-	  molAxis.push_back(getGyrationEigenSystem(range, Sim).EigenVec[NDIM-1]);
+	  {
+	    dat.chainPtr->unwrapMolecule(*range, positions);
+	    molAxis.push_back(getGyrationEigenSystem(*range, positions, Sim).EigenVec[NDIM-1]);
+	  }
 
 	Vector  EigenVal = NematicOrderParameter(molAxis);
             
@@ -21,11 +21,11 @@
 #include <magnet/math/histogram.hpp>
 #include <magnet/math/vector.hpp>
 #include <list>
-
-class IDRange;
+#include <vector>
 
 namespace dynamo {
   class TChain;
+  class IDRange;
 
   class OPRGyration: public OPTicker
   {
@@ -38,6 +38,10 @@ namespace dynamo {
 
     virtual void ticker();
 
+    virtual bool beginChainSweep(size_t);
+
+    virtual void sweepChain(size_t, const TChain&, size_t, const IDRange&, const std::vector<Vector>&);
+
     virtual void replicaExchange(OutputPlugin&);
 
     virtual void output(magnet::xml::XmlStream&);
@@ -49,7 +53,10 @@ namespace dynamo {
       Vector  MassCentre;
     };
   
-    static molGyrationDat getGyrationEigenSystem(const shared_ptr<IDRange>&, const dynamo::Simulation*);
+    /*! \brief Calculate the gyration tensor of a molecule from its
+        unwrapped positions (see TChain::unwrapMolecule).
+     */
+    static molGyrationDat getGyrationEigenSystem(const IDRange&, const std::vector<Vector>&, const dynamo::Simulation*);
 
     static Vector  NematicOrderParameter(const std::list<Vector  >&);
 
@@ -62,6 +69,8 @@ namespace dynamo {
       const TChain* chainPtr;
       std::vector<magnet::math::Histogram<> > gyrationRadii;
       std::vector<magnet::math::Histogram<> > nematicOrder;
+      //! \brief The results of the chain sweep for each molecule.
+      std::vector<molGyrationDat> molecules;
 
       CTCdata(const TChain* ptr, double binWidthGyration, double binWidthNematic):
 	chainPtr(ptr)
@@ -0,0 +1,464 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/outputplugins/tickerproperty/structureFactor.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/units/units.hpp>
+#include <dynamo/BC/BC.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+namespace dynamo {
+  namespace {
+    //! \brief The Fourier transform of the cloud-in-cell assignment along one dimension.
+    inline double assignmentWindow(int n, size_t gridSize)
+    {
+      if (!n) return 1;
+      const double arg = M_PI * n / gridSize;
+      const double sinc = std::sin(arg) / arg;
+      return sinc * sinc;
+    }
+
+    inline size_t wrap(long i, size_t n)
+    {
+      const long r = i % long(n);
+      return (r < 0) ? r + n : r;
+    }
+  }
+
+  OPStructureFactor::OPStructureFactor(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
+    OPTicker(tmp,"StructureFactor"),
+    _maxK(20),
+    _method(AUTO),
+    _hasDirection(false),
+    _direction{{1, 1, 1}},
+    _gridSize(0),
+    _ticks(0)
+  {
+    operator<<(XML);
+  }
+
+  void 
+  OPStructureFactor::operator<<(const magnet::xml::Node& XML)
+  {
+    if (XML.hasAttribute("MaxK"))
+      _maxK = XML.getAttribute("MaxK").as<size_t>();
+
+    if (XML.hasAttribute("Method"))
+      {
+	const std::string method = XML.getAttribute("Method").getValue();
+	if (method == "Auto")
+	  _method = AUTO;
+	else if (method == "Recurrence")
+	  _method = RECURRENCE;
+	else if (method == "FFT")
+	  _method = FFT;
+	else
+	  M_throw() << "Unknown structure factor Method \"" << method 
+		    << "\", must be Auto, Recurrence or FFT";
+      }
+
+    if (XML.hasAttribute("Direction"))
+      {
+	const std::vector<std::string> values = splitList(XML.getAttribute("Direction").getValue());
+	if (values.size() != 3)
+	  M_throw() << "The Direction of the structure factor must be three integers";
+
+	for (size_t iDim(0); iDim < 3; ++iDim)
+	  _direction[iDim] = boost::lexical_cast<int>(values[iDim]);
+
+	if (!_direction[0] && !_direction[1] && !_direction[2])
+	  M_throw() << "The Direction of the structure factor cannot be zero";
+
+	_hasDirection = true;
+      }
+
+    if (XML.hasAttribute("GridSize"))
+      _gridSize = XML.getAttribute("GridSize").as<size_t>();
+
+    if (!_maxK)
+      M_throw() << "MaxK must be at least 1";
+  }
+
+  void
+  OPStructureFactor::buildWaveVectors()
+  {
+    _waveVectors.clear();
+    _runs.clear();
+    _bin.clear();
+    _binK.clear();
+    _binCount.clear();
+
+    const Vector& L = Sim->primaryCellSize;
+    const double Lmax = std::max(L[0], std::max(L[1], L[2]));
+    const double dk = 2 * M_PI / Lmax;
+
+    if (_hasDirection)
+      {
+	for (size_t m(1); m <= _maxK; ++m)
+	  {
+	    std::array<int, 3> n;
+	    for (size_t iDim(0); iDim < 3; ++iDim)
+	      n[iDim] = m * _direction[iDim];
+	    
+	    _waveVectors.push_back(n);
+	    _bin.push_back(m - 1);
+	    _binK.push_back(2 * M_PI * Vector{n[0] / L[0], n[1] / L[1], n[2] / L[2]}.nrm());
+	    _binCount.push_back(1);
+	  }
+
+	for (size_t iDim(0); iDim < 3; ++iDim)
+	  _maxN[iDim] = _maxK * std::abs(_direction[iDim]);
+	return;
+      }
+
+    for (size_t iDim(0); iDim < 3; ++iDim)
+      _maxN[iDim] = int(_maxK * L[iDim] / Lmax + 1e-8);
+
+    _binCount.assign(_maxK, 0);
+    for (size_t b(1); b <= _maxK; ++b)
+      _binK.push_back(b * dk);
+
+    //Only one of each +k/-k pair is sampled. The wave vectors with
+    //the same nx and ny form a run of consecutive nz.
+    for (int nx(-_maxN[0]); nx <= _maxN[0]; ++nx)
+      for (int ny(-_maxN[1]); ny <= _maxN[1]; ++ny)
+	{
+	  Run run{nx, ny, 0, _waveVectors.size(), _waveVectors.size()};
+	  for (int nz((ny > 0) || ((ny == 0) && (nx > 0)) ? 0 : 1); nz <= _maxN[2]; ++nz)
+	    {
+	      const double k = 2 * M_PI * Vector{nx / L[0], ny / L[1], nz / L[2]}.nrm();
+	      const size_t bin = lrint(k / dk);
+	      if ((k > _maxK * dk * (1 + 1e-8)) || !bin)
+		continue;
+
+	      if (run.begin == run.end)
+		run.nz = nz;
+
+	      _waveVectors.push_back(std::array<int, 3>{{nx, ny, nz}});
+	      _bin.push_back(bin - 1);
+	      ++_binCount[bin - 1];
+	      ++run.end;
+	    }
+
+	  if (run.begin != run.end)
+	    _runs.push_back(run);
+	}
+  }
+
+  void 
+  OPStructureFactor::initialise() 
+  {
+    buildWaveVectors();
+
+    const size_t maxN = *std::max_element(_maxN.begin(), _maxN.end());
+    if (!_gridSize)
+      {
+	_gridSize = 8;
+	while (_gridSize < 4 * maxN)
+	  _gridSize *= 2;
+      }
+
+    if (_method == AUTO)
+      {
+	//Estimates of the complex multiplications per tick
+	const double M3 = std::pow(double(_gridSize), 3);
+	const size_t blocks = Sim->threads ? std::max(size_t(1), 4 * Sim->threads->getThreadCount()) : 1;
+	const double recurrenceCost = double(Sim->N()) * _waveVectors.size();
+	const double fftCost = M3 * (1.5 * std::log2(double(_gridSize)) * 3 + blocks) + 8.0 * Sim->N();
+	_method = (fftCost < recurrenceCost) ? FFT : RECURRENCE;
+      }
+
+    if (_method == FFT)
+      {
+	if (2 * maxN >= _gridSize)
+	  M_throw() << "The GridSize (" << _gridSize 
+		    << ") must be more than twice the largest wave vector index (" << maxN << ")";
+
+	_fft = magnet::math::FFT(_gridSize);
+	_mesh.resize(_gridSize * _gridSize * _gridSize);
+      }
+
+    _ticks = 0;
+    _SSum.assign(_binK.size(), 0);
+    _amplitudeSum.assign(_binK.size(), 0);
+
+    dout << "Sampling " << _waveVectors.size() << " wave vectors in " 
+	 << _binK.size() << " bins" << std::endl;
+    if (_method == FFT)
+      dout << "Using the FFT method on a " << _gridSize << "^3 mesh" << std::endl;
+    else
+      dout << "Using the recurrence method" << std::endl;
+
+    beginSweep(1);
+    sweepParticles(0, 0, Sim->N());
+    ticker();
+  }
+
+  bool
+  OPStructureFactor::beginSweep(size_t blocks)
+  {
+    if (_method == FFT)
+      {
+	_blockMesh.resize(blocks);
+	for (std::vector<double>& mesh : _blockMesh)
+	  mesh.assign(_mesh.size(), 0);
+      }
+    else
+      {
+	_blockRho.resize(blocks);
+	for (std::vector<std::complex<double> >& rho : _blockRho)
+	  rho.assign(_waveVectors.size(), std::complex<double>(0, 0));
+      }
+    return true;
+  }
+
+  void
+  OPStructureFactor::sweepParticles(size_t block, size_t begin, size_t end)
+  {
+    if (_method == FFT)
+      sweepMesh(block, begin, end);
+    else if (_hasDirection)
+      sweepDirection(block, begin, end);
+    else
+      sweepRecurrence(block, begin, end);
+  }
+
+  void
+  OPStructureFactor::sweepRecurrence(size_t block, size_t begin, size_t end)
+  {
+    std::vector<std::complex<double> >& rho = _blockRho[block];
+    const Vector& L = Sim->primaryCellSize;
+
+    //The factors exp(i 2 pi n x / L) for n in [-maxN, maxN]
+    std::array<std::vector<std::complex<double> >, 3> factors;
+    for (size_t iDim(0); iDim < 3; ++iDim)
+      factors[iDim].resize(2 * _maxN[iDim] + 1);
+
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const Vector& pos = Sim->particles[ID].getPosition();
+	for (size_t iDim(0); iDim < 3; ++iDim)
+	  {
+	    std::complex<double>* e = factors[iDim].data() + _maxN[iDim];
+	    const std::complex<double> phase = std::polar(1.0, 2 * M_PI * pos[iDim] / L[iDim]);
+	    e[0] = 1;
+	    for (int n(1); n <= _maxN[iDim]; ++n)
+	      {
+		e[n] = e[n - 1] * phase;
+		e[-n] = std::conj(e[n]);
+	      }
+	  }
+
+	for (const Run& run : _runs)
+	  {
+	    const std::complex<double> exy = factors[0][run.nx + _maxN[0]] * factors[1][run.ny + _maxN[1]];
+	    const std::complex<double>* ez = factors[2].data() + _maxN[2] + run.nz;
+	    for (size_t i(run.begin); i < run.end; ++i)
+	      rho[i] += exy * ez[i - run.begin];
+	  }
+      }
+  }
+
+  void
+  OPStructureFactor::sweepDirection(size_t block, size_t begin, size_t end)
+  {
+    std::vector<std::complex<double> >& rho = _blockRho[block];
+    const Vector& L = Sim->primaryCellSize;
+
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const Vector& pos = Sim->particles[ID].getPosition();
+	double arg(0);
+	for (size_t iDim(0); iDim < 3; ++iDim)
+	  arg += _direction[iDim] * pos[iDim] / L[iDim];
+
+	const std::complex<double> phase = std::polar(1.0, 2 * M_PI * arg);
+	std::complex<double> e = phase;
+	for (std::complex<double>& val : rho)
+	  {
+	    val += e;
+	    e *= phase;
+	  }
+      }
+  }
+
+  size_t
+  OPStructureFactor::meshIndex(int nx, int ny, int nz) const
+  {
+    return (wrap(nx, _gridSize) * _gridSize + wrap(ny, _gridSize)) * _gridSize + wrap(nz, _gridSize);
+  }
+
+  void
+  OPStructureFactor::sweepMesh(size_t block, size_t begin, size_t end)
+  {
+    std::vector<double>& mesh = _blockMesh[block];
+    const Vector& L = Sim->primaryCellSize;
+
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	Vector pos = Sim->particles[ID].getPosition();
+	Sim->BCs->applyBC(pos);
+
+	//Cloud-in-cell assignment to the eight surrounding mesh points
+	std::array<long, 3> cell;
+	std::array<double, 3> frac;
+	for (size_t iDim(0); iDim < 3; ++iDim)
+	  {
+	    const double u = (pos[iDim] / L[iDim] + 0.5) * _gridSize;
+	    cell[iDim] = std::floor(u);
+	    frac[iDim] = u - cell[iDim];
+	  }
+
+	for (int dx(0); dx < 2; ++dx)
+	  for (int dy(0); dy < 2; ++dy)
+	    {
+	      const double wxy = (dx ? frac[0] : 1 - frac[0]) * (dy ? frac[1] : 1 - frac[1]);
+	      mesh[meshIndex(cell[0] + dx, cell[1] + dy, cell[2])] += wxy * (1 - frac[2]);
+	      mesh[meshIndex(cell[0] + dx, cell[1] + dy, cell[2] + 1)] += wxy * frac[2];
+	    }
+      }
+  }
+
+  void
+  OPStructureFactor::reduceMesh(size_t begin, size_t end)
+  {
+    const size_t plane = _gridSize * _gridSize;
+    for (size_t i(begin * plane); i < end * plane; ++i)
+      {
+	double sum(0);
+	for (const std::vector<double>& mesh : _blockMesh)
+	  sum += mesh[i];
+	_mesh[i] = sum;
+      }
+  }
+
+  void
+  OPStructureFactor::transformLines(size_t dim, size_t begin, size_t end)
+  {
+    const size_t M = _gridSize;
+    const std::array<size_t, 3> stride{{M * M, M, 1}};
+    const size_t other1 = (dim == 0) ? 1 : 0;
+    const size_t other2 = (dim == 2) ? 1 : 2;
+
+    for (size_t a(begin); a < end; ++a)
+      for (size_t b(0); b < M; ++b)
+	_fft(_mesh.data() + a * stride[other1] + b * stride[other2], stride[dim]);
+  }
+
+  void
+  OPStructureFactor::transformMesh()
+  {
+    const size_t M = _gridSize;
+    const size_t tasks = Sim->threads ? std::max(size_t(1), std::min(M, 4 * Sim->threads->getThreadCount())) : 1;
+
+    if (tasks == 1)
+      {
+	reduceMesh(0, M);
+	for (size_t dim(0); dim < 3; ++dim)
+	  transformLines(dim, 0, M);
+	return;
+      }
+
+    for (size_t task(0); task < tasks; ++task)
+      Sim->threads->queueTask(std::bind(&OPStructureFactor::reduceMesh, this, task * M / tasks, (task + 1) * M / tasks));
+    Sim->threads->wait();
+
+    for (size_t dim(0); dim < 3; ++dim)
+      {
+	for (size_t task(0); task < tasks; ++task)
+	  Sim->threads->queueTask(std::bind(&OPStructureFactor::transformLines, this, dim, task * M / tasks, (task + 1) * M / tasks));
+	Sim->threads->wait();
+      }
+  }
+
+  void 
+  OPStructureFactor::ticker()
+  {
+    std::vector<std::complex<double> > rho(_waveVectors.size(), std::complex<double>(0, 0));
+
+    if (_method == FFT)
+      {
+	transformMesh();
+	for (size_t i(0); i < _waveVectors.size(); ++i)
+	  {
+	    const std::array<int, 3>& n = _waveVectors[i];
+	    double window(1);
+	    for (size_t iDim(0); iDim < 3; ++iDim)
+	      window *= assignmentWindow(n[iDim], _gridSize);
+	    rho[i] = _mesh[meshIndex(n[0], n[1], n[2])] / window;
+	  }
+      }
+    else
+      for (const std::vector<std::complex<double> >& blockRho : _blockRho)
+	for (size_t i(0); i < rho.size(); ++i)
+	  rho[i] += blockRho[i];
+
+    accumulate(rho);
+  }
+
+  void
+  OPStructureFactor::accumulate(const std::vector<std::complex<double> >& rho)
+  {
+    ++_ticks;
+    const double N = Sim->N();
+    for (size_t i(0); i < rho.size(); ++i)
+      {
+	_SSum[_bin[i]] += std::norm(rho[i]) / N;
+	_amplitudeSum[_bin[i]] += std::abs(rho[i]) / N;
+      }
+  }
+
+  void 
+  OPStructureFactor::output(magnet::xml::XmlStream& XML)
+  {
+    XML << magnet::xml::tag("StructureFactor")
+	<< magnet::xml::attr("Method") << ((_method == FFT) ? "FFT" : "Recurrence");
+
+    if (_method == FFT)
+      XML << magnet::xml::attr("GridSize") << _gridSize;
+
+    XML << magnet::xml::attr("Ticks") << _ticks
+	<< magnet::xml::attr("WaveVectors") << _waveVectors.size();
+
+    for (size_t b(0); b < _binK.size(); ++b)
+      {
+	if (!_binCount[b]) continue;
+
+	const double samples = double(_ticks) * _binCount[b];
+	XML << magnet::xml::tag(_hasDirection ? "Point" : "Shell");
+
+	if (_hasDirection)
+	  XML << magnet::xml::attr("m") << b + 1;
+	else
+	  XML << magnet::xml::attr("Vectors") << _binCount[b];
+
+	XML << magnet::xml::attr("k") << _binK[b] * Sim->units.unitLength()
+	    << magnet::xml::attr("S") << _SSum[b] / samples
+	    << magnet::xml::attr("Amplitude") << _amplitudeSum[b] / samples
+	    << magnet::xml::endtag(_hasDirection ? "Point" : "Shell");
+      }
+
+    XML << magnet::xml::endtag("StructureFactor");
+  }
+}
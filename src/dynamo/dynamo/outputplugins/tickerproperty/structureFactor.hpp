@@ -0,0 +1,159 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/outputplugins/tickerproperty/ticker.hpp>
+#include <magnet/math/fft.hpp>
+#include <array>
+#include <vector>
+#include <complex>
+
+namespace dynamo {
+  /*! \brief Measures the static structure factor \f$S(k)=\langle
+      |\rho_k|^2\rangle/N\f$, where \f$\rho_k=\sum_i e^{i k\cdot r_i}\f$.
+
+    The wave vectors are those of the periodic box,
+    \f$k=2\pi(n_x/L_x,n_y/L_y,n_z/L_z)\f$ for integer \f$n\f$. By
+    default all wave vectors with \f$|k|\le\f$ MaxK
+    \f$\Delta k\f$ are sampled (only one of each \f$\pm k\f$ pair),
+    where \f$\Delta k=2\pi/L_{max}\f$, and the results are averaged
+    over shells of width \f$\Delta k\f$.
+
+    If a Direction is given (three integers separated by spaces),
+    only the multiples \f$m=1,\ldots,\f$MaxK of that wave vector are
+    sampled and each is output separately. The simple cubic order
+    parameter (OPSCParameter) of a system of N particles is the
+    Amplitude (\f$\langle|\rho_k|\rangle/N\f$) of Direction="1 1 1"
+    at \f$m=N^{1/3}\f$.
+
+    The density modes are evaluated by one of two methods, which is
+    selected by the Method attribute:
+
+    - "Recurrence": the factors \f$e^{i 2\pi n x/L}\f$ of each
+      particle are generated for all \f$n\f$ by repeated
+      multiplication, so only three complex exponentials are evaluated
+      per particle and each wave vector costs one complex
+      multiplication.
+
+    - "FFT": the particles are assigned to a GridSize\f$^3\f$ mesh
+      (cloud-in-cell), which is Fourier transformed, and the
+      transform is divided by the Fourier transform of the
+      assignment function. This is cheaper for large sets of wave
+      vectors, but is approximate (aliasing) as \f$|n|\f$
+      approaches GridSize/2.
+
+    - "Auto" (the default): the method with the lowest estimated cost.
+
+    The particle pass runs in the sweep of the SysTicker, and the
+    FFT is parallelised over the lines of the mesh.
+
+    \code
+    <OP Type="StructureFactor" MaxK="20" Method="Auto"/>
+    <OP Type="StructureFactor" MaxK="10" Direction="1 1 1"/>
+    \endcode
+
+    or, from the command line,
+
+    \code
+    dynarun config.xml -L "StructureFactor:MaxK=10,Direction=1 1 1"
+    \endcode
+   */
+  class OPStructureFactor: public OPTicker
+  {
+  public:
+    OPStructureFactor(const dynamo::Simulation*, const magnet::xml::Node&);
+
+    virtual void initialise();
+
+    virtual void stream(double) {}
+
+    virtual void ticker();
+
+    virtual bool beginSweep(size_t blocks);
+
+    virtual void sweepParticles(size_t block, size_t begin, size_t end);
+  
+    virtual void output(magnet::xml::XmlStream&);
+
+    virtual void operator<<(const magnet::xml::Node&);
+
+  protected:
+    enum Method { AUTO, RECURRENCE, FFT };
+
+    /*! \brief A run of wave vectors with the same \f$n_x\f$ and
+        \f$n_y\f$ and consecutive \f$n_z\f$.
+
+      The wave vectors are stored in runs so that the factor
+      \f$e^{i(k_x x + k_y y)}\f$ is only calculated once per run.
+     */
+    struct Run
+    {
+      int nx;
+      int ny;
+      int nz;
+      size_t begin;
+      size_t end;
+    };
+
+    void buildWaveVectors();
+
+    void sweepRecurrence(size_t block, size_t begin, size_t end);
+    void sweepDirection(size_t block, size_t begin, size_t end);
+    void sweepMesh(size_t block, size_t begin, size_t end);
+
+    //! \brief Sum the block meshes and transform them into _mesh.
+    void transformMesh();
+    //! \brief Sum the block meshes for the z-planes in [begin, end).
+    void reduceMesh(size_t begin, size_t end);
+    //! \brief Transform the lines along dimension dim in the planes [begin, end) of the other dimensions.
+    void transformLines(size_t dim, size_t begin, size_t end);
+
+    //! \brief Add the density modes of the current configuration to the running sums.
+    void accumulate(const std::vector<std::complex<double> >& rho);
+
+    size_t meshIndex(int nx, int ny, int nz) const;
+
+    size_t _maxK;
+    Method _method;
+    bool _hasDirection;
+    std::array<int, 3> _direction;
+    size_t _gridSize;
+
+    //! \brief The wave vectors (in integer units of the box) sampled.
+    std::vector<std::array<int, 3> > _waveVectors;
+    std::vector<Run> _runs;
+    //! \brief The output bin of each wave vector.
+    std::vector<size_t> _bin;
+    //! \brief The wave number of each output bin.
+    std::vector<double> _binK;
+    //! \brief The largest |n| in each dimension.
+    std::array<int, 3> _maxN;
+
+    //! \brief The density modes of each block of the sweep (Recurrence and Direction).
+    std::vector<std::vector<std::complex<double> > > _blockRho;
+    //! \brief The assigned density of each block of the sweep (FFT).
+    std::vector<std::vector<double> > _blockMesh;
+    std::vector<std::complex<double> > _mesh;
+    magnet::math::FFT _fft;
+
+    size_t _ticks;
+    //! \brief The running sums of |rho_k|^2, |rho_k| and the number of wave vectors of each bin.
+    std::vector<double> _SSum;
+    std::vector<double> _amplitudeSum;
+    std::vector<size_t> _binCount;
+  };
+}
@@ -17,8 +17,13 @@
 
 #pragma once
 #include <dynamo/outputplugins/outputplugin.hpp>
+#include <magnet/math/vector.hpp>
+#include <vector>
 
 namespace dynamo {
+  class TChain;
+  class IDRange;
+
   /*! \brief An output plugin marker class for periodically 'ticked'
    * plugins, ticked by the SysTicker class.
    *
@@ -37,6 +42,58 @@ namespace dynamo {
     virtual void output(magnet::xml::XmlStream&) {}
 
     virtual void ticker() = 0;
+
+    /*! \brief Prepare for a sweep over the particles.
+
+      Ticker plugins which accumulate data from every particle may
+      declare a particle sweep by overriding this function and
+      sweepParticles(). The SysTicker then performs a single pass
+      over the particles for all declared sweeps (in parallel if a
+      ThreadPool is available) before ticker() is called, where the
+      per-block data should be reduced.
+
+      \param blocks The number of blocks the particles are split into.
+      \return True if this plugin takes part in the sweep.
+     */
+    virtual bool beginSweep(size_t blocks) { return false; }
+
+    /*! \brief Accumulate the data of the particles with IDs in
+      [begin, end).
+
+      Blocks may be processed concurrently, but each block is only
+      ever processed by one thread at a time. Implementations must
+      therefore only write to per-particle data or to the
+      accumulators of the passed block.
+     */
+    virtual void sweepParticles(size_t block, size_t begin, size_t end) {}
+
+    /*! \brief Prepare for a sweep over the molecules of the TChain
+        topologies.
+
+      This is the polymer equivalent of beginSweep(). The SysTicker
+      unwraps each chain molecule once per tick and passes it to
+      every plugin taking part through sweepChain(). The molecules
+      are split into blocks which may be processed in parallel.
+
+      \param blocks The number of blocks the molecules are split into.
+      \return True if this plugin takes part in the sweep.
+     */
+    virtual bool beginChainSweep(size_t blocks) { return false; }
+
+    /*! \brief Accumulate the data of a single chain molecule.
+
+      The same restrictions on writing data apply as for
+      sweepParticles(). Within a block, the molecules of each chain
+      are visited in order.
+
+      \param chain The topology the molecule belongs to.
+      \param molecule The index of the molecule in the topology.
+      \param range The IDs of the beads of the molecule.
+      \param positions The positions of the beads, unwrapped along the
+      chain through the boundary conditions and relative to the first
+      bead (see TChain::unwrapMolecule).
+     */
+    virtual void sweepChain(size_t block, const TChain& chain, size_t molecule, const IDRange& range, const std::vector<Vector>& positions) {}
   
     virtual void periodicOutput() {}
 
@@ -30,7 +30,8 @@ namespace dynamo {
     length(50),
     currCorrLength(0),
     ticksTaken(0),
-    notReady(true)
+    notReady(true),
+    _accumulating(false)
   {
     operator<<(XML);
   }
@@ -58,12 +59,39 @@ namespace dynamo {
     structData.resize(Sim->topology.size(), std::vector<double>(length, 0.0));
   }
 
+  bool
+  OPVACF::beginSweep(size_t blocks)
+  {
+    //The correlator is accumulated once the history is full
+    _accumulating = !notReady || (currCorrLength + 1 == length);
+    _blockSpeciesData.resize(blocks);
+    for (std::vector<double>& data : _blockSpeciesData)
+      data.assign(Sim->species.size() * length, 0.0);
+    return true;
+  }
+
+  void
+  OPVACF::sweepParticles(size_t block, size_t begin, size_t end)
+  {
+    for (size_t ID(begin); ID < end; ++ID)
+      velHistory[ID].push_front(Sim->particles[ID].getVelocity());
+
+    if (!_accumulating) return;
+
+    std::vector<double>& data = _blockSpeciesData[block];
+    for (size_t ID(begin); ID < end; ++ID)
+      {
+	const size_t offset = Sim->species(Sim->particles[ID])->getID() * length;
+	const boost::circular_buffer<Vector>& history = velHistory[ID];
+	for (size_t step(0); step < length; ++step)
+	  data[offset + step] += history[step] | history[0];
+      }
+  }
+
   void 
   OPVACF::ticker()
   {
-    for (const Particle& part : Sim->particles)
-      velHistory[part.getID()].push_front(part.getVelocity());
-  
+    //The velocity history is updated in the particle sweep
     if (notReady)
       {
 	if (++currCorrLength != length) return;
@@ -78,10 +106,10 @@ namespace dynamo {
   {
     ++ticksTaken;
   
-    for (const shared_ptr<Species>& sp : Sim->species)
-      for (const size_t& ID : *sp->getRange())
-      for (size_t step(0); step < length; ++step)
-	speciesData[sp->getID()][step] += velHistory[ID][step] | velHistory[ID][0];
+    for (const std::vector<double>& data : _blockSpeciesData)
+      for (const shared_ptr<Species>& sp : Sim->species)
+	for (size_t step(0); step < length; ++step)
+	  speciesData[sp->getID()][step] += data[sp->getID() * length + step];
   
     for (const shared_ptr<Topology>& topo : Sim->topology)
       for (const shared_ptr<IDRange>& range : topo->getMolecules())
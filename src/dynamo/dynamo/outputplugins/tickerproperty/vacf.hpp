@@ -36,12 +36,18 @@ namespace dynamo {
   protected:
     virtual void stream(double) {}
     virtual void ticker();
+    virtual bool beginSweep(size_t blocks);
+    virtual void sweepParticles(size_t block, size_t begin, size_t end);
 
     void accPass();
 
     std::vector<boost::circular_buffer<Vector> > velHistory;
     std::vector<std::vector<double> > speciesData;
     std::vector<std::vector<double> > structData;
+    //! \brief Per-block accumulators for the particle sweep, indexed by [block][species * length + step]
+    std::vector<std::vector<double> > _blockSpeciesData;
+    //! \brief If the current sweep is accumulating the correlator.
+    bool _accumulating;
     size_t length;
     size_t currCorrLength;
     size_t ticksTaken;
@@ -16,29 +16,205 @@
 */
 
 #include <dynamo/outputplugins/tickerproperty/vtk.hpp>
+#include <dynamo/outputplugins/misc.hpp>
 #include <dynamo/include.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/dynamics/dynamics.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <boost/algorithm/string.hpp>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <sstream>
+#ifdef DYNAMO_zlib_support
+# include <zlib.h>
+#endif
 
 namespace dynamo {
+  namespace {
+    //! \brief The most frames which may wait to be written out before the simulation is held.
+    const size_t maxQueuedFrames = 2;
+
+    //! \brief The uncompressed size of the blocks of compressed data arrays.
+    const size_t compressionBlockSize = 1 << 20;
+
+    const char* byteOrder()
+    {
+      const uint16_t test = 1;
+      return *reinterpret_cast<const char*>(&test) ? "LittleEndian" : "BigEndian";
+    }
+
+    template<class T>
+    void appendValue(std::vector<char>& buffer, const T& val)
+    {
+      const char* ptr = reinterpret_cast<const char*>(&val);
+      buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+    }
+
+    /*! \brief Encode a data array for the appended section of a VTU
+        file (with a UInt64 header).
+     */
+    void encodeArray(std::vector<char>& buffer, const char* data, size_t bytes, bool compress)
+    {
+      if (!compress)
+	{
+	  appendValue(buffer, uint64_t(bytes));
+	  buffer.insert(buffer.end(), data, data + bytes);
+	  return;
+	}
+
+#ifdef DYNAMO_zlib_support
+      //The header is the number of blocks, the block size, the size
+      //of the last block if it is partial, then the compressed size
+      //of each block.
+      const size_t blocks = (bytes + compressionBlockSize - 1) / compressionBlockSize;
+      appendValue(buffer, uint64_t(blocks));
+      appendValue(buffer, uint64_t(compressionBlockSize));
+      appendValue(buffer, uint64_t(bytes % compressionBlockSize));
+      const size_t sizesStart = buffer.size();
+      buffer.resize(buffer.size() + blocks * sizeof(uint64_t));
+
+      std::vector<Bytef> compressed(compressBound(compressionBlockSize));
+      for (size_t block(0); block < blocks; ++block)
+	{
+	  const size_t begin = block * compressionBlockSize;
+	  const size_t length = std::min(compressionBlockSize, bytes - begin);
+	  uLongf compressedLength = compressed.size();
+	  if (compress2(compressed.data(), &compressedLength, reinterpret_cast<const Bytef*>(data + begin), length, Z_DEFAULT_COMPRESSION) != Z_OK)
+	    M_throw() << "Failed to compress a VTK data array";
+
+	  const uint64_t size = compressedLength;
+	  std::memcpy(buffer.data() + sizesStart + block * sizeof(uint64_t), &size, sizeof(uint64_t));
+	  buffer.insert(buffer.end(), compressed.begin(), compressed.begin() + compressedLength);
+	}
+#else
+      M_throw() << "zlib compressed VTK output support was not built in!";
+#endif
+    }
+
+    //! \brief Write the values of a data array as text.
+    template<class T>
+    void writeAscii(std::ostream& os, const char* data, size_t count, size_t components)
+    {
+      const T* values = reinterpret_cast<const T*>(data);
+      for (size_t i(0); i < count; ++i)
+	{
+	  for (size_t c(0); c < components; ++c)
+	    os << (c ? " " : "") << values[i * components + c];
+	  os << "\n";
+	}
+    }
+
+    template<class T>
+    void appendVector(std::vector<char>& buffer, const Vector& vec)
+    {
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	appendValue(buffer, T(vec[iDim]));
+    }
+  }
+
   OPVTK::OPVTK(const dynamo::Simulation* tmp, const magnet::xml::Node& XML):
     OPTicker(tmp,"VTK"),
-    imageCount(0)
+    imageCount(0),
+    _fields{VELOCITY},
+    _binary(true),
+    _compress(false),
+    _pieces(1),
+    _frames(maxQueuedFrames)
   {
     operator<<(XML);
   }
 
+  OPVTK::~OPVTK()
+  {
+    //Wait for the remaining frames to be written out
+    std::exception_ptr error = _frames.finish();
+    if (error)
+      try { std::rethrow_exception(error); }
+      catch (std::exception& e)
+	{ std::cerr << "\nVTK: Failed to write frames: " << e.what() << std::endl; }
+  }
+
   void 
   OPVTK::operator<<(const magnet::xml::Node& XML)
-  {}
+  {
+    if (XML.hasAttribute("Format"))
+      {
+	const std::string format = XML.getAttribute("Format").getValue();
+	if (format == "Binary")
+	  _binary = true;
+	else if (format == "Ascii")
+	  _binary = false;
+	else
+	  M_throw() << "Unknown VTK Format \"" << format << "\", must be Binary or Ascii";
+      }
+
+    _compress = XML.hasAttribute("Compress");
+
+#ifndef DYNAMO_zlib_support
+    if (_compress)
+      M_throw() << "zlib compressed VTK output support was not built in!";
+#endif
 
+    if (_compress && !_binary)
+      M_throw() << "Only Binary VTK output can be compressed";
+
+    if (XML.hasAttribute("Pieces"))
+      _pieces = XML.getAttribute("Pieces").as<size_t>();
+
+    if (!_pieces)
+      M_throw() << "The VTK output needs at least one piece";
+
+    if (XML.hasAttribute("Fields"))
+      {
+	_fields.clear();
+	for (const std::string& name : splitList(XML.getAttribute("Fields").getValue()))
+	  if (name == "Velocity")
+	    _fields.push_back(VELOCITY);
+	  else if (name == "Species")
+	    _fields.push_back(SPECIES);
+	  else if (name == "ID")
+	    _fields.push_back(ID);
+	  else if (name == "Orientation")
+	    _fields.push_back(ORIENTATION);
+	  else if (name == "AngularVelocity")
+	    _fields.push_back(ANGULARVELOCITY);
+	  else if (name == "KineticEnergy")
+	    _fields.push_back(KINETICENERGY);
+	  else if (name == "InternalEnergy")
+	    _fields.push_back(INTERNALENERGY);
+	  else
+	    M_throw() << "Unknown VTK field \"" << name 
+		      << "\", must be one of Velocity, Species, ID, Orientation, AngularVelocity, KineticEnergy or InternalEnergy";
+      }
+  }
 
   void 
   OPVTK::initialise()
   {
+    for (const Field field : _fields)
+      switch (field)
+	{
+	case ORIENTATION:
+	case ANGULARVELOCITY:
+	  if (!Sim->dynamics->hasOrientationData())
+	    M_throw() << "The VTK Orientation and AngularVelocity fields need a system with orientation data";
+	  break;
+	case INTERNALENERGY:
+	  if (!Sim->getOutputPlugin<OPMisc>())
+	    M_throw() << "The VTK InternalEnergy field needs the Misc plugin";
+	  break;
+	default:
+	  break;
+	}
+
+    if (_pieces > Sim->N())
+      M_throw() << "Cannot split " << Sim->N() << " particles into " << _pieces << " VTK pieces";
+
+    _frames.start([this](Frame& frame) { writeFrame(frame); });
+
     ticker();
   }
 
@@ -52,97 +228,208 @@ namespace dynamo {
   OPVTK::getFileName(size_t idx) {
     std::ostringstream ss;
     ss << std::setw(5) << std::setfill('0') << idx;
-    return "paraview" + ss.str() + ".vtu";
+    return "paraview" + ss.str() + ((_pieces > 1) ? ".pvtu" : ".vtu");
+  }
+
+  std::string
+  OPVTK::getPieceName(size_t idx, size_t piece) {
+    std::ostringstream ss;
+    ss << std::setw(5) << std::setfill('0') << idx;
+    return "paraview" + ss.str() + "_" + boost::lexical_cast<std::string>(piece) + ".vtu";
   }
 
   void
   OPVTK::printImage()
   {
-    using namespace magnet::xml;
-    XmlStream XML;
-    
-    XML //<< std::scientific
-      //This has a minus one due to the digit in front of the decimal
-      //An extra one is added if we're rounding
-      << prolog() << tag("VTKFile")
-      << attr("type") << "UnstructuredGrid"
-      << attr("version") << "0.1"
-      << attr("byte_order") << "LittleEndian"
-      << tag("UnstructuredGrid")
-      << tag("Piece") 
-      << attr("NumberOfPoints") << Sim->particles.size()
-      << attr("NumberOfCells") << 0
-      << tag("Points")
-      << tag("DataArray")
-      << attr("type") << "Float32"
-      << attr("format") << "ascii"
-      << attr("NumberOfComponents") << "3"
-      << chardata();
-
-    
+    Frame frame;
+    frame.index = imageCount++;
+    frame.N = Sim->N();
+
+    DataArray positions{"Points", false, 3, std::vector<char>()};
+    positions.data.reserve(frame.N * 3 * sizeof(float));
     for (const Particle& part: Sim->particles) {
       Vector r = part.getPosition();
       Sim->BCs->applyBC(r);
-      r = r / Sim->units.unitLength();
-      XML << r[0]  << " " << r[1] << " " << r[2] << "\n";
+      appendVector<float>(positions.data, r / Sim->units.unitLength());
     }
-      
-    XML << endtag("DataArray")
-	<< endtag("Points")
-	<< tag("Cells") 
-
-	<< tag("DataArray")
-	<< attr("type") << "Int32" 
-	<< attr("Name") << "connectivity" 
-	<< attr("format") << "ascii" 
-	<< endtag("DataArray") 
-
-	<< tag("DataArray") 
-	<< attr("type") << "Int32" 
-	<< attr("Name") << "offsets" 
-	<< attr("format") << "ascii" 
-	<< endtag("DataArray")
-
-	<< tag("DataArray") 
-	<< attr("type") << "UInt8" 
-	<< attr("Name") << "types" 
-	<< attr("format") << "ascii" 
-	<< endtag("DataArray") 
-
-	<< endtag("Cells")
-	<< tag("CellData")
-	<< endtag("CellData")
-	<< tag("PointData"); 
-
-    //Velocity data    
-    XML << tag("DataArray")
-	<< attr("type") << "Float32"
-	<< attr("Name") << "Velocities"
-	<< attr("NumberOfComponents") << "3"
-	<< attr("format") << "ascii"
-	<< chardata();
-    
-    for (const Particle& part: Sim->particles)
-      XML << part.getVelocity()[0] / Sim->units.unitVelocity() << " "
-	  << part.getVelocity()[1] / Sim->units.unitVelocity() << " "
-	  << part.getVelocity()[2] / Sim->units.unitVelocity() << "\n";
-    
-    XML << endtag("DataArray");
-
-    XML << endtag("PointData")
-	<< endtag("Piece")
-	<< endtag("UnstructuredGrid")
-	<< endtag("VTKFile")
-      ;
-
-    XML.write_file(getFileName(imageCount).c_str());
-    ++imageCount;
+    frame.arrays.push_back(std::move(positions));
+
+    for (const Field field : _fields)
+      {
+	DataArray array{"", false, 1, std::vector<char>()};
+	switch (field)
+	  {
+	  case VELOCITY:
+	    array.name = "Velocities";
+	    array.components = 3;
+	    for (const Particle& part: Sim->particles)
+	      appendVector<float>(array.data, part.getVelocity() / Sim->units.unitVelocity());
+	    break;
+	  case SPECIES:
+	    array.name = "Species";
+	    array.integer = true;
+	    for (const Particle& part: Sim->particles)
+	      appendValue(array.data, int32_t(Sim->species(part)->getID()));
+	    break;
+	  case ID:
+	    array.name = "ID";
+	    array.integer = true;
+	    for (const Particle& part: Sim->particles)
+	      appendValue(array.data, int32_t(part.getID()));
+	    break;
+	  case ORIENTATION:
+	    array.name = "Orientation";
+	    array.components = 3;
+	    for (const Particle& part: Sim->particles)
+	      appendVector<float>(array.data, Sim->dynamics->getRotData(part).orientation * Quaternion::initialDirector());
+	    break;
+	  case ANGULARVELOCITY:
+	    array.name = "AngularVelocity";
+	    array.components = 3;
+	    for (const Particle& part: Sim->particles)
+	      appendVector<float>(array.data, Sim->dynamics->getRotData(part).angularVelocity * Sim->units.unitTime());
+	    break;
+	  case KINETICENERGY:
+	    array.name = "KineticEnergy";
+	    for (const Particle& part: Sim->particles)
+	      appendValue(array.data, float(Sim->species(part)->getParticleKineticEnergy(part.getID()) / Sim->units.unitEnergy()));
+	    break;
+	  case INTERNALENERGY:
+	    {
+	      array.name = "InternalEnergy";
+	      const OPMisc& misc = *Sim->getOutputPlugin<OPMisc>();
+	      for (const Particle& part: Sim->particles)
+		appendValue(array.data, float(misc.getParticleInternalEnergy(part.getID()) / Sim->units.unitEnergy()));
+	      break;
+	    }
+	  }
+	frame.arrays.push_back(std::move(array));
+      }
+
+    //Only holds the simulation if the writer has fallen behind
+    _frames.push(std::move(frame));
+  }
+
+  void
+  OPVTK::writeFrame(const Frame& frame)
+  {
+    if (_pieces == 1)
+      {
+	writePiece(getFileName(frame.index), frame, 0, frame.N);
+	return;
+      }
+
+    for (size_t piece(0); piece < _pieces; ++piece)
+      writePiece(getPieceName(frame.index, piece), frame, piece * frame.N / _pieces, (piece + 1) * frame.N / _pieces);
+
+    //The parallel file collecting the pieces
+    std::ofstream of(getFileName(frame.index));
+    if (!of)
+      M_throw() << "Failed to open " << getFileName(frame.index) << " for writing";
+
+    of << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" byte_order=\"" << byteOrder() << "\" header_type=\"UInt64\">\n"
+       << "<PUnstructuredGrid GhostLevel=\"0\">\n"
+       << "<PPoints>\n<PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n</PPoints>\n"
+       << "<PPointData>\n";
+    for (size_t i(1); i < frame.arrays.size(); ++i)
+      of << "<PDataArray type=\"" << (frame.arrays[i].integer ? "Int32" : "Float32") 
+	 << "\" Name=\"" << frame.arrays[i].name 
+	 << "\" NumberOfComponents=\"" << frame.arrays[i].components << "\"/>\n";
+    of << "</PPointData>\n";
+    for (size_t piece(0); piece < _pieces; ++piece)
+      of << "<Piece Source=\"" << getPieceName(frame.index, piece) << "\"/>\n";
+    of << "</PUnstructuredGrid>\n</VTKFile>\n";
+
+    if (!of)
+      M_throw() << "Failed while writing " << getFileName(frame.index);
+  }
+
+  void
+  OPVTK::writePiece(const std::string& filename, const Frame& frame, size_t begin, size_t end)
+  {
+    std::ofstream of(filename, std::ios::binary);
+    if (!of)
+      M_throw() << "Failed to open " << filename << " for writing";
+
+    //The appended data is encoded first, to find the offsets of the arrays
+    std::vector<char> appended;
+    std::vector<size_t> offsets;
+    if (_binary)
+      for (const DataArray& array : frame.arrays)
+	{
+	  const size_t stride = 4 * array.components;
+	  offsets.push_back(appended.size());
+	  encodeArray(appended, array.data.data() + begin * stride, (end - begin) * stride, _compress);
+	}
+
+    of << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"" << byteOrder() << "\" header_type=\"UInt64\"";
+    if (_compress)
+      of << " compressor=\"vtkZLibDataCompressor\"";
+    of << ">\n<UnstructuredGrid>\n"
+       << "<Piece NumberOfPoints=\"" << end - begin << "\" NumberOfCells=\"0\">\n";
+
+    of << std::setprecision(std::numeric_limits<float>::max_digits10);
+    for (size_t i(0); i < frame.arrays.size(); ++i)
+      {
+	const DataArray& array = frame.arrays[i];
+	if (i == 0)
+	  of << "<Points>\n";
+	else if (i == 1)
+	  of << "<PointData>\n";
+
+	of << "<DataArray type=\"" << (array.integer ? "Int32" : "Float32") << "\"";
+	if (i) of << " Name=\"" << array.name << "\"";
+	of << " NumberOfComponents=\"" << array.components << "\"";
+
+	if (_binary)
+	  of << " format=\"appended\" offset=\"" << offsets[i] << "\"/>\n";
+	else
+	  {
+	    of << " format=\"ascii\">\n";
+	    const char* data = array.data.data() + begin * 4 * array.components;
+	    if (array.integer)
+	      writeAscii<int32_t>(of, data, end - begin, array.components);
+	    else
+	      writeAscii<float>(of, data, end - begin, array.components);
+	    of << "</DataArray>\n";
+	  }
+
+	if (i == 0)
+	  of << "</Points>\n"
+	     << "<Cells>\n"
+	     << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\"></DataArray>\n"
+	     << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\"></DataArray>\n"
+	     << "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\"></DataArray>\n"
+	     << "</Cells>\n"
+	     << "<CellData>\n</CellData>\n";
+      }
+
+    if (frame.arrays.size() == 1)
+      of << "<PointData>\n";
+    of << "</PointData>\n</Piece>\n</UnstructuredGrid>\n";
+
+    if (_binary)
+      {
+	of << "<AppendedData encoding=\"raw\">\n_";
+	of.write(appended.data(), appended.size());
+	of << "\n</AppendedData>\n";
+      }
+
+    of << "</VTKFile>\n";
+
+    if (!of)
+      M_throw() << "Failed while writing " << filename;
   }
 
   void 
   OPVTK::output(magnet::xml::XmlStream&)
   {
     using namespace magnet::xml;
+    //All frames must be on disk before the collection is written
+    _frames.flush();
+
     //Write out the unified file at the end
     XmlStream XML;
 
@@ -18,14 +18,44 @@
 #pragma once
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
 #include <magnet/math/vector.hpp>
+#include <magnet/thread/backgroundqueue.hpp>
 #include <vector>
 
 namespace dynamo {
+  /*! \brief Writes the particle data to VTK unstructured grid (VTU)
+      files for visualisation in ParaView, with a paraview.pvd
+      collection file linking the frames together.
+
+    By default the data is written as raw binary in the appended data
+    section of the file. Setting Format="Ascii" writes the original
+    plain text format instead, and the Compress flag zlib compresses
+    the binary data (if dynamo was built with zlib).
+
+    The Fields attribute selects the per-particle data written
+    alongside the positions, as a list separated by commas or spaces
+    from: Velocity (the default), Species, ID, Orientation,
+    AngularVelocity, KineticEnergy and InternalEnergy (which is
+    taken from the Misc plugin).
+
+    Large systems may be split into a number of Pieces, which are
+    written as separate VTU files and collected by a parallel
+    (.pvtu) file for each frame.
+
+    The simulation thread only copies the selected data of each
+    frame, the formatting, compression and writing of the files is
+    carried out by a background thread.
+
+    \code
+    <OP Type="VTK" Fields="Velocity Species InternalEnergy" Compress="" Pieces="4"/>
+    \endcode
+   */
   class OPVTK: public OPTicker
   {
   public:
     OPVTK(const dynamo::Simulation*, const magnet::xml::Node&);
 
+    ~OPVTK();
+
     virtual void initialise();
 
     virtual void stream(double) {}
@@ -37,9 +67,47 @@ namespace dynamo {
     virtual void output(magnet::xml::XmlStream&);
   
   protected:
+    OPVTK(const OPVTK&);
+
+    enum Field { VELOCITY, SPECIES, ID, ORIENTATION, ANGULARVELOCITY, KINETICENERGY, INTERNALENERGY };
+
+    //! \brief A per-particle data array of a frame.
+    struct DataArray
+    {
+      std::string name;
+      //! \brief True for Int32 data, otherwise the data is Float32.
+      bool integer;
+      size_t components;
+      //! \brief The raw data, (4 * components) bytes per particle.
+      std::vector<char> data;
+    };
+
+    //! \brief The data of a single frame, to be written out.
+    struct Frame
+    {
+      size_t index;
+      size_t N;
+      //! \brief The positions followed by the selected fields.
+      std::vector<DataArray> arrays;
+    };
 
     void printImage();
     std::string getFileName(size_t idx);
+    std::string getPieceName(size_t idx, size_t piece);
     size_t imageCount;
+
+    //! \brief Write out a frame (background thread only).
+    void writeFrame(const Frame&);
+
+    //! \brief Write the particles [begin, end) of a frame as a VTU file.
+    void writePiece(const std::string& filename, const Frame&, size_t begin, size_t end);
+
+    std::vector<Field> _fields;
+    bool _binary;
+    bool _compress;
+    size_t _pieces;
+
+    //! \brief The frames waiting for the background writing thread.
+    magnet::thread::BackgroundQueue<Frame> _frames;
   };
 }
@@ -26,6 +26,8 @@
 #include <unordered_map>
 
 namespace dynamo {
+  class PropertyColumn;
+
   /*! \brief A interface class which allows other classes to access a property
     of a particle.  
     
@@ -77,6 +79,11 @@ namespace dynamo {
     //! Fetch the units of this property
     inline const Units& getUnits() const { return _units; }
 
+    /*! \brief Fetch a PropertyColumn which gives direct access to the
+      values of this property.
+    */
+    inline virtual PropertyColumn getColumn() const;
+
     //! Helper to write out derived classes
     friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const Property& prop)
     { prop.outputXML(XML); return XML; }
@@ -97,6 +104,56 @@ namespace dynamo {
     magnet::units::Units _units;
   };
 
+  /*! \brief A lightweight view of the values of a Property.
+
+    Looking up a Property through getProperty() costs a virtual call
+    per particle, which adds up in the pair tests of the
+    interactions. A column instead points directly at the storage of
+    the values, so a lookup is an inlined load. A NumericProperty is
+    a column with a stride of zero (its single value is returned for
+    all IDs), while a ParticleProperty is a contiguous array of
+    values. Any other Property falls back to the virtual lookup.
+
+    As the column points into the Property, it remains valid when the
+    units are rescaled, but the Property must outlive it. Interactions
+    keep their Property and bind its column in initialise().
+   */
+  class PropertyColumn
+  {
+  public:
+    PropertyColumn(): _data(nullptr), _stride(0), _property(nullptr) {}
+
+    //! \brief A column over an array of values (a stride of zero repeats a single value).
+    PropertyColumn(const double* data, size_t stride): _data(data), _stride(stride), _property(nullptr) {}
+
+    //! \brief A column which looks up the values through the Property.
+    explicit PropertyColumn(const Property* property): _data(nullptr), _stride(0), _property(property) {}
+
+    //! Fetch the value of the property for a particle with a certain ID
+    inline double operator()(size_t ID) const
+    { 
+#ifdef DYNAMO_DEBUG
+      if (!_data && !_property)
+	M_throw() << "Accessing an unbound PropertyColumn";
+#endif
+      return _data ? _data[ID * _stride] : _property->getProperty(ID); 
+    }
+
+    //! Fetch the value of the property for a particle pairing
+    inline double operator()(size_t ID1, size_t ID2) const
+    { return (operator()(ID1) + operator()(ID2)) / 2; }
+
+    //! \brief Test if the column has the same value for all particles.
+    inline bool isConstant() const { return _data && !_stride; }
+
+  private:
+    const double* _data;
+    size_t _stride;
+    const Property* _property;
+  };
+
+  inline PropertyColumn Property::getColumn() const { return PropertyColumn(this); }
+
   /*! \brief A class where the name is the value of the property.
     
     This property is used whenever a single value is set for a
@@ -125,6 +182,9 @@ namespace dynamo {
     */
     inline virtual const double getMinValue() const { return _val; }
 
+    //! A column which repeats the single value.
+    inline virtual PropertyColumn getColumn() const { return PropertyColumn(&_val, 0); }
+
     //! \sa Property::rescaleUnit
     inline virtual const void rescaleUnit(const Units::Dimension dim, 
 					  const double rescale)
@@ -195,6 +255,9 @@ namespace dynamo {
 
     inline virtual const double getMinValue() const 
     { return *std::min_element(_values.begin(), _values.end()); }
+
+    //! A column over the per-particle values.
+    inline virtual PropertyColumn getColumn() const { return PropertyColumn(_values.data(), 1); }
   
     //! \sa Property::rescaleUnit
     inline virtual const void rescaleUnit(const Units::Dimension dim, 
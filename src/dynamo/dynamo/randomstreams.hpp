@@ -0,0 +1,166 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/philox.hpp>
+#include <magnet/exception.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <cstdint>
+#include <map>
+
+namespace dynamo {
+  /*! \brief The counter-based random number streams of a Simulation.
+
+    The shared generator of the Simulation (Simulation::ranGenerator)
+    must be used in a fixed order to be reproducible, so components
+    which draw from it cannot run in parallel. This store instead hands
+    out independent Philox streams, all derived from a single seed,
+    which are identified by a kind (e.g., a System, a thread or a
+    particle) and an index.
+
+    There are two types of stream. A named stream (operator()) is
+    owned by the store and its position is saved in the configuration
+    file, so a restarted simulation continues the same sequence of
+    random numbers. These are used by components with state, such as
+    thermostats. A stateless stream (getStream()) starts at a
+    position chosen by the caller, e.g., the number of times a
+    particle has been thermalised, and is not saved. This lets any
+    thread generate the random numbers of any particle without
+    coordination.
+
+    If the configuration does not specify a seed, it is drawn from the
+    Simulation's generator when the simulation is initialised.
+
+    \code
+    <RandomStreams Seed="1234">
+      <Stream ID="72057594037927936" Position="1024"/>
+    </RandomStreams>
+    \endcode
+   */
+  class RandomStreams
+  {
+  public:
+    enum Kind {
+      SYSTEM = 1,
+      THREAD = 2,
+      PARTICLE = 3,
+      PLUGIN = 4
+    };
+
+    RandomStreams(): _seed(0), _seeded(false) {}
+
+    //! \brief Combine a kind and an index into a stream ID.
+    static uint64_t streamID(Kind kind, uint64_t index)
+    {
+#ifdef DYNAMO_DEBUG
+      if (index >> 56)
+	M_throw() << "Random stream index " << index << " is too large";
+#endif
+      return (uint64_t(kind) << 56) | index;
+    }
+
+    /*! \brief Set the seed of all streams, rewinding the named streams
+        to their beginning.
+     */
+    void seed(uint64_t seed) {
+      _seed = seed;
+      _seeded = true;
+      for (auto& stream : _streams)
+	stream.second.seed(_seed, stream.first);
+    }
+
+    /*! \brief Seed the streams of a simulation being started.
+
+      An explicit seed (e.g., given on the command line) restarts the
+      streams, otherwise the state loaded from the configuration file
+      is continued. The passed seed is only used if no state was
+      loaded.
+     */
+    void startupSeed(uint64_t seed, bool explicitSeed) {
+      if (explicitSeed || !_seeded)
+	this->seed(seed);
+    }
+
+    bool isSeeded() const { return _seeded; }
+
+    uint64_t getSeed() const { return _seed; }
+
+    /*! \brief Fetch a named stream, which is checkpointed in the
+        configuration file.
+
+      The returned reference remains valid for the lifetime of the
+      store.
+     */
+    magnet::math::Philox& operator()(Kind kind, uint64_t index) {
+      if (!_seeded)
+	M_throw() << "The random streams have not been seeded yet";
+
+      const uint64_t ID = streamID(kind, index);
+      auto it = _streams.find(ID);
+      if (it == _streams.end())
+	it = _streams.insert(std::make_pair(ID, magnet::math::Philox(_seed, ID))).first;
+      return it->second;
+    }
+
+    /*! \brief Create a stateless stream, starting at the passed
+        position (in 32 bit words).
+     */
+    magnet::math::Philox getStream(Kind kind, uint64_t index, uint64_t position = 0) const {
+      if (!_seeded)
+	M_throw() << "The random streams have not been seeded yet";
+
+      magnet::math::Philox stream(_seed, streamID(kind, index));
+      stream.seek(position);
+      return stream;
+    }
+
+    //! \brief Load the seed and the positions of the named streams.
+    void operator<<(const magnet::xml::Node& XML) {
+      _streams.clear();
+      seed(XML.getAttribute("Seed").as<uint64_t>());
+      for (magnet::xml::Node node = XML.findNode("Stream"); node.valid(); ++node)
+	{
+	  const uint64_t ID = node.getAttribute("ID").as<uint64_t>();
+	  magnet::math::Philox stream(_seed, ID);
+	  stream.seek(node.getAttribute("Position").as<uint64_t>());
+	  _streams.insert(std::make_pair(ID, stream));
+	}
+    }
+
+    friend magnet::xml::XmlStream& operator<<(magnet::xml::XmlStream& XML, const RandomStreams& streams) {
+      if (!streams._seeded) return XML;
+
+      XML << magnet::xml::tag("RandomStreams")
+	  << magnet::xml::attr("Seed") << streams._seed;
+
+      for (const auto& stream : streams._streams)
+	XML << magnet::xml::tag("Stream")
+	    << magnet::xml::attr("ID") << stream.first
+	    << magnet::xml::attr("Position") << stream.second.tell()
+	    << magnet::xml::endtag("Stream");
+
+      XML << magnet::xml::endtag("RandomStreams");
+      return XML;
+    }
+
+  private:
+    uint64_t _seed;
+    bool _seeded;
+    std::map<uint64_t, magnet::math::Philox> _streams;
+  };
+}
@@ -38,8 +38,9 @@ namespace dynamo {
   void 
   SDumb::outputXML(magnet::xml::XmlStream& XML) const
   {
-    XML << magnet::xml::attr("Type") << "Dumb"
-	<< magnet::xml::tag("Sorter")
+    XML << magnet::xml::attr("Type") << "Dumb";
+    outputAttributesXML(XML);
+    XML << magnet::xml::tag("Sorter")
 	<< *sorter
 	<< magnet::xml::endtag("Sorter");
   }
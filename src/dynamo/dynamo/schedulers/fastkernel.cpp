@@ -0,0 +1,140 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dynamo/schedulers/fastkernel.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/particle.hpp>
+#include <dynamo/BC/PBC.hpp>
+#include <dynamo/BC/None.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/ranges/IDPairRangeAll.hpp>
+#include <magnet/intersection/ray_sphere.hpp>
+#include <cmath>
+#include <typeinfo>
+
+namespace dynamo {
+  namespace detail {
+    /*! \brief The minimum image convention of a BoundaryCondition,
+        as a non-virtual, inlinable call.
+
+      Each specialisation must match the applyBC(Vector&, Vector&)
+      implementation of its BoundaryCondition exactly.
+     */
+    template<class BC> struct MinimumImage;
+
+    template<> struct MinimumImage<BCPeriodic>
+    {
+      static inline void apply(const Simulation* Sim, Vector& r12)
+      {
+	for (size_t n = 0; n < NDIM; ++n)
+	  r12[n] = std::remainder(r12[n], Sim->primaryCellSize[n]);
+      }
+    };
+
+    template<> struct MinimumImage<BCNone>
+    {
+      static inline void apply(const Simulation*, Vector&) {}
+    };
+
+    /*! \brief The kernel for elastic or inelastic (smooth or rough)
+        IHardSphere interactions of uniform diameter, between
+        particles following DynNewtonian dynamics (without
+        orientation).
+
+      This matches DynNewtonian::SphereSphereInRoot and
+      IHardSphere::getEvent.
+     */
+    template<class BC>
+    class HardSphereKernel: public FastKernel
+    {
+    public:
+      HardSphereKernel(Simulation* const Sim, const IHardSphere& interaction):
+	FastKernel(Sim),
+	_interaction(interaction)
+      {}
+
+      virtual Event getEvent(const Particle& p1, const Particle& p2) const
+      { return predict(p1, p2, _interaction.getDiameterProperty()->getProperty(p1.getID())); }
+
+      virtual void getEvents(const Particle& part, const IDRange& ids, size_t begin, size_t end,
+			     Event* events, bool update) const
+      {
+	const double d = _interaction.getDiameterProperty()->getProperty(part.getID());
+	const double delay = Sim->dynamics->getSystemDelay();
+	for (size_t i(begin); i < end; ++i)
+	  {
+	    const size_t id = ids[i];
+	    if (id == part.getID()) continue;
+	    Particle& p2 = Sim->particles[id];
+	    if (update)
+	      {
+		//DynNewtonian::streamParticle, as called by
+		//Dynamics::updateParticle
+		p2.getPosition() += p2.getVelocity() * (p2.getPecTime() + delay);
+		p2.getPecTime() = -delay;
+	      }
+	    events[i - begin] = predict(part, p2, d);
+	  }
+      }
+
+    private:
+      const IHardSphere& _interaction;
+
+      inline Event predict(const Particle& p1, const Particle& p2, const double d) const
+      {
+	Vector r12 = p1.getPosition() - p2.getPosition();
+	const Vector v12 = p1.getVelocity() - p2.getVelocity();
+	MinimumImage<BC>::apply(Sim, r12);
+	const double dt = magnet::intersection::ray_sphere(r12, v12, d);
+
+	if (dt != std::numeric_limits<float>::infinity())
+	  return Event(p1, dt, INTERACTION, CORE, _interaction.getID(), p2);
+
+	return Event(p1, std::numeric_limits<float>::infinity(), INTERACTION, NONE, _interaction.getID(), p2);
+      }
+    };
+  }
+
+  shared_ptr<FastKernel>
+  FastKernel::getKernel(dynamo::Simulation* const Sim)
+  {
+    //Every pair must be handled by the first Interaction
+    if (Sim->interactions.empty() || !std::dynamic_pointer_cast<IDPairRangeAll>(Sim->interactions.front()->getRange()))
+      return shared_ptr<FastKernel>();
+    const Interaction& interaction = *Sim->interactions.front();
+
+    //Only the exact classes are specialised, derived classes may
+    //override their behaviour.
+    if ((typeid(*Sim->dynamics) != typeid(DynNewtonian)) || Sim->dynamics->hasOrientationData())
+      return shared_ptr<FastKernel>();
+
+    if (typeid(interaction) == typeid(IHardSphere))
+      {
+	const IHardSphere& hs = static_cast<const IHardSphere&>(interaction);
+	if (!std::dynamic_pointer_cast<NumericProperty>(hs.getDiameterProperty()))
+	  return shared_ptr<FastKernel>();
+
+	if (typeid(*Sim->BCs) == typeid(BCPeriodic))
+	  return shared_ptr<FastKernel>(new detail::HardSphereKernel<BCPeriodic>(Sim, hs));
+	if (typeid(*Sim->BCs) == typeid(BCNone))
+	  return shared_ptr<FastKernel>(new detail::HardSphereKernel<BCNone>(Sim, hs));
+      }
+
+    return shared_ptr<FastKernel>();
+  }
+}
@@ -0,0 +1,82 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <dynamo/base.hpp>
+#include <dynamo/eventtypes.hpp>
+#include <dynamo/ranges/IDRange.hpp>
+#include <memory>
+
+namespace dynamo {
+  class Particle;
+
+  /*! \brief A specialised implementation of the interaction event
+      predictions, for a particular combination of Dynamics,
+      BoundaryCondition and Interaction.
+
+    The generic prediction of an interaction event passes through
+    several virtual calls (Simulation::getEvent,
+    Interaction::getEvent, Property::getProperty,
+    Dynamics::SphereSphereInRoot, BoundaryCondition::applyBC and
+    Dynamics::streamParticle), which prevent the compiler from
+    inlining the few floating point operations of each test. The
+    kernels are templates instantiated for known combinations of
+    these classes, and process a whole range of neighbours in a
+    single virtual call.
+
+    The kernels must give bitwise identical results to the generic
+    path, as the Scheduler recalculates events as they are run. The
+    Scheduler selects a kernel (if enabled with its FastKernel
+    attribute) using getKernel() when it is initialised.
+   */
+  class FastKernel: public dynamo::SimBase
+  {
+  public:
+    FastKernel(dynamo::Simulation* const Sim):
+      SimBase(Sim, "FastKernel")
+    {}
+
+    virtual ~FastKernel() {}
+
+    /*! \brief Predict the interaction event of two particles, which
+        must both be up to date.
+     */
+    virtual Event getEvent(const Particle& p1, const Particle& p2) const = 0;
+
+    /*! \brief Predict the interaction events of a particle with the
+        particles ids[begin] to ids[end-1].
+
+      The event with ids[i] is written to events[i - begin]. The slot
+      of the particle itself (if it is in the range) is left
+      untouched.
+
+      \param part The particle, which must be up to date.
+      \param update If the particles of the range are brought up to
+      date first. Otherwise they must already be up to date.
+     */
+    virtual void getEvents(const Particle& part, const IDRange& ids, size_t begin, size_t end,
+			   Event* events, bool update) const = 0;
+
+    /*! \brief Create the kernel matching the current configuration
+        of the Simulation.
+
+      \return The kernel, or an empty pointer if the configuration
+      has no specialised kernel.
+     */
+    static shared_ptr<FastKernel> getKernel(dynamo::Simulation* const);
+  };
+}
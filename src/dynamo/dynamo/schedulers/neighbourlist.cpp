@@ -27,6 +27,7 @@
 #include <dynamo/ranges/IDRangeRange.hpp>
 #include <dynamo/BC/include.hpp>
 #include <magnet/xmlreader.hpp>
+#include <algorithm>
 #include <cmath>
 
 namespace dynamo {
@@ -72,6 +73,22 @@ namespace dynamo {
   void
   SNeighbourList::initialise()
   {    
+    shared_ptr<GNeighbourList> nblist = getNBlist();
+    nblist->_sigNewNeighbour.connect<Scheduler, &Scheduler::addInteractionEvent>(this);
+    nblist->_sigReInitialise.connect<SNeighbourList, &SNeighbourList::reinitialise>(this);
+    Scheduler::initialise();
+  }
+
+  void
+  SNeighbourList::reinitialise()
+  {
+    getNBlist();
+    Scheduler::reinitialise();
+  }
+
+  shared_ptr<GNeighbourList>
+  SNeighbourList::getNBlist() const
+  {
     shared_ptr<GNeighbourList> nblist = std::dynamic_pointer_cast<GNeighbourList>(Sim->globals[NBListID]);
 
     if (!nblist)
@@ -83,30 +100,31 @@ namespace dynamo {
 		<< " but the longest interaction distance is " 
 		<< Sim->getLongestInteraction() / Sim->units.unitLength();
 
-    nblist->_sigNewNeighbour.connect<Scheduler, &Scheduler::addInteractionEvent>(this);
-    nblist->_sigReInitialise.connect<SNeighbourList, &SNeighbourList::initialise>(this);
-    Scheduler::initialise();
+    return nblist;
   }
 
   void 
   SNeighbourList::outputXML(magnet::xml::XmlStream& XML) const
   {
-    XML << magnet::xml::attr("Type") << "NeighbourList"
-	<< magnet::xml::tag("Sorter")
+    XML << magnet::xml::attr("Type") << "NeighbourList";
+    outputAttributesXML(XML);
+    XML << magnet::xml::tag("Sorter")
 	<< *sorter
 	<< magnet::xml::endtag("Sorter");
   }
 
   SNeighbourList::SNeighbourList(const magnet::xml::Node& XML, 
 				   dynamo::Simulation* const Sim):
-    Scheduler(Sim,"NbListScheduler", NULL)
+    Scheduler(Sim,"NbListScheduler", NULL),
+    _neighbourReserve(0)
   { 
     dout << "Neighbour List Scheduler Algorithm Loaded" << std::endl;
     operator<<(XML);
   }
 
   SNeighbourList::SNeighbourList(dynamo::Simulation* const Sim, FEL* ns):
-    Scheduler(Sim,"NeighbourListScheduler", ns)
+    Scheduler(Sim,"NeighbourListScheduler", ns),
+    _neighbourReserve(0)
   { dout << "Neighbour List Scheduler Algorithm Loaded" << std::endl; }
   
   double 
@@ -130,7 +148,11 @@ namespace dynamo {
     //Grab a reference to the neighbour list
     const GNeighbourList& nblist(*static_cast<const GNeighbourList*>(Sim->globals[NBListID].get()));
     IDRangeList* range_ptr = new IDRangeList();
+    range_ptr->getContainer().reserve(_neighbourReserve.load(std::memory_order_relaxed));
     nblist.getParticleNeighbours(part, range_ptr->getContainer());
+    //A racing update may be lost, but this is only a hint
+    if (range_ptr->getContainer().size() > _neighbourReserve.load(std::memory_order_relaxed))
+      _neighbourReserve.store(range_ptr->getContainer().size(), std::memory_order_relaxed);
     return std::unique_ptr<IDRange>(range_ptr);
   }
 
@@ -17,8 +17,11 @@
 
 #pragma once
 #include <dynamo/schedulers/scheduler.hpp>
+#include <atomic>
 
 namespace dynamo {
+  class GNeighbourList;
+
   class SNeighbourList: public Scheduler, public magnet::Tracked
   {
   public:
@@ -27,6 +30,7 @@ namespace dynamo {
     SNeighbourList(dynamo::Simulation* const, FEL*);
 
     virtual void initialise();
+    virtual void reinitialise();
     virtual void initialiseNBlist();
 
     virtual double getNeighbourhoodDistance() const;
@@ -38,5 +42,19 @@ namespace dynamo {
     virtual void outputXML(magnet::xml::XmlStream&) const;
   
     size_t NBListID;
+
+    /*! \brief Fetch the neighbour list, checking it supports the
+        longest interaction in the system.
+     */
+    shared_ptr<GNeighbourList> getNBlist() const;
+
+    /*! \brief The largest neighbourhood found so far, used to
+        reserve space for the neighbour lists so they are not
+        repeatedly grown.
+
+	This is atomic, as neighbourhoods are requested concurrently
+	during parallel rebuilds of the event list.
+     */
+    mutable std::atomic<size_t> _neighbourReserve;
   };
 }
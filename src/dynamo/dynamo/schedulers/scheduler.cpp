@@ -30,8 +30,11 @@
 #include <dynamo/globals/neighbourList.hpp>
 #include <dynamo/NparticleEventData.hpp>
 #endif
+#include <magnet/thread/threadpool.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <algorithm>
+#include <functional>
 
 namespace dynamo {
   Scheduler::Scheduler(dynamo::Simulation* const tmp, const char * aName,
@@ -39,7 +42,11 @@ namespace dynamo {
     SimBase(tmp, aName),
     sorter(nS),
     _interactionRejectionCounter(0),
-    _localRejectionCounter(0)
+    _localRejectionCounter(0),
+    _recalculateCount(0),
+    _parallelPredictionThreshold(0),
+    _useFastKernel(false),
+    _validateRebuilds(false)
   {}
 
   Scheduler::~Scheduler() {}
@@ -48,10 +55,58 @@ namespace dynamo {
   Scheduler::operator<<(const magnet::xml::Node& XML)
   {
     sorter = FEL::getClass(XML.getNode("Sorter"));
+
+    if (XML.hasAttribute("ParallelPrediction"))
+      _parallelPredictionThreshold = XML.getAttribute("ParallelPrediction").as<size_t>();
+
+    if (XML.hasAttribute("ValidateRebuilds"))
+      _validateRebuilds = XML.getAttribute("ValidateRebuilds").as<bool>();
+
+    if (XML.hasAttribute("FastKernel"))
+      _useFastKernel = XML.getAttribute("FastKernel").as<bool>();
+  }
+
+  void
+  Scheduler::outputAttributesXML(magnet::xml::XmlStream& XML) const
+  {
+    if (_parallelPredictionThreshold)
+      XML << magnet::xml::attr("ParallelPrediction") << _parallelPredictionThreshold;
+
+    if (_validateRebuilds)
+      XML << magnet::xml::attr("ValidateRebuilds") << 1;
+
+    if (_useFastKernel)
+      XML << magnet::xml::attr("FastKernel") << 1;
   }
 
   void
   Scheduler::initialise()
+  {
+    _fastKernel.reset();
+    if (_useFastKernel)
+      {
+	_fastKernel = FastKernel::getKernel(Sim);
+	if (_fastKernel)
+	  dout << "Using a specialised kernel for the interaction events" << std::endl;
+	else
+	  dout << "No specialised kernel matches this system, using the generic interaction events" << std::endl;
+      }
+
+    validateConfiguration();
+    dout << "Building all events on collision " << Sim->eventCount << std::endl;
+    rebuildList();
+  }
+
+  void
+  Scheduler::reinitialise()
+  {
+    if (_validateRebuilds)
+      validateConfiguration();
+    rebuildList();
+  }
+
+  void
+  Scheduler::validateConfiguration()
   {
     //Now, the scheduler is used to test the state of the system.
     dout << "Checking the simulation configuration for any errors" << std::endl;
@@ -81,9 +136,6 @@ namespace dynamo {
     
     if (warnings > 100)
       derr << "Over 100 warnings of invalid states, further output was suppressed (total of " << warnings << " warnings detected)" << std::endl;
-
-    dout << "Building all events on collision " << Sim->eventCount << std::endl;
-    rebuildList();
   }
 
   void
@@ -92,9 +144,83 @@ namespace dynamo {
     sorter->clear();
     sorter->init(Sim->N() + 1);
 
-    for (Particle& part : Sim->particles)
-      addEvents(part);
+    sorter->beginBulkLoad();
+    if (_parallelPredictionThreshold && Sim->threads && Sim->threads->getThreadCount())
+      addAllEventsParallel();
+    else
+      for (Particle& part : Sim->particles)
+	addEvents(part);
     rebuildSystemEvents();
+    sorter->endBulkLoad();
+  }
+
+  void
+  Scheduler::addAllEventsParallel()
+  {
+    //The particles are all brought up to date first, so the tasks do
+    //not need to update the (shared) neighbouring particles.
+    Sim->dynamics->updateAllParticles();
+
+    //The particles are processed in batches, so the buffered events
+    //only take a bounded amount of memory.
+    const size_t N = Sim->N();
+    const size_t tasks = Sim->threads->getThreadCount();
+    const size_t batchSize = 1024 * tasks;
+    _rebuildBlocks.resize(tasks);
+    for (size_t batchStart(0); batchStart < N; batchStart += batchSize)
+      {
+	const size_t batchEnd = std::min(N, batchStart + batchSize);
+	const size_t batchN = batchEnd - batchStart;
+	for (size_t task(0); task < tasks; ++task)
+	  Sim->threads->queueTask(std::bind(&Scheduler::predictParticleEvents, this, task, batchStart + task * batchN / tasks, batchStart + (task + 1) * batchN / tasks));
+	Sim->threads->wait();
+
+	//Push the events in the same order as addEvents() would
+	for (size_t task(0); task < tasks; ++task)
+	  {
+	    const PredictionBlock& block = _rebuildBlocks[task];
+	    size_t event(0);
+	    for (size_t i(0); i < block.ends.size(); ++i)
+	      {
+		Particle& part = Sim->particles[batchStart + task * batchN / tasks + i];
+		addGlobalAndLocalEvents(part);
+		for (; event < block.ends[i]; ++event)
+		  sorter->push(block.events[event]);
+	      }
+	  }
+      }
+  }
+
+  void
+  Scheduler::predictParticleEvents(size_t task, size_t begin, size_t end) const
+  {
+    PredictionBlock& block = _rebuildBlocks[task];
+    block.events.clear();
+    block.ends.clear();
+    for (size_t id1(begin); id1 < end; ++id1)
+      {
+	const Particle& part1 = Sim->particles[id1];
+	std::unique_ptr<IDRange> ids(getParticleNeighbours(part1));
+	if (_fastKernel)
+	  {
+	    //The kernel leaves a slot for the particle itself, which is
+	    //removed afterwards
+	    const size_t start = block.events.size();
+	    block.events.resize(start + ids->size());
+	    _fastKernel->getEvents(part1, *ids, 0, ids->size(), &block.events[start], false);
+	    for (size_t i(0); i < ids->size(); ++i)
+	      if ((*ids)[i] == id1)
+		{
+		  block.events.erase(block.events.begin() + start + i);
+		  break;
+		}
+	  }
+	else
+	  for (const size_t id2 : *ids)
+	    if (id2 != id1)
+	      block.events.push_back(Sim->getEvent(part1, Sim->particles[id2]));
+	block.ends.push_back(block.events.size());
+      }
   }
 
 
@@ -102,7 +228,16 @@ namespace dynamo {
   Scheduler::addEvents(Particle& part)
   {  
     Sim->dynamics->updateParticle(part);
+    addGlobalAndLocalEvents(part);
+
+    //Now add the interaction events
+    std::unique_ptr<IDRange> ids(getParticleNeighbours(part));
+    addInteractionEvents(part, *ids);
+  }
 
+  void
+  Scheduler::addGlobalAndLocalEvents(const Particle& part)
+  {
     //Add the global events
     for (const shared_ptr<Global>& glob : Sim->globals)
       if (glob->isInteraction(part))
@@ -113,11 +248,6 @@ namespace dynamo {
     
     for (const size_t id2 : *ids)
       addLocalEvent(part, id2);
-
-    //Now add the interaction events
-    ids = getParticleNeighbours(part);
-    for (const size_t id2 : *ids)
-      addInteractionEvent(part, id2);
   }
 
   shared_ptr<Scheduler>
@@ -218,6 +348,10 @@ namespace dynamo {
 
     if (next_event._type == RECALCULATE)
       {
+	//Count the events generated by overflowing PELs
+	if (next_event._source == SCHEDULER)
+	  ++_recalculateCount;
+
 	if (next_event._particle1ID == systemParticleID)
 	  rebuildSystemEvents();
 	else
@@ -267,7 +401,7 @@ namespace dynamo {
 	  //events to change). This also gives us more information on
 	  //the event.
 	  Sim->dynamics->updateParticlePair(p1, p2);
-	  const Event Event = Sim->getEvent(p1, p2);
+	  const Event Event = _fastKernel ? _fastKernel->getEvent(p1, p2) : Sim->getEvent(p1, p2);
 	
 	  //Now check if the recalculated event is still the first
 	  //event in the FEL. If not, force a recalculation of this
@@ -317,7 +451,9 @@ namespace dynamo {
 	  //Allow everything to stream up to the current time before executing the event
 	  Sim->stream(Event._dt);
 	  
-	  PairEventData eventdata = Sim->interactions[Event._sourceID]->runEvent(p1, p2, Event);
+	  //The event data is converted once, rather than for the
+	  //signal and every output plugin
+	  const NEventData eventdata(Sim->interactions[Event._sourceID]->runEvent(p1, p2, Event));
 	  
 	  Sim->_sigParticleUpdate(eventdata);
 	  Sim->ptrScheduler->fullUpdate(p1, p2);
@@ -386,7 +522,7 @@ namespace dynamo {
 	  //dynamics must be updated first
 	  Sim->stream(iEvent._dt);
 	
-	  const ParticleEventData data = Sim->locals[localID]->runEvent(part, iEvent);
+	  const NEventData data(Sim->locals[localID]->runEvent(part, iEvent));
 	  Sim->_sigParticleUpdate(data);	  
 	  Sim->ptrScheduler->fullUpdate(part);
 	  for (shared_ptr<OutputPlugin> & Ptr : Sim->outputPlugins)
@@ -443,7 +579,63 @@ namespace dynamo {
     Particle& part1(Sim->particles[part.getID()]);
     Particle& part2(Sim->particles[id]);
     Sim->dynamics->updateParticle(part2);
-    sorter->push(Sim->getEvent(part1, part2));
+    sorter->push(_fastKernel ? _fastKernel->getEvent(part1, part2) : Sim->getEvent(part1, part2));
+  }
+
+  void
+  Scheduler::addInteractionEvents(const Particle& part, const IDRange& ids) const
+  {
+    const size_t N = ids.size();
+    if (!_parallelPredictionThreshold || (N < _parallelPredictionThreshold)
+	|| !Sim->threads || !Sim->threads->getThreadCount())
+      {
+	if (_fastKernel)
+	  {
+	    _predictionBuffer.resize(N);
+	    _fastKernel->getEvents(part, ids, 0, N, _predictionBuffer.data(), true);
+	    for (size_t i(0); i < N; ++i)
+	      if (ids[i] != part.getID())
+		sorter->push(_predictionBuffer[i]);
+	    return;
+	  }
+
+	for (const size_t id2 : ids)
+	  addInteractionEvent(part, id2);
+	return;
+      }
+
+    //Each task handles a contiguous block of the neighbours. As every
+    //neighbour is only visited by one task, it is safe for the tasks
+    //to update the neighbouring particles to the current time.
+    _predictionBuffer.resize(N);
+    const size_t tasks = Sim->threads->getThreadCount();
+    for (size_t task(0); task < tasks; ++task)
+      Sim->threads->queueTask(std::bind(&Scheduler::predictInteractionEvents, this, std::cref(part), std::cref(ids), task * N / tasks, (task + 1) * N / tasks));
+    Sim->threads->wait();
+
+    for (size_t i(0); i < N; ++i)
+      if (ids[i] != part.getID())
+	sorter->push(_predictionBuffer[i]);
+  }
+
+  void
+  Scheduler::predictInteractionEvents(const Particle& part, const IDRange& ids, size_t begin, size_t end) const
+  {
+    if (_fastKernel)
+      {
+	_fastKernel->getEvents(part, ids, begin, end, _predictionBuffer.data() + begin, true);
+	return;
+      }
+
+    Particle& part1(Sim->particles[part.getID()]);
+    for (size_t i(begin); i < end; ++i)
+      {
+	const size_t id = ids[i];
+	if (id == part.getID()) continue;
+	Particle& part2(Sim->particles[id]);
+	Sim->dynamics->updateParticle(part2);
+	_predictionBuffer[i] = Sim->getEvent(part1, part2);
+      }
   }
 
   void 
@@ -17,7 +17,9 @@
 
 #pragma once
 #include <dynamo/base.hpp>
+#include <dynamo/eventtypes.hpp>
 #include <dynamo/schedulers/sorters/FEL.hpp>
+#include <dynamo/schedulers/fastkernel.hpp>
 #include <magnet/math/vector.hpp>
 #include <magnet/function/delegate.hpp>
 #include <dynamo/ranges/IDRange.hpp>
@@ -40,6 +42,25 @@ namespace dynamo {
     virtual void initialise();
     virtual void initialiseNBlist() = 0;
 
+    /*! \brief Rebuild the event list after a change of the
+        neighbourhood structure (e.g., the neighbour list cells were
+        resized).
+
+	Unlike initialise(), this does not revalidate the state of the
+	whole system unless the ValidateRebuilds attribute is set, as
+	the system state has not changed. Compression runs trigger
+	this many times.
+     */
+    virtual void reinitialise();
+
+    /*! \brief Recalculate all events, loading them into the FEL in
+        bulk.
+
+	If parallel prediction is enabled (see
+	_parallelPredictionThreshold), the interaction events of the
+	particles are calculated on the Simulation ThreadPool. The
+	resulting FEL is identical to the serial calculation.
+     */
     void rebuildList();
   
     /*! \brief Retest for events for a single particle.
@@ -93,9 +114,29 @@ namespace dynamo {
 
     const shared_ptr<FEL>& getSorter() const { return sorter; }
 
+    //! \brief Enable the FastKernel (applied at the next initialise()).
+    void setFastKernel(bool enable) { _useFastKernel = enable; }
+
+    /*! \brief The number of RECALCULATE events caused by the
+        sorter discarding events (e.g., when a PEL overflows).
+     */
+    size_t getRecalculateCount() const { return _recalculateCount; }
+
     void rebuildSystemEvents() const;
 
     void addInteractionEvent(const Particle&, const size_t&) const;
+
+    /*! \brief Add the interaction events of a particle with all of
+        the particles in a range.
+
+	If parallel prediction is enabled (see
+	_parallelPredictionThreshold) and the range is large enough,
+	the events are calculated on the Simulation ThreadPool. The
+	events are written into a buffer slot per neighbour and pushed
+	into the FEL afterwards in the order of the range, so the
+	resulting FEL is identical to the serial calculation.
+     */
+    void addInteractionEvents(const Particle&, const IDRange&) const;
     
     void addLocalEvent(const Particle&, const size_t&) const;
     
@@ -110,6 +151,57 @@ namespace dynamo {
   
     size_t _interactionRejectionCounter;
     size_t _localRejectionCounter;
+    size_t _recalculateCount;
+
+    /*! \brief The minimum neighbourhood size at which interaction
+        events are calculated in parallel (0 disables this).
+
+	This is an opt-in feature, set using the ParallelPrediction
+	attribute of the Scheduler, as all Interaction::getEvent
+	implementations in use must be safe to call concurrently for
+	different particle pairs. It is only used if the Simulation has
+	a ThreadPool with at least one thread. When enabled, the events
+	of all particles are also calculated in parallel by
+	rebuildList().
+    */
+    size_t _parallelPredictionThreshold;
+
+    /*! \brief If a specialised FastKernel is used for the
+        interaction events, when one matches the configuration.
+
+	This is an opt-in feature, set using the FastKernel attribute
+	of the Scheduler.
+    */
+    bool _useFastKernel;
+
+    //! \brief The FastKernel in use (if any).
+    shared_ptr<FastKernel> _fastKernel;
+
+    //! \brief The buffer the parallel event predictions are written into.
+    mutable std::vector<Event> _predictionBuffer;
+
+    /*! \brief If the system state is validated on every
+        reinitialise() call, and not just on initialise().
+    */
+    bool _validateRebuilds;
+
+    void validateConfiguration();
+    //! \brief The interaction events of a contiguous block of particles.
+    struct PredictionBlock
+    {
+      std::vector<Event> events;
+      //! \brief The end of the events of each particle in events.
+      std::vector<size_t> ends;
+    };
+
+    //! \brief The buffers of each task of a parallel rebuild.
+    mutable std::vector<PredictionBlock> _rebuildBlocks;
+
+    void addGlobalAndLocalEvents(const Particle&);
+    void addAllEventsParallel();
+    void predictParticleEvents(size_t, size_t, size_t) const;
+    void predictInteractionEvents(const Particle&, const IDRange&, size_t, size_t) const;
+    void outputAttributesXML(magnet::xml::XmlStream&) const;
 
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   };
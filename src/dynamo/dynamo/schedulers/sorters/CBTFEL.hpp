@@ -18,16 +18,36 @@
 #pragma once
 #include <dynamo/eventtypes.hpp>
 #include <dynamo/schedulers/sorters/FEL.hpp>
+#include <magnet/containers/small_vector.hpp>
 #include <magnet/exception.hpp>
 #include <magnet/xmlwriter.hpp>
+#include <algorithm>
 #include <vector>
 #include <cmath>
 
 namespace dynamo {
-  template<class PEL>
+  /*! \brief A Complete Binary Tree (CBT) sorting the Particle Event
+      Lists.
+
+    By default, invalidate() only clears the PEL of the invalidated
+    particle, and the events of other particles which involve it are
+    discarded lazily when they reach the top of the queue. In dense
+    systems, these stale events fill the (bounded) PELs, causing
+    overflows and RECALCULATE events.
+
+    \tparam PartialInvalidation If set, a reverse index of the PELs
+    which may contain an interaction event with each particle is
+    maintained, and invalidate() purges these events eagerly. This
+    requires the PEL to support partial invalidation.
+   */
+  template<class PEL, bool PartialInvalidation = false>
   class CBTFEL: public FEL
   {
+    static_assert(!PartialInvalidation || PEL::partial_invalidate_support, 
+		  "Partial invalidation requires a PEL which supports it");
   public:
+    CBTFEL(): _activeID(std::numeric_limits<size_t>::max()), _bulkLoading(false), _staleEventCount(0) {}
+
     virtual void init(const size_t N) 
     {
       clear();
@@ -36,6 +56,8 @@ namespace dynamo {
       _Leaf.resize(N + 1, std::numeric_limits<size_t>::max());
       _Min.resize(N + 1);
       _eventCount.resize(N, 0);
+      if (PartialInvalidation)
+	_partners.resize(N);
     }
 
     void clear()
@@ -49,7 +71,33 @@ namespace dynamo {
       _streamFreq = 0;
       _nUpdate = 0; 
       _activeID = std::numeric_limits<size_t>::max();
+      _bulkLoading = false;
       _eventCount.clear();
+      _partners.clear();
+    }
+
+    virtual void beginBulkLoad()
+    {
+      flushChanges();
+      if (_NP)
+	M_throw() << "Bulk loads are only possible into an empty FEL";
+      _bulkLoading = true;
+    }
+
+    /*! \brief Build the tree from all of the loaded PELs at once.
+     */
+    virtual void endBulkLoad()
+    {
+      _bulkLoading = false;
+      _activeID = std::numeric_limits<size_t>::max();
+
+      std::vector<size_t> leaves;
+      leaves.reserve(_N);
+      for (size_t i(1); i <= _N; ++i)
+	if (!_Min[i].empty() && (_Min[i].top()._dt != std::numeric_limits<float>::infinity()))
+	  leaves.push_back(i);
+
+      BuildCBT(leaves);
     }
 
     inline void stream(const double dt)
@@ -72,6 +120,9 @@ namespace dynamo {
       _Min[ID+1].clear();
       //Catch the others with lazy deletion.
       ++_eventCount[ID];
+      //Or purge them now, if they are indexed.
+      if (PartialInvalidation)
+	purgePartnerEvents(ID);
     }
 
     inline void pop() {
@@ -86,6 +137,7 @@ namespace dynamo {
       //Check for lazy deletion of the next event
       Event next_event = _Min[_CBT[1]].top();
       while ((next_event._source == INTERACTION) && (next_event._particle2eventcounter != _eventCount[next_event._particle2ID])) {
+	++_staleEventCount;
 	pop();
 	flushChanges();
 	if (_CBT.empty() || _Min[_CBT[1]].empty()) return true;
@@ -117,7 +169,9 @@ namespace dynamo {
 	event._dt += _pecTime;
 	if (event._source == INTERACTION)
 	  event._particle2eventcounter = _eventCount[event._particle2ID];
-	_Min[event._particle1ID + 1].push(event);
+	//Only index the events the PEL keeps
+	if (_Min[event._particle1ID + 1].push(event) && PartialInvalidation && (event._source == INTERACTION))
+	  addPartner(event._particle2ID, event._particle1ID);
       }
     }
 
@@ -128,10 +182,16 @@ namespace dynamo {
       _pecTime *= factor;
     }
 
+    virtual size_t getStaleEventCount() const { return _staleEventCount; }
+
     protected:
     size_t _activeID;
+    //! \brief Set while the tree is not maintained during a bulk load.
+    bool _bulkLoading;
 
     virtual void flushChanges(const size_t ID = std::numeric_limits<size_t>::max()) {
+      if (_bulkLoading) return;
+
       if ((_activeID != ID) && (_activeID !=std::numeric_limits<size_t>::max()))
 	{
 	  if (_Min[_activeID + 1].empty() || (_Min[_activeID + 1].top()._dt == std::numeric_limits<float>::infinity())) {
@@ -159,6 +219,44 @@ namespace dynamo {
   
     std::vector<size_t> _eventCount;
 
+    /*! \brief The reverse index of the interaction events.
+
+      For each particle, the IDs of the particles whose PELs may hold
+      an interaction event with it. Entries are only removed when the
+      particle is invalidated, so this may also list PELs where the
+      event has since been popped, discarded or cleared.
+     */
+    std::vector<magnet::containers::SmallVector<size_t, 4> > _partners;
+    size_t _staleEventCount;
+
+    inline void addPartner(const size_t ID, const size_t partnerID)
+    {
+      auto& partners = _partners[ID];
+      if (std::find(partners.begin(), partners.end(), partnerID) == partners.end())
+	partners.push_back(partnerID);
+    }
+
+    /*! \brief Remove the interaction events with a particle from
+        the PELs of the other particles.
+     */
+    inline void purgePartnerEvents(const size_t ID)
+    {
+      auto& partners = _partners[ID];
+      for (const size_t partnerID : partners)
+	{
+	  PEL& pel = _Min[partnerID + 1];
+	  const Event& top = pel.top();
+	  //The position of the PEL in the tree only changes if its
+	  //next event is removed
+	  if ((top._source == INTERACTION) && (top._particle2ID == ID))
+	    flushChanges(partnerID);
+	  pel.invalidate(ID);
+	}
+      partners.clear();
+      //Leave the FEL in the state expected after invalidate(ID)
+      flushChanges(ID);
+    }
+
     ///////////////////////////BINARY TREE IMPLEMENTATION
     inline void UpdateCBT(const size_t i)
     {
@@ -186,6 +284,40 @@ namespace dynamo {
     }
 
 
+    /*! \brief Build the tree bottom-up from a set of (uninserted)
+        PEL indices.
+
+      The leaves are placed in the bottom level of the tree and each
+      internal node is then filled with the winner of its two
+      children. This is O(N), compared to the O(N log N) of inserting
+      each PEL in turn. The tree must be empty before this is called.
+     */
+    inline void BuildCBT(const std::vector<size_t>& leaves)
+    {
+      _NP = leaves.size();
+      if (!_NP) return;
+
+      if (_NP == 1)
+	{
+	  _CBT[1] = leaves[0];
+	  _Leaf[leaves[0]] = 1;
+	  return;
+	}
+
+      for (size_t j(0); j < _NP; ++j)
+	{
+	  _CBT[_NP + j] = leaves[j];
+	  _Leaf[leaves[j]] = _NP + j;
+	}
+
+      for (size_t f(_NP - 1); f > 0; --f)
+	{
+	  const size_t l = _CBT[f*2],
+	    r = _CBT[f*2+1];
+	  _CBT[f] = (_Min[r] > _Min[l]) ? l : r;
+	}
+    }
+
     inline void Insert(const size_t i)
     {
       if (_NP)
@@ -238,6 +370,6 @@ namespace dynamo {
     }
 
     virtual void outputXML(magnet::xml::XmlStream& XML) const
-    { XML << magnet::xml::attr("Type") << (std::string("CBT") + PEL::name()); }
+    { XML << magnet::xml::attr("Type") << (std::string(PartialInvalidation ? "CBTIndexed" : "CBT") + PEL::name()); }
     };
   }
@@ -44,9 +44,27 @@ namespace dynamo {
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<7> >());
     if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQMinMax8"))
       return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<8> >());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedHeap"))
+      return shared_ptr<FEL>(new BoundedPQFEL<HeapPEL, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax2"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<2>, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax3"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<3>, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax4"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<4>, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax5"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<5>, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax6"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<6>, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax7"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<7>, true>());
+    if (std::string(XML.getAttribute("Type")) == std::string("BoundedPQIndexedMinMax8"))
+      return shared_ptr<FEL>(new BoundedPQFEL<MinMaxPEL<8>, true>());
     else if ((std::string(XML.getAttribute("Type")) == std::string("CBT"))
 	     || (std::string(XML.getAttribute("Type")) == std::string("CBTHeap")))
       return shared_ptr<FEL>(new CBTFEL<HeapPEL>());
+    else if (std::string(XML.getAttribute("Type")) == std::string("CBTIndexedHeap"))
+      return shared_ptr<FEL>(new CBTFEL<HeapPEL, true>());
     else 
       M_throw() << "Unknown type of Sorter encountered";
   }
@@ -91,10 +91,30 @@ namespace dynamo {
      */
     virtual void push(Event event) = 0;
 
+    /*! \brief Begin loading a large number of events into an empty
+        FEL.
+
+      Between this call and endBulkLoad(), only push() and
+      invalidate() may be called. The FEL may defer sorting the
+      events until endBulkLoad(), where it can be done in a single
+      pass instead of one update per particle. The default
+      implementation sorts the events as they are pushed.
+     */
+    virtual void beginBulkLoad() {}
+
+    /*! \brief Finish a bulk load, leaving the FEL in a sorted state.
+     */
+    virtual void endBulkLoad() {}
+
     virtual void rescaleTimes(const double) = 0;
     virtual void stream(const double) = 0;
     
     virtual Event top() = 0;
+
+    /*! \brief The number of invalid events which reached the top of
+        the queue and were discarded (lazy deletion).
+     */
+    virtual size_t getStaleEventCount() const { return 0; }
  
     static shared_ptr<FEL> getClass(const magnet::xml::Node&);
     friend ::magnet::xml::XmlStream& operator<<(::magnet::xml::XmlStream&, const FEL&);
@@ -18,6 +18,7 @@
 #pragma once
 #include <dynamo/eventtypes.hpp>
 #include <magnet/containers/MinMaxHeap.hpp>
+#include <array>
 #include <string>
 
 namespace dynamo {
@@ -33,22 +34,26 @@ namespace dynamo {
   {
     magnet::containers::MinMaxHeap<Event, Size> _store;
   public:
-    static const bool partial_invalidate_support = false;
+    static const bool partial_invalidate_support = true;
 
     MinMaxPEL() {
       clear();
     }
 
-    inline void push(const Event& e) {
+    //! \brief Add an event, returning false if it was discarded.
+    inline bool push(const Event& e) {
       if (!_store.full())
-	_store.insert(e);
-      else 
 	{
-	  if (e < _store.bottom())
-	    _store.replaceMax(e);
-	  _store.unsafe_bottom()._type = RECALCULATE;
-	  _store.unsafe_bottom()._source = SCHEDULER;
+	  _store.insert(e);
+	  return true;
 	}
+
+      const bool stored = e < _store.bottom();
+      if (stored)
+	_store.replaceMax(e);
+      _store.unsafe_bottom()._type = RECALCULATE;
+      _store.unsafe_bottom()._source = SCHEDULER;
+      return stored;
     }
 
     inline void clear() {
@@ -60,6 +65,25 @@ namespace dynamo {
       return _store.size();
     }
 
+    /*! \brief Remove all interaction events with the particle ID.
+
+      The heap is small, so it is simply rebuilt from the remaining
+      events.
+     */
+    inline void invalidate(const size_t ID) {
+      std::array<Event, Size> kept;
+      size_t nkept(0);
+      for (const Event& event : _store)
+	if ((event._source != INTERACTION) || (event._particle2ID != ID))
+	  kept[nkept++] = event;
+
+      if (nkept == _store.size()) return;
+
+      clear();
+      for (size_t i(0); i < nkept; ++i)
+	_store.insert(kept[i]);
+    }
+
     inline bool empty() const {
       return _store.empty();
     }
@@ -37,10 +37,10 @@ namespace dynamo {
     };
   }
 
-  template<typename PEL>
-  class BoundedPQFEL: public CBTFEL<detail::BPQEntry<PEL> >
+  template<typename PEL, bool PartialInvalidation = false>
+  class BoundedPQFEL: public CBTFEL<detail::BPQEntry<PEL>, PartialInvalidation>
   {
-    typedef CBTFEL<detail::BPQEntry<PEL> > Base;
+    typedef CBTFEL<detail::BPQEntry<PEL>, PartialInvalidation> Base;
   private:
     //Bounded priority queue variables and types
 
@@ -92,8 +92,29 @@ namespace dynamo {
       scale /= factor;
     }
 
+    /*! \brief Sort all of the loaded PELs into the queue at once.
+
+      The PELs falling into the current list are collected and built
+      into the CBT in a single pass.
+     */
+    virtual void endBulkLoad()
+    {
+      Base::_bulkLoading = false;
+      Base::_activeID = std::numeric_limits<size_t>::max();
+
+      std::vector<size_t> leaves;
+      leaves.reserve(Base::_N);
+      for (size_t i(1); i <= Base::_N; ++i)
+	insertInEventQ(i, &leaves);
+
+      Base::BuildCBT(leaves);
+      orderNextEvent();
+    }
+
   private: 
     virtual void flushChanges(const size_t ID = std::numeric_limits<size_t>::max()) {
+      if (Base::_bulkLoading) return;
+
       if ((Base::_activeID != ID) && (Base::_activeID !=std::numeric_limits<size_t>::max()))
 	{
 	  ////Optimise the queue settings every 10^6 events or so
@@ -150,7 +171,13 @@ namespace dynamo {
 
 
     ///////////////////////////BOUNDED QUEUE IMPLEMENTATION
-    inline void insertInEventQ(const size_t p)
+    /*! \brief Insert a PEL into the bounded priority queue.
+
+      If pqLeaves is set, PELs which belong in the current CBT are
+      appended to it instead of being inserted, so the CBT can be
+      built in bulk.
+     */
+    inline void insertInEventQ(const size_t p, std::vector<size_t>* pqLeaves = NULL)
     {
 #ifdef DYNAMO_DEBUG
       if (p >= Base::_Min.size())
@@ -192,7 +219,12 @@ namespace dynamo {
       Base::_Min[p].qIndex=i;
 
       if(i == currentIndex)
-	Base::Insert(p); /* insert in PQ */
+	{
+	  if (pqLeaves)
+	    pqLeaves->push_back(p); /* defer the insert in PQ */
+	  else
+	    Base::Insert(p); /* insert in PQ */
+	}
       else
 	{
 	  /* insert in linked list */
@@ -284,7 +316,7 @@ namespace dynamo {
 
   
     virtual void outputXML(magnet::xml::XmlStream& XML) const { 
-      XML << magnet::xml::attr("Type") << (std::string("BoundedPQ") + PEL::name()); 
+      XML << magnet::xml::attr("Type") << (std::string(PartialInvalidation ? "BoundedPQIndexed" : "BoundedPQ") + PEL::name()); 
     }
 
   };
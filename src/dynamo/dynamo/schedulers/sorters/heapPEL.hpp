@@ -25,11 +25,12 @@ namespace dynamo {
   class HeapPEL {
     std::vector<Event> _store;
   public:
-    static const bool partial_invalidate_support = false;
+    static const bool partial_invalidate_support = true;
     
-    inline void push(Event e) {
+    inline bool push(Event e) {
       _store.push_back(e);
       std::push_heap(_store.begin(), _store.end(), std::greater<Event>());
+      return true;
     }
 
     inline void clear() {
@@ -40,6 +41,15 @@ namespace dynamo {
       return _store.size();
     }
 
+    /*! \brief Remove all interaction events with the particle ID. */
+    inline void invalidate(const size_t ID) {
+      auto it = std::remove_if(_store.begin(), _store.end(), [=](const Event& event)
+			       { return (event._source == INTERACTION) && (event._particle2ID == ID); });
+      if (it == _store.end()) return;
+      _store.erase(it, _store.end());
+      std::make_heap(_store.begin(), _store.end(), std::greater<Event>());
+    }
+
     inline bool empty() const {
       return _store.empty();
     }
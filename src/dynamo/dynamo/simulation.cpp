@@ -48,6 +48,7 @@ namespace dynamo
     nextPrintEvent(0),
     primaryCellSize({1,1,1}),
     ranGenerator(std::random_device()()),
+    threads(NULL),
     lastRunMFT(0.0),
     simID(0),
     stateID(0),
@@ -90,6 +91,11 @@ namespace dynamo
   {
     if (status != START)
       M_throw() << "Sim initialised at wrong time";
+
+    //Streams not restored from the configuration file take their seed
+    //from the main generator, so --random-seed controls them too
+    if (!randomStreams.isSeeded())
+      randomStreams.seed(std::uniform_int_distribution<uint64_t>()(ranGenerator));
     
     for (shared_ptr<Species>& ptr : species)
       ptr->initialise();
@@ -408,6 +414,9 @@ namespace dynamo
 	  systems.push_back(System::getClass(node, this));
       }
 
+    if (simNode.hasNode("RandomStreams"))
+      randomStreams << simNode.getNode("RandomStreams");
+
     ptrScheduler = Scheduler::getClass(simNode.getNode("Scheduler"), this);
   
     //Fixes or conversions once system is loaded
@@ -505,6 +514,7 @@ namespace dynamo
       	<< xml::tag("Dynamics")
 	<< dynamics
 	<< xml::endtag("Dynamics")
+	<< randomStreams
 	<< xml::endtag("Simulation")
 	<< _properties;
 
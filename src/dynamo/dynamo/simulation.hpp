@@ -22,10 +22,13 @@
 #include <dynamo/ensemble.hpp>
 #include <dynamo/property.hpp>
 #include <dynamo/units/units.hpp>
+#include <dynamo/randomstreams.hpp>
 #include <magnet/function/delegate.hpp>
 #include <random>
 #include <vector>
 
+namespace magnet { namespace thread { class ThreadPool; } }
+
 namespace dynamo
 {  
   class Scheduler;
@@ -360,6 +363,20 @@ namespace dynamo
 
     /*! \brief The random number generator of the system. */
     mutable baseRNG ranGenerator;
+
+    /*! \brief The independent, checkpointed random number streams
+        of the system (see RandomStreams).
+     */
+    RandomStreams randomStreams;
+
+    /*! \brief A ThreadPool which may be used to parallelise the work
+        of this Simulation.
+
+      This is NULL if the Simulation must run serially, e.g., when
+      the engine is already using the pool to run several
+      Simulations concurrently.
+     */
+    magnet::thread::ThreadPool* threads;
     
     /*! \brief The collection of OutputPlugin's operating on this system.
      */
@@ -31,6 +31,7 @@ namespace dynamo {
   {
     range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"), Sim));
     _mass = Sim->_properties.getProperty(XML.getAttribute("Mass"), Property::Units::Mass());
+    _massColumn = _mass->getColumn();
     spName = XML.getAttribute("Name");
   }
 
@@ -36,7 +36,7 @@ namespace dynamo {
     virtual ~Species();
 
     inline bool isSpecies(const Particle& p1) const { return range->isInRange(p1); }  
-    inline const double getMass(size_t ID) const { return _mass->getProperty(ID); }
+    inline const double getMass(size_t ID) const { return _massColumn(ID); }
     inline unsigned long getCount() const { return range->size(); }
     inline unsigned int getID() const { return ID; }
     inline const std::string& getName() const { return spName; }
@@ -60,6 +60,7 @@ namespace dynamo {
     Species(dynamo::Simulation* tmp, std::string name, IDRange* nr, T1 mass, std::string nName, unsigned int nID):
       SimBase(tmp, name),
       _mass(Sim->_properties.getProperty(mass, Property::Units::Mass())),
+      _massColumn(_mass->getColumn()),
       range(nr),
       spName(nName),
       ID(nID)
@@ -68,6 +69,8 @@ namespace dynamo {
     virtual void outputXML(magnet::xml::XmlStream&) const = 0;
   
     shared_ptr<Property> _mass;
+    //! \brief Direct access to the masses, rebound whenever _mass is set.
+    PropertyColumn _massColumn;
     shared_ptr<IDRange> range;
     std::string spName;
     unsigned int ID;
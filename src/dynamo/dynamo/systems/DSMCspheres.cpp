@@ -32,7 +32,8 @@
 namespace dynamo {
   SysDSMCSpheres::SysDSMCSpheres(const magnet::xml::Node& XML, dynamo::Simulation* tmp): 
     System(tmp),
-    maxprob(0.0)
+    maxprob(0.0),
+    _rng(NULL)
   {
     dt = std::numeric_limits<float>::infinity();
     operator<<(XML);
@@ -49,7 +50,8 @@ namespace dynamo {
     maxprob(0.0),
     e(ne),
     range1(r1),
-    range2(r2)
+    range2(r2),
+    _rng(NULL)
   {
     sysName = nName;
     type = DSMC;
@@ -59,28 +61,33 @@ namespace dynamo {
   SysDSMCSpheres::runEvent()
   {
     dt = tstep;
-    std::normal_distribution<> norm_sampler;
-    std::uniform_real_distribution<> uniform_sampler;
-    std::uniform_int_distribution<size_t> id1sampler(0, range1->size() - 1);
-    std::uniform_int_distribution<size_t> id2sampler(0, range2->size() - 1);
         
     //Find the likely maximum number of interacting pairs. The
     //addition of the random variable is a neat way to randomly pick
     //an extra pair to, on average, pick the correct number of
     //fractional pairs (thanks Severin!)
-    const size_t nmax = static_cast<size_t>(0.5 * maxprob * range1->size() + uniform_sampler(Sim->ranGenerator));
+    const size_t nmax = static_cast<size_t>(0.5 * maxprob * range1->size() + _rng->uniform());
+
+    //Draw the random numbers for all of the candidate pairs at once:
+    //two particle indices, a direction and an acceptance variate each.
+    _indices.resize(2 * nmax);
+    _normals.resize(NDIM * nmax);
+    _uniforms.resize(nmax);
+    _rng->generate(_indices.data(), _indices.size());
+    _rng->normal(_normals.data(), _normals.size());
+    _rng->uniform(_uniforms.data(), _uniforms.size());
 
     NEventData retval;
 
     for (size_t n = 0; n < nmax; ++n)
       {
-	Particle& p1(Sim->particles[*(range1->begin() + id1sampler(Sim->ranGenerator))]);
+	Particle& p1(Sim->particles[*(range1->begin() + magnet::math::Philox::toIndex(_indices[2 * n], range1->size()))]);
 	
-	size_t p2id = *(range2->begin() + id2sampler(Sim->ranGenerator));
+	size_t p2id = *(range2->begin() + magnet::math::Philox::toIndex(_indices[2 * n + 1], range2->size()));
 	
 	//Find another particle which is not p1
 	while (p2id == p1.getID())
-	  p2id = *(range2->begin()+id2sampler(Sim->ranGenerator));
+	  p2id = *(range2->begin() + magnet::math::Philox::toIndex((*_rng)(), range2->size()));
 	
 	Particle& p2(Sim->particles[p2id]);
 	
@@ -88,12 +95,12 @@ namespace dynamo {
       
 	Vector rij;
 	for (size_t iDim(0); iDim < NDIM; ++iDim)
-	  rij[iDim] = norm_sampler(Sim->ranGenerator);
+	  rij[iDim] = _normals[NDIM * n + iDim];
 	
 	//This is the extra diameter term missing from the "factor" variable
 	rij *= diameter / rij.nrm();
       
-	if (Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij))
+	if (Sim->dynamics->DSMCSpheresTest(p1, p2, maxprob, factor, rij, _uniforms[n]))
 	  {
 	    ++Sim->eventCount;
 	    retval.L2partChanges.push_back(PairEventData(Sim->dynamics->DSMCSpheresRun(p1, p2, e, rij)));
@@ -107,6 +114,7 @@ namespace dynamo {
   {
     ID = nID;
     dt = tstep;
+    _rng = &Sim->randomStreams(RandomStreams::SYSTEM, ID);
 
     //An extra factor of diameter is missing here, which is used to
     //give the vector rij below and in runEvent the "correct"
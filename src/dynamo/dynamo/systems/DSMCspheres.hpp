@@ -19,6 +19,8 @@
 #include <dynamo/systems/system.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/ranges/IDRange.hpp>
+#include <magnet/math/philox.hpp>
+#include <vector>
 
 namespace dynamo {
   class SysDSMCSpheres: public System
@@ -47,5 +49,11 @@ namespace dynamo {
 
     shared_ptr<IDRange> range1;
     shared_ptr<IDRange> range2;
+
+    //! \brief The named stream of this System, in Simulation::randomStreams.
+    magnet::math::Philox* _rng;
+    std::vector<uint32_t> _indices;
+    std::vector<double> _normals;
+    std::vector<double> _uniforms;
   };
 }
@@ -28,6 +28,7 @@
 #include <dynamo/outputplugins/outputplugin.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
+#include <algorithm>
 
 namespace dynamo {
 
@@ -41,7 +42,10 @@ namespace dynamo {
     setPoint(0.05),
     eventCount(0),
     lastlNColl(0),
-    setFrequency(100)
+    setFrequency(100),
+    _restored(false),
+    batch(1),
+    _rng(NULL)
   {
     dt = std::numeric_limits<float>::infinity();
     operator<<(XML);
@@ -58,6 +62,9 @@ namespace dynamo {
     eventCount(0),
     lastlNColl(0),
     setFrequency(100),
+    _restored(false),
+    batch(1),
+    _rng(NULL),
     range(new IDRangeAll(Sim))
   {
     sysName = nName;
@@ -68,26 +75,84 @@ namespace dynamo {
   SysAndersen::runEvent()
   {
     ++Sim->eventCount;
-    ++eventCount;
+    //The tuning counts thermalisations, not events, so that a batched
+    //thermostat is tuned to the same coupling as an unbatched one.
+    eventCount += batch;
 
     if (tune && (eventCount > setFrequency))
       {
-	meanFreeTime *= static_cast<double>(eventCount) / ((Sim->eventCount - lastlNColl) * setPoint);
+	//Each of the eventCount / batch thermostat events is counted
+	//as batch events, as if the particles were thermalised singly.
+	const size_t events = Sim->eventCount - lastlNColl + eventCount - eventCount / batch;
+	meanFreeTime *= static_cast<double>(eventCount) / (events * setPoint);
 	lastlNColl = Sim->eventCount;
 	eventCount = 0;
       }
 
     dt = getGhostt();
-    const size_t step = std::uniform_int_distribution<size_t>(0, range->size() - 1)(Sim->ranGenerator);
-    return Sim->dynamics->randomGaussianEvent(Sim->particles[*(range->begin() + step)], sqrtTemp, dimensions);
+
+    if (batch == 1)
+      {
+	const size_t step = std::uniform_int_distribution<size_t>(0, range->size() - 1)(Sim->ranGenerator);
+	return Sim->dynamics->randomGaussianEvent(Sim->particles[*(range->begin() + step)], sqrtTemp, dimensions);
+      }
+
+    //Draw all of the random numbers for the batch at once. The
+    //dimensions may have changed in a replica exchange.
+    _normals.resize(batch * dimensions);
+    _rng->generate(_indices.data(), batch);
+    _rng->normal(_normals.data(), _normals.size());
+
+    //The particles of a batch must be distinct, as the event data of
+    //a particle is only valid if it is changed once per event.
+    for (size_t i(0); i < batch; ++i)
+      {
+	_selected[i] = magnet::math::Philox::toIndex(_indices[i], range->size());
+	while (std::find(_selected.begin(), _selected.begin() + i, _selected[i]) != _selected.begin() + i)
+	  _selected[i] = magnet::math::Philox::toIndex((*_rng)(), range->size());
+      }
+
+    NEventData retval;
+    for (size_t i(0); i < batch; ++i)
+      {
+	Vector normals{0, 0, 0};
+	for (size_t iDim(0); iDim < dimensions; ++iDim)
+	  normals[iDim] = _normals[i * dimensions + iDim];
+
+	retval += Sim->dynamics->randomGaussianEvent(Sim->particles[*(range->begin() + _selected[i])], sqrtTemp, normals, dimensions);
+      }
+    return retval;
   }
 
   void 
   SysAndersen::initialise(size_t nID)
   {
     ID = nID;
-    dt = getGhostt();
+
+    if (batch == 0)
+      M_throw() << "The Batch size of the Andersen thermostat \"" << sysName << "\" must be at least one";
+
+    if (batch > range->size())
+      M_throw() << "The Batch size of the Andersen thermostat \"" << sysName << "\" is larger than the number of particles it acts on";
+
+    if (batch > 1)
+      {
+	_selected.resize(batch);
+	_rng = &Sim->randomStreams(RandomStreams::SYSTEM, ID);
+	_indices.resize(batch);
+      }
+
     sqrtTemp = sqrt(Temp);
+
+    //Continue the pending event of a loaded configuration, but only
+    //on the first initialisation.
+    if (_restored)
+      {
+	_restored = false;
+	return;
+      }
+
+    dt = getGhostt();
     eventCount = 0;
     lastlNColl = 0;
   }
@@ -102,6 +167,9 @@ namespace dynamo {
     if (XML.hasAttribute("Dimensions"))
       dimensions = XML.getAttribute("Dimensions").as<size_t>();
 
+    if (XML.hasAttribute("Batch"))
+      batch = XML.getAttribute("Batch").as<size_t>();
+
     if (XML.hasAttribute("SetFrequency") && XML.hasAttribute("SetPoint"))
       {
 	tune = true;
@@ -109,6 +177,21 @@ namespace dynamo {
 	setPoint = XML.getAttribute("SetPoint").as<double>();
       }
 
+    if (XML.hasAttribute("NextEvent"))
+      {
+	_restored = true;
+	dt = XML.getAttribute("NextEvent").as<double>() * Sim->units.unitTime();
+
+	if (XML.hasAttribute("EventCount"))
+	  eventCount = XML.getAttribute("EventCount").as<size_t>();
+
+	//The simulation event counter restarts from zero, so the
+	//events since the last tuning are stored instead. The unsigned
+	//arithmetic wraps consistently.
+	if (XML.hasAttribute("EventsSinceTune"))
+	  lastlNColl = Sim->eventCount - XML.getAttribute("EventsSinceTune").as<size_t>();
+      }
+
     range = shared_ptr<IDRange>(IDRange::getClass(XML.getNode("IDRange"),Sim));
   }
 
@@ -129,6 +212,19 @@ namespace dynamo {
     if (dimensions != NDIM)
       XML << magnet::xml::attr("Dimensions") << dimensions;
 
+    if (batch != 1)
+      XML << magnet::xml::attr("Batch") << batch;
+
+    //The pending event only exists once the thermostat is initialised
+    if (Sim->status >= INITIALISED)
+      {
+	XML << magnet::xml::attr("NextEvent") << dt / Sim->units.unitTime();
+	
+	if (tune)
+	  XML << magnet::xml::attr("EventCount") << eventCount
+	      << magnet::xml::attr("EventsSinceTune") << Sim->eventCount - lastlNColl;
+      }
+
     XML << range
 	<< magnet::xml::endtag("System");
   }
@@ -136,6 +232,9 @@ namespace dynamo {
   double 
   SysAndersen::getGhostt() const
   { 
+    if (batch > 1)
+      return - meanFreeTime * batch * std::log(1.0 - _rng->uniform());
+
     return  - meanFreeTime * std::log(1.0 - std::uniform_real_distribution<>()(Sim->ranGenerator));
   }
 
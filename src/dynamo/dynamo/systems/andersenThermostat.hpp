@@ -19,8 +19,37 @@
 #include <dynamo/systems/system.hpp>
 #include <dynamo/simulation.hpp>
 #include <dynamo/ranges/IDRange.hpp>
+#include <magnet/math/philox.hpp>
+#include <vector>
 
 namespace dynamo {
+  /*! \brief An Andersen thermostat, which reassigns the velocities of
+      randomly selected particles from the Maxwell-Boltzmann
+      distribution.
+
+    Each event normally thermalises a single particle, so the
+    thermostat schedules N events per mean free time. If Batch is set
+    larger than one, each event instead thermalises Batch distinct,
+    randomly selected particles and the events are Batch times less frequent,
+    so each particle is thermalised at the same rate and the
+    stationary distribution is unchanged. When the MFT is tuned
+    (SetFrequency and SetPoint), the SetPoint is the fraction of
+    events which are thermalisations, counting each batch as Batch
+    events, so the tuned coupling does not depend on the Batch size
+    either. The random numbers of a batch are drawn in bulk from a
+    named stream of the Simulation::randomStreams.
+
+    The time until the next event (NextEvent) and the counters of the
+    MFT tuning are saved in the configuration, so that together with
+    the random streams a restarted simulation continues the same
+    sequence of thermostat events.
+
+    \code
+    <System Type="Andersen" Name="Thermostat" MFT="1.0" Temperature="1.0" Batch="64">
+      <IDRange Type="All"/>
+    </System>
+    \endcode
+   */
   class SysAndersen: public System
   {
   public:
@@ -51,6 +80,8 @@ namespace dynamo {
       std::swap(eventCount, s.eventCount);
       std::swap(lastlNColl, s.lastlNColl);
       std::swap(setFrequency, s.setFrequency);
+      //The Batch size (and its buffers) stays with each replica, as
+      //the MFT is per thermalised particle.
     }
   
   protected:
@@ -63,6 +94,16 @@ namespace dynamo {
     size_t eventCount;
     size_t lastlNColl;
     size_t setFrequency;
+    //! \brief Set if the pending event and the tuning counters were loaded.
+    bool _restored;
+
+    //! \brief The number of particles thermalised per event.
+    size_t batch;
+    //! \brief The named stream of this System, in Simulation::randomStreams.
+    magnet::math::Philox* _rng;
+    std::vector<uint32_t> _indices;
+    std::vector<size_t> _selected;
+    std::vector<double> _normals;
 
     double getGhostt() const;
   
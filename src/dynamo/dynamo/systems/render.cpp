@@ -0,0 +1,161 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef DYNAMO_png_support
+#include <dynamo/systems/render.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/NparticleEventData.hpp>
+#include <dynamo/dynamics/dynamics.hpp>
+#include <dynamo/dynamics/compression.hpp>
+#include <dynamo/interactions/interaction.hpp>
+#include <dynamo/BC/BC.hpp>
+#include <dynamo/units/units.hpp>
+#include <magnet/image/PNG.hpp>
+#include <magnet/string/searchreplace.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+
+namespace dynamo {
+  namespace {
+    //! \brief The colours of the particles of each Interaction.
+    const magnet::image::SphereRenderer::Colour palette[] = {
+      {{220, 50, 47}}, {{38, 139, 210}}, {{133, 153, 0}}, {{181, 137, 0}},
+      {{211, 54, 130}}, {{42, 161, 152}}, {{203, 75, 22}}, {{108, 113, 196}}
+    };
+
+    //! \brief The maximum number of frames waiting to be rendered.
+    const size_t maxQueuedFrames = 4;
+  }
+
+  SysRender::SysRender(dynamo::Simulation* nSim, double period, std::string format,
+		       size_t width, size_t height, Vector viewDirection):
+    System(nSim),
+    _format(format),
+    _frameCounter(0),
+    _renderer(width, height),
+    _viewDirection(viewDirection),
+    _frames(maxQueuedFrames)
+  {
+    if (period <= 0.0)
+      period = 1.0;
+
+    _period = period * Sim->units.unitTime();
+    dt = _period;
+    sysName = "RenderTimer";
+
+    if (_viewDirection.nrm() == 0)
+      M_throw() << "The view direction of the renderer cannot be zero";
+
+    dout << "Rendering set for a period of " << _period / Sim->units.unitTime()
+	 << " at " << width << "x" << height << std::endl;
+  }
+
+  SysRender::~SysRender()
+  {
+    //Wait for the remaining frames to be written out
+    std::exception_ptr error = _frames.finish();
+    if (error)
+      try { std::rethrow_exception(error); }
+      catch (std::exception& e)
+	{ std::cerr << "\nSysRender: Failed to render frames: " << e.what() << std::endl; }
+  }
+
+  void
+  SysRender::initialise(size_t nID)
+  {
+    ID = nID;
+
+    _radii.resize(Sim->N());
+    _colours.resize(Sim->N());
+    double maxRadius = 0;
+    for (const Particle& p : Sim->particles)
+      {
+	const shared_ptr<Interaction>& interaction = Sim->getInteraction(p, p);
+	_radii[p.getID()] = 0.5 * interaction->getGlyphSize(p.getID())[0];
+	_colours[p.getID()] = palette[interaction->getID() % (sizeof(palette) / sizeof(palette[0]))];
+	maxRadius = std::max(maxRadius, _radii[p.getID()]);
+      }
+
+    //Point the camera at the centre of the primary image, with the
+    //y axis up (or the z axis, when looking along y), and fit the
+    //projection of the primary image into the view.
+    Vector up{0, 1, 0};
+    if ((_viewDirection ^ up).nrm() < 1e-8 * _viewDirection.nrm())
+      up = Vector{0, 0, 1};
+    const Vector back = -_viewDirection / _viewDirection.nrm();
+    Vector imageUp = up - (up | back) * back;
+    imageUp /= imageUp.nrm();
+    const Vector right = imageUp ^ back;
+
+    double halfWidth = 0, halfHeight = 0;
+    for (size_t corner(0); corner < 8; ++corner)
+      {
+	Vector r;
+	for (size_t i(0); i < NDIM; ++i)
+	  r[i] = ((corner >> i) & 1 ? 0.5 : -0.5) * Sim->primaryCellSize[i];
+	halfWidth = std::max(halfWidth, std::abs(r | right) + maxRadius);
+	halfHeight = std::max(halfHeight, std::abs(r | imageUp) + maxRadius);
+      }
+
+    const double aspect = double(_renderer.getWidth()) / _renderer.getHeight();
+    _renderer.setView(Vector{0, 0, 0}, _viewDirection, up, 2.1 * std::max(halfWidth, halfHeight * aspect));
+
+    _frames.start([this](Frame& frame) { renderFrame(frame); });
+  }
+
+  NEventData
+  SysRender::runEvent()
+  {
+    dt += _period;
+
+    Sim->dynamics->updateAllParticles();
+
+    Frame frame;
+    frame.filename = magnet::string::search_replace("Render." + _format + ".png", "%COUNT", boost::lexical_cast<std::string>(_frameCounter++));
+    frame.filename = magnet::string::search_replace(frame.filename, "%ID", boost::lexical_cast<std::string>(Sim->stateID));
+
+    //Compressing systems render the current size of the particles
+    frame.radiusFactor = 1;
+    if (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics))
+      frame.radiusFactor = 1 + static_cast<const DynCompression&>(*Sim->dynamics).getGrowthRate() * Sim->systemTime;
+
+    frame.positions.resize(Sim->N());
+    for (const Particle& p : Sim->particles)
+      {
+	Vector pos = p.getPosition();
+	Sim->BCs->applyBC(pos);
+	frame.positions[p.getID()] = pos;
+      }
+
+    //Only holds the simulation if the renderer has fallen behind
+    _frames.push(std::move(frame));
+
+    dout << "Queued RENDER frame " << _frameCounter - 1 << std::endl;
+    return NEventData();
+  }
+
+  void
+  SysRender::renderFrame(const Frame& frame)
+  {
+    _renderer.clear();
+    for (size_t i(0); i < frame.positions.size(); ++i)
+      _renderer.drawSphere(frame.positions[i], frame.radiusFactor * _radii[i], _colours[i]);
+
+    magnet::image::writePNGFile(frame.filename, _renderer.getImage(), _renderer.getWidth(), _renderer.getHeight(), 3);
+  }
+}
+#endif
@@ -0,0 +1,95 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#ifdef DYNAMO_png_support
+#include <dynamo/systems/system.hpp>
+#include <magnet/image/sphere_renderer.hpp>
+#include <magnet/thread/backgroundqueue.hpp>
+#include <vector>
+
+namespace dynamo {
+  /*! \brief A System Event which periodically renders the particles
+      to PNG images, without a display.
+
+    This is intended for producing movies from batch jobs on
+    machines without a display (or an OpenGL context). Each particle
+    is drawn as a sphere of its glyph diameter, coloured by its
+    Interaction, using a magnet::image::SphereRenderer.
+
+    The simulation thread only copies the particle positions into a
+    frame, the rendering and PNG compression are carried out by a
+    background thread. The simulation only waits on the background
+    thread if it falls more than a few frames behind, so frames are
+    never dropped.
+   */
+  class SysRender: public System
+  {
+  public:
+    /*! \param period The simulation time between frames.
+      \param format The file name of the frames, where %COUNT is
+      replaced by the frame number and %ID by the state ID.
+      \param width The width of the images in pixels.
+      \param height The height of the images in pixels.
+      \param viewDirection The direction the orthographic camera looks
+      along.
+     */
+    SysRender(dynamo::Simulation*, double period, std::string format,
+	      size_t width, size_t height, Vector viewDirection);
+
+    ~SysRender();
+
+    virtual NEventData runEvent();
+
+    virtual void initialise(size_t);
+
+    virtual void operator<<(const magnet::xml::Node&) {}
+
+  protected:
+    SysRender(const SysRender&);
+
+    virtual void outputXML(magnet::xml::XmlStream&) const {}
+
+    //! \brief The data of a single frame, to be rendered.
+    struct Frame
+    {
+      std::string filename;
+      std::vector<Vector> positions;
+      //! \brief The scaling of the particle radii (for compressing systems).
+      double radiusFactor;
+    };
+
+    //! \brief Render a frame and write it out (background thread only).
+    void renderFrame(const Frame&);
+
+    double _period;
+    std::string _format;
+    size_t _frameCounter;
+
+    magnet::image::SphereRenderer _renderer;
+    Vector _viewDirection;
+    //! \brief The radius of each particle.
+    std::vector<double> _radii;
+    //! \brief The colour of each particle.
+    std::vector<magnet::image::SphereRenderer::Colour> _colours;
+
+    //! \brief The frames waiting for the background rendering thread.
+    magnet::thread::BackgroundQueue<Frame> _frames;
+  };
+}
+#endif
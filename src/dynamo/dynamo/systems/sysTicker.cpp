@@ -22,6 +22,10 @@
 #include <dynamo/outputplugins/tickerproperty/ticker.hpp>
 #include <dynamo/units/units.hpp>
 #include <dynamo/schedulers/scheduler.hpp>
+#include <dynamo/topology/chain.hpp>
+#include <dynamo/ranges/IDRange.hpp>
+#include <magnet/thread/threadpool.hpp>
+#include <algorithm>
 
 namespace dynamo {
   SysTicker::SysTicker(dynamo::Simulation* nSim, double nPeriod, std::string nName):
@@ -45,14 +49,118 @@ namespace dynamo {
     dt += period;  
     //This is done here as most ticker properties require it
     Sim->dynamics->updateAllParticles();
+
+    std::vector<OPTicker*> tickers;
     for (shared_ptr<OutputPlugin>& Ptr : Sim->outputPlugins)
       {
-	shared_ptr<OPTicker> ptr = std::dynamic_pointer_cast<OPTicker>(Ptr);
-	if (ptr) ptr->ticker();
+	OPTicker* ptr = dynamic_cast<OPTicker*>(Ptr.get());
+	if (ptr) tickers.push_back(ptr);
       }
+
+    sweepParticles(tickers);
+    sweepChains(tickers);
+
+    for (OPTicker* ptr : tickers)
+      ptr->ticker();
+
     return NEventData();
   }
 
+  void
+  SysTicker::sweepParticles(const std::vector<OPTicker*>& tickers)
+  {
+    //Several blocks per thread are used to balance the load
+    const size_t N = Sim->N();
+    size_t blocks = Sim->threads ? 4 * Sim->threads->getThreadCount() : 1;
+    blocks = std::max(size_t(1), std::min(blocks, N / _chunkSize));
+
+    std::vector<OPTicker*> sweepers;
+    for (OPTicker* ptr : tickers)
+      if (ptr->beginSweep(blocks))
+	sweepers.push_back(ptr);
+
+    if (sweepers.empty()) return;
+
+    //Each block is processed in chunks, with every plugin visiting a
+    //chunk before moving onto the next. This way the particle data is
+    //only fetched from memory once for all the plugins.
+    auto processBlock = [&sweepers, N, blocks](size_t block) {
+      const size_t end = (block + 1) * N / blocks;
+      for (size_t begin = block * N / blocks; begin < end; begin += _chunkSize)
+	for (OPTicker* ptr : sweepers)
+	  ptr->sweepParticles(block, begin, std::min(begin + _chunkSize, end));
+    };
+
+    if (!Sim->threads || (blocks == 1))
+      {
+	for (size_t block(0); block < blocks; ++block)
+	  processBlock(block);
+	return;
+      }
+
+    for (size_t block(0); block < blocks; ++block)
+      Sim->threads->queueTask(std::bind(processBlock, block));
+    Sim->threads->wait();
+  }
+
+  void
+  SysTicker::sweepChains(const std::vector<OPTicker*>& tickers)
+  {
+    struct Molecule {
+      const TChain* chain;
+      size_t index;
+      const IDRange* range;
+    };
+
+    std::vector<Molecule> molecules;
+    for (const shared_ptr<Topology>& topology : Sim->topology)
+      {
+	const TChain* chain = dynamic_cast<const TChain*>(topology.get());
+	if (!chain) continue;
+	size_t index(0);
+	for (const shared_ptr<IDRange>& range : chain->getMolecules())
+	  molecules.push_back(Molecule{chain, index++, range.get()});
+      }
+
+    if (molecules.empty()) return;
+
+    const size_t N = molecules.size();
+    size_t blocks = Sim->threads ? 4 * Sim->threads->getThreadCount() : 1;
+    blocks = std::max(size_t(1), std::min(blocks, N));
+
+    std::vector<OPTicker*> sweepers;
+    for (OPTicker* ptr : tickers)
+      if (ptr->beginChainSweep(blocks))
+	sweepers.push_back(ptr);
+
+    if (sweepers.empty()) return;
+
+    _chainBuffers.resize(blocks);
+
+    //Each molecule is unwrapped once, then handed to every plugin
+    auto processBlock = [this, &sweepers, &molecules, N, blocks](size_t block) {
+      std::vector<Vector>& positions = _chainBuffers[block];
+      for (size_t i(block * N / blocks); i < (block + 1) * N / blocks; ++i)
+	{
+	  const Molecule& mol = molecules[i];
+	  mol.chain->unwrapMolecule(*mol.range, positions);
+	  for (OPTicker* ptr : sweepers)
+	    ptr->sweepChain(block, *mol.chain, mol.index, *mol.range, positions);
+	}
+    };
+
+    if (!Sim->threads || (blocks == 1))
+      {
+	for (size_t block(0); block < blocks; ++block)
+	  processBlock(block);
+	return;
+      }
+
+    for (size_t block(0); block < blocks; ++block)
+      Sim->threads->queueTask(std::bind(processBlock, block));
+    Sim->threads->wait();
+  }
+
   void 
   SysTicker::initialise(size_t nID)
   { ID = nID; }
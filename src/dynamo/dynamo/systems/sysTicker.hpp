@@ -17,8 +17,13 @@
 
 #pragma once
 #include <dynamo/systems/system.hpp>
+#include <magnet/math/vector.hpp>
+#include <vector>
 
 namespace dynamo {
+  class OPTicker;
+
+
   class SysTicker: public System
   {
   public:
@@ -47,6 +52,26 @@ namespace dynamo {
   protected:
     virtual void outputXML(magnet::xml::XmlStream&) const {}
 
+    /*! \brief Carry out a single pass over the particles for all
+        ticker plugins which declare a particle sweep.
+	
+	\sa OPTicker::beginSweep
+     */
+    void sweepParticles(const std::vector<OPTicker*>&);
+
+    /*! \brief Carry out a single pass over the chain molecules for all
+        ticker plugins which declare a chain sweep.
+	
+	\sa OPTicker::beginChainSweep
+     */
+    void sweepChains(const std::vector<OPTicker*>&);
+
+    //! \brief The unwrapped molecule of each block of the chain sweep.
+    std::vector<std::vector<Vector> > _chainBuffers;
+
+    //! \brief The number of particles processed by each plugin in turn.
+    static const size_t _chunkSize = 256;
+
     double period;
   };
 }
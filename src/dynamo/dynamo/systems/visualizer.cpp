@@ -34,8 +34,11 @@
 #include <algorithm>
 
 namespace dynamo {
-  SVisualizer::SVisualizer(dynamo::Simulation* nSim, std::string nName, double tickFreq):
-    System(nSim)
+  SVisualizer::SVisualizer(dynamo::Simulation* nSim, std::string nName, double tickFreq, size_t stride, Vector regionMin, Vector regionMax):
+    System(nSim),
+    _stride(std::max(stride, size_t(1))),
+    _regionMin(regionMin),
+    _regionMax(regionMax)
   {
     //Convert to output units of time
     tickFreq /= Sim->units.unitTime();
@@ -84,8 +87,46 @@ namespace dynamo {
   {
     ID = nID;
 
+    //Select the particles to be rendered
+    _renderedIDs.clear();
+    for (size_t pID(0); pID < Sim->N(); pID += _stride)
+      {
+	const Particle& p = Sim->particles[pID];
+	Vector pos = p.getPosition();
+	Vector vel = p.getVelocity();
+	Sim->BCs->applyBC(pos, vel);
+	pos /= Sim->units.unitLength();
+
+	bool inside = true;
+	for (size_t i(0); i < NDIM; ++i)
+	  inside &= (pos[i] >= _regionMin[i]) && (pos[i] <= _regionMax[i]);
+
+	if (inside)
+	  _renderedIDs.push_back(pID);
+      }
+
+    if (_renderedIDs.empty())
+      M_throw() << "No particles have been selected for rendering, check the visualizer stride and region";
+
+    if (_renderedIDs.size() != Sim->N())
+      dout << "Rendering " << _renderedIDs.size() << " of " << Sim->N() << " particles" << std::endl;
+
+    //Size the frames once, so they are only written to from now on
+    const size_t M = _renderedIDs.size();
+    for (size_t i(0); i < 3; ++i)
+      {
+	_frames[i].position.resize(3 * M);
+	_frames[i].velocity.resize(3 * M);
+	if (Sim->dynamics->hasOrientationData())
+	  {
+	    _frames[i].orientation.resize(4 * M);
+	    _frames[i].angularVelocity.resize(3 * M);
+	  }
+	_frames[i].size.reserve(4 * M);
+      }
+
     //Add all of the objects to be rendered
-    _particleData.reset(new coil::DataSet("Particles", Sim->N()));
+    _particleData.reset(new coil::DataSet("Particles", M));
     _window->addRenderObj(_particleData);
 
     for (shared_ptr<Local>& local : Sim->locals)
@@ -171,10 +212,11 @@ namespace dynamo {
 
     std::vector<GLfloat>& masses = (*_particleData)["Mass"];
     std::vector<GLfloat>& IDs = (*_particleData)["ID"];
-    for (const Particle& p : Sim->particles)
+    for (size_t idx(0); idx < _renderedIDs.size(); ++idx)
       {
-	IDs[p.getID()] = p.getID();
-	masses[p.getID()] = Sim->species(p)->getMass(p.getID()) / Sim->units.unitMass();
+	const size_t pID = _renderedIDs[idx];
+	IDs[idx] = pID;
+	masses[idx] = Sim->species(Sim->particles[pID])->getMass(pID) / Sim->units.unitMass();
       }
 
     (*_particleData)["Mass"].flagNewData();
@@ -184,9 +226,12 @@ namespace dynamo {
     _interactionIDs.clear();
     _interactionIDs.resize(Sim->interactions.size());
 
-    //Calculate the set of particle ID's to be drawn by each Interaction
-    for (const Particle& particle : Sim->particles)
-      _interactionIDs[Sim->getInteraction(particle, particle)->getID()].push_back(particle.getID());
+    //Calculate the set of particles to be drawn by each Interaction
+    for (size_t idx(0); idx < _renderedIDs.size(); ++idx)
+      {
+	const Particle& particle = Sim->particles[_renderedIDs[idx]];
+	_interactionIDs[Sim->getInteraction(particle, particle)->getID()].push_back(idx);
+      }
 
     //Update the size information once (only Compression dynamics needs to update it again)
     std::vector<GLfloat>& sizes = (*_particleData)["Size"];
@@ -196,11 +241,11 @@ namespace dynamo {
     	  dout << "Rendering Interaction \"" << interaction->getName() << "\" with " 
     	       << _interactionIDs[interaction->getID()].size() << " particles" << std::endl;
 	  
-    	  for (size_t ID : _interactionIDs[interaction->getID()])
+    	  for (size_t idx : _interactionIDs[interaction->getID()])
     	    {
-    	      const auto& psize = interaction->getGlyphSize(ID);
+    	      const auto& psize = interaction->getGlyphSize(_renderedIDs[idx]);
     	      for (size_t i(0); i < 4; ++i) 
-    		sizes[4 * ID + i] = psize[i];
+    		sizes[4 * idx + i] = psize[i];
     	    }
     	}
     (*_particleData)["Size"].flagNewData();
@@ -216,68 +261,95 @@ namespace dynamo {
   {
     if (!_particleData)
       M_throw() << "Updating before the render object has been fetched";
-    
-    shared_ptr<BCLeesEdwards> BC = std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs);
-    if (BC)
-      _particleData->setPeriodicVectors(Vector{Sim->primaryCellSize[0], 0, 0}, Vector{BC->getBoundaryDisplacement(), Sim->primaryCellSize[1], 0}, Vector{0, 0, Sim->primaryCellSize[2]});
 
+    Frame& frame = _frames.back();
+
+    shared_ptr<BCLeesEdwards> BC = std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs);
+    frame.boundaryDisplacement = BC ? BC->getBoundaryDisplacement() : 0;
 
     ///////////////////////POSITION DATA UPDATE
-    //Check if the system is compressing and adjust the radius scaling factor
-    std::vector<GLfloat>& posdata = (*_particleData)["Position"];
-    std::vector<GLfloat>& veldata = (*_particleData)["Velocity"];
-    
-    for (const Particle& p : Sim->particles)
+    GLfloat* posdata = frame.position.data();
+    GLfloat* veldata = frame.velocity.data();
+    for (const size_t pID : _renderedIDs)
       {
+	const Particle& p = Sim->particles[pID];
 	Vector vel = p.getVelocity() / Sim->units.unitVelocity();
 	Vector pos = p.getPosition() / Sim->units.unitLength();
 	Sim->BCs->applyBC(pos, vel);
 	  
 	for (size_t i(0); i < NDIM; ++i)
 	  {
-	    posdata[3 * p.getID() + i] = pos[i];
-	    veldata[3 * p.getID() + i] = vel[i];
+	    *posdata++ = pos[i];
+	    *veldata++ = vel[i];
 	  }
-
       }
 
+    //Check if the system is compressing and adjust the radius scaling factor
+    frame.size.clear();
     if (std::dynamic_pointer_cast<DynCompression>(Sim->dynamics))
       {
-	std::vector<GLfloat>& sizes = (*_particleData)["Size"];
+	frame.size.resize(4 * _renderedIDs.size());
 	const double rfactor = (1 + static_cast<const DynCompression&>(*Sim->dynamics).getGrowthRate() * Sim->systemTime) / Sim->units.unitLength();
 	for (auto& interaction : Sim->interactions)
-	  if (!_interactionIDs[interaction->getID()].empty())
+	  for (size_t idx : _interactionIDs[interaction->getID()])
 	    {
-	      for (size_t ID : _interactionIDs[interaction->getID()])
-		{
-		  const auto& psize = interaction->getGlyphSize(ID);
-		  for (size_t i(0); i < 4; ++i)
-		    sizes[4 * ID + i] = rfactor * psize[i];
-		}
+	      const auto& psize = interaction->getGlyphSize(_renderedIDs[idx]);
+	      for (size_t i(0); i < 4; ++i)
+		frame.size[4 * idx + i] = rfactor * psize[i];
 	    }
-	(*_particleData)["Size"].flagNewData();
       }
 
     if (Sim->dynamics->hasOrientationData())
       {
-	std::vector<GLfloat>& orientationdata = (*_particleData)["Orientation"];
-	std::vector<GLfloat>& angularvdata = (*_particleData)["Angular Velocity"];
+	GLfloat* orientationdata = frame.orientation.data();
+	GLfloat* angularvdata = frame.angularVelocity.data();
 	const std::vector<Dynamics::rotData>& data = Sim->dynamics->getCompleteRotData();
-	for (const Particle& p : Sim->particles)
+	for (const size_t pID : _renderedIDs)
 	  {
 	    for (size_t i(0); i < NDIM; ++i)
 	      {
-		angularvdata[3 * p.getID() + i] = data[p.getID()].angularVelocity[i] * Sim->units.unitTime();
-		orientationdata[4 * p.getID() + i] = data[p.getID()].orientation.imaginary()[i];
+		*angularvdata++ = data[pID].angularVelocity[i] * Sim->units.unitTime();
+		*orientationdata++ = data[pID].orientation.imaginary()[i];
 	      }
-	    orientationdata[4 * p.getID() + 3] = data[p.getID()].orientation.real();
+	    *orientationdata++ = data[pID].orientation.real();
 	  }
-	(*_particleData)["Angular Velocity"].flagNewData();
-	(*_particleData)["Orientation"].flagNewData();
       }
 
+    //Hand the frame over, the render thread will pick up the latest
+    //frame when it next processes its tasks.
+    _frames.publish();
+    _window->getGLContext()->queueTask(std::bind(&SVisualizer::uploadFrame, this));
+  }
+
+  void
+  SVisualizer::uploadFrame()
+  {
+    //Several uploads may be queued for a single frame, only the first
+    //one does any work.
+    if (!_frames.consume()) return;
+    const Frame& frame = _frames.front();
+
+    if (std::dynamic_pointer_cast<BCLeesEdwards>(Sim->BCs))
+      _particleData->setPeriodicVectors(Vector{Sim->primaryCellSize[0], 0, 0}, Vector{frame.boundaryDisplacement, Sim->primaryCellSize[1], 0}, Vector{0, 0, Sim->primaryCellSize[2]});
+
+    std::copy(frame.position.begin(), frame.position.end(), (*_particleData)["Position"].begin());
     (*_particleData)["Position"].flagNewData();
+    std::copy(frame.velocity.begin(), frame.velocity.end(), (*_particleData)["Velocity"].begin());
     (*_particleData)["Velocity"].flagNewData();
+
+    if (!frame.size.empty())
+      {
+	std::copy(frame.size.begin(), frame.size.end(), (*_particleData)["Size"].begin());
+	(*_particleData)["Size"].flagNewData();
+      }
+
+    if (!frame.orientation.empty())
+      {
+	std::copy(frame.orientation.begin(), frame.orientation.end(), (*_particleData)["Orientation"].begin());
+	(*_particleData)["Orientation"].flagNewData();
+	std::copy(frame.angularVelocity.begin(), frame.angularVelocity.end(), (*_particleData)["Angular Velocity"].begin());
+	(*_particleData)["Angular Velocity"].flagNewData();
+      }
   }
 }
 #endif
@@ -20,14 +20,39 @@
 #ifdef DYNAMO_visualizer
 #include <coil/clWindow.hpp>
 #include <dynamo/systems/system.hpp>
+#include <magnet/thread/triplebuffer.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cmath>
 
 namespace coil { class DataSet; }
 namespace dynamo {
+  /*! \brief A System which periodically passes the particle data to
+      the coil visualizer.
+
+    The simulation thread only copies the data of the rendered
+    particles into a compact frame, which is handed to the render
+    thread through a TripleBuffer. The render thread then copies the
+    latest frame into the coil::DataSet and uploads it, so the
+    simulation never waits on the render thread (except for the
+    framelock of the window) and frames which are produced faster
+    than they are rendered are simply dropped.
+
+    For large systems, a subset of the particles may be rendered by
+    only taking every stride-th particle and/or only the particles
+    which are inside a region when the visualizer is initialised.
+   */
   class SVisualizer: public System
   {
   public:
-    SVisualizer(dynamo::Simulation*, std::string, double);
+    /*! \param stride Only every stride-th particle (by ID) is rendered.
+      \param regionMin The lower corner of the region of interest (in
+      output units), particles outside the region at initialisation
+      are not rendered.
+      \param regionMax The upper corner of the region of interest.
+     */
+    SVisualizer(dynamo::Simulation*, std::string, double, size_t stride = 1,
+		Vector regionMin = Vector{-HUGE_VAL, -HUGE_VAL, -HUGE_VAL},
+		Vector regionMax = Vector{HUGE_VAL, HUGE_VAL, HUGE_VAL});
   
     virtual NEventData runEvent();
 
@@ -47,9 +72,32 @@ namespace dynamo {
     
     void initDataSet();
     void updateRenderData();
+    //! \brief Copy the latest frame into the DataSet (render thread only).
+    void uploadFrame();
+
+    //! \brief The particle data rendered in a single update.
+    struct Frame
+    {
+      std::vector<GLfloat> position;
+      std::vector<GLfloat> velocity;
+      std::vector<GLfloat> orientation;
+      std::vector<GLfloat> angularVelocity;
+      //! \brief The glyph sizes, only filled if they have changed.
+      std::vector<GLfloat> size;
+      //! \brief The Lees-Edwards boundary displacement (if any).
+      double boundaryDisplacement;
+    };
+
+    magnet::thread::TripleBuffer<Frame> _frames;
+    //! \brief The ID of the particle rendered at each DataSet index.
+    std::vector<size_t> _renderedIDs;
+    size_t _stride;
+    Vector _regionMin;
+    Vector _regionMax;
 
     shared_ptr<coil::DataSet> _particleData;
     boost::posix_time::ptime _lastUpdate;
+    //! \brief The DataSet indices of the particles of each Interaction.
     std::vector<std::vector<GLuint> > _interactionIDs;
   };
 }
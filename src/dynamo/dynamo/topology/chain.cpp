@@ -16,6 +16,8 @@
 */
 
 #include <dynamo/topology/chain.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/BC.hpp>
 #include <magnet/xmlwriter.hpp>
 #include <magnet/xmlreader.hpp>
 
@@ -47,6 +49,21 @@ namespace dynamo {
     _name = nName;
   }
 
+  void
+  TChain::unwrapMolecule(const IDRange& range, std::vector<Vector>& positions) const
+  {
+    positions.resize(range.size());
+    if (positions.empty()) return;
+
+    positions[0] = Vector{0,0,0};
+    for (size_t i(1); i < range.size(); ++i)
+      {
+	Vector bond = Sim->particles[range[i]].getPosition() - Sim->particles[range[i - 1]].getPosition();
+	Sim->BCs->applyBC(bond);
+	positions[i] = positions[i - 1] + bond;
+      }
+  }
+
   void 
   TChain::outputXML(magnet::xml::XmlStream& XML) const 
   {
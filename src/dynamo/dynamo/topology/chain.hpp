@@ -17,6 +17,8 @@
 
 #pragma once
 #include <dynamo/topology/topology.hpp>
+#include <magnet/math/vector.hpp>
+#include <vector>
 
 namespace dynamo {
   class TChain: public Topology
@@ -30,6 +32,16 @@ namespace dynamo {
   
     virtual void operator<<(const magnet::xml::Node&);
 
+    /*! \brief Calculate the positions of the beads of a molecule,
+        unwrapped through the boundary conditions.
+
+      Each bond is taken as the minimum image separation of
+      neighbouring beads, so the molecule is continuous even if it
+      spans a periodic boundary. The positions are relative to the
+      first bead, which is placed at the origin.
+     */
+    void unwrapMolecule(const IDRange&, std::vector<Vector>& positions) const;
+
   protected:
   
     virtual void outputXML(magnet::xml::XmlStream&) const;
@@ -0,0 +1,87 @@
+#define BOOST_TEST_MODULE Andersen_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/systems/andersenThermostat.hpp>
+#include <random>
+
+auto RNG = std::mt19937(std::random_device()());
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+//Exposes the tuning of SysAndersen
+struct TestAndersen: public dynamo::SysAndersen
+{
+  TestAndersen(dynamo::Simulation* sim, size_t nbatch):
+    SysAndersen(sim, 1.0, 1.0, "Thermostat")
+  {
+    batch = nbatch;
+    setFrequency = 1000;
+  }
+
+  using SysAndersen::meanFreeTime;
+};
+
+TestAndersen& init(dynamo::Simulation& Sim, size_t batch)
+{
+  Sim.ranGenerator.seed(std::random_device()());
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{5, 5, 5}}, dynamo::Vector{1, 1, 1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1, 1, 1};
+
+  const double particleDiam = std::cbrt(0.5 / latticeSites.size());
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+  Sim.units.setUnitLength(particleDiam);
+
+  std::normal_distribution<double> normal_dist;
+  unsigned long nParticles = 0;
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, dynamo::Vector{normal_dist(RNG), normal_dist(RNG), normal_dist(RNG)} * Sim.units.unitVelocity(), nParticles++));
+
+  Sim.systems.push_back(dynamo::shared_ptr<dynamo::System>(new TestAndersen(&Sim, batch)));
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+  Sim.endEventCount = 400000;
+  Sim.initialise();
+  return static_cast<TestAndersen&>(*Sim.systems["Thermostat"]);
+}
+
+//The average tuned mean free time, once the tuning has converged
+double tunedMFT(size_t batch)
+{
+  dynamo::Simulation Sim;
+  const TestAndersen& thermostat = init(Sim, batch);
+
+  double sum = 0;
+  size_t samples = 0;
+  while (Sim.runSimulationStep())
+    if (Sim.eventCount > Sim.endEventCount / 4)
+      {
+	sum += thermostat.meanFreeTime;
+	++samples;
+      }
+
+  return sum / samples / Sim.units.unitTime();
+}
+
+BOOST_AUTO_TEST_CASE( Batched_Tuning )
+{
+  //A batched thermostat is tuned to thermalise each particle as
+  //often as an unbatched one, so it couples to the system as strongly
+  const double MFT1 = tunedMFT(1);
+  const double MFT16 = tunedMFT(16);
+  BOOST_TEST_MESSAGE("Tuned MFT " << MFT1 << " (Batch=1), " << MFT16 << " (Batch=16)");
+  BOOST_CHECK_CLOSE(MFT16, MFT1, 10);
+}
@@ -13,6 +13,7 @@
 #include <dynamo/inputplugins/include.hpp>
 #include <dynamo/inputplugins/compression.hpp>
 #include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/globals/multicells.hpp>
 #include <dynamo/outputplugins/misc.hpp>
 #include <dynamo/outputplugins/msd.hpp>
 #include <random>
@@ -136,6 +137,46 @@ BOOST_AUTO_TEST_CASE( Equilibrium_Simulation )
   BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
 }
 
+BOOST_AUTO_TEST_CASE( MultiCells_Simulation )
+{
+  //The two species are sorted into separate levels of the neighbour
+  //list, which must not change the dynamics.
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 1.4);
+    Sim.globals.push_back(dynamo::shared_ptr<dynamo::Global>(new dynamo::GMultiCells(&Sim, "SchedulerNBList")));
+    Sim.writeXMLfile("BHSmulticells.xml");
+  }
+
+  dynamo::Simulation Sim;
+  Sim.loadXMLfile("BHSmulticells.xml");
+
+  Sim.endEventCount = 1000000;
+  Sim.addOutputPlugin("Misc");
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+
+  Sim.reset();
+  Sim.endEventCount = 1000000;
+  Sim.addOutputPlugin("Misc");
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+
+  dynamo::shared_ptr<dynamo::GMultiCells> nblist = std::dynamic_pointer_cast<dynamo::GMultiCells>(Sim.globals["SchedulerNBList"]);
+  BOOST_REQUIRE(nblist);
+  BOOST_CHECK_EQUAL(nblist->getLevelCount(), 2);
+
+  //The same mean free time as the Equilibrium_Simulation
+  const double expectedMFT = 0.0098213311089127;
+  dynamo::OPMisc& opMisc = *Sim.getOutputPlugin<dynamo::OPMisc>();
+  BOOST_CHECK_CLOSE(opMisc.getMFT(), expectedMFT, 1);
+
+  const double Temperature = opMisc.getCurrentkT() / Sim.units.unitEnergy();
+  BOOST_CHECK_CLOSE(Temperature, 1.0, 0.000000001);
+
+  BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
+}
+
 //BOOST_AUTO_TEST_CASE( Compression_Simulation )
 //{
 //  dynamo::Simulation Sim;
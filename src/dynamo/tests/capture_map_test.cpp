@@ -0,0 +1,115 @@
+#define BOOST_TEST_MODULE CaptureMap_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/interactions/captures.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace dynamo::detail;
+
+auto RNG = std::mt19937(std::random_device()());
+
+typedef std::pair<PairKey, size_t> Operation;
+
+//Apply a sequence of set operations to a map, and check the hash
+//maintained by the map against its sorted key.
+void apply(CaptureMap& map, const std::vector<Operation>& ops)
+{
+  for (const Operation& op : ops)
+    map.set(op.first, op.second);
+  BOOST_CHECK_EQUAL(map.getHash(), CaptureMapKey(map).hash());
+}
+
+BOOST_AUTO_TEST_CASE( CaptureMap_hash_basic )
+{
+  CaptureMap map;
+  BOOST_CHECK_EQUAL(map.getHash(), 0);
+  BOOST_CHECK_EQUAL(CaptureMapKey(map).hash(), 0);
+
+  map[PairKey(1, 2)] = 1;
+  map[PairKey(5, 3)] = 2;
+  const uint64_t hash = map.getHash();
+  BOOST_CHECK_EQUAL(hash, CaptureMapKey(map).hash());
+
+  //Overwriting and restoring an entry returns the same hash
+  map[PairKey(2, 1)] = 3;
+  BOOST_CHECK(map.getHash() != hash);
+  BOOST_CHECK_EQUAL(map.getHash(), CaptureMapKey(map).hash());
+  map[PairKey(1, 2)] = 1;
+  BOOST_CHECK_EQUAL(map.getHash(), hash);
+
+  //Erasing (setting to zero) an entry removes its contribution
+  map[PairKey(4, 6)] = 1;
+  map[PairKey(4, 6)] = 0;
+  BOOST_CHECK_EQUAL(map.getHash(), hash);
+  //Erasing a missing entry does nothing
+  map[PairKey(7, 8)] = 0;
+  BOOST_CHECK_EQUAL(map.getHash(), hash);
+  BOOST_CHECK_EQUAL(map.size(), 2);
+
+  map.clear();
+  BOOST_CHECK_EQUAL(map.getHash(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( CaptureMap_hash_order_independence )
+{
+  std::uniform_int_distribution<size_t> idgen(0, 30);
+  std::uniform_int_distribution<size_t> stategen(0, 3);
+
+  for (size_t loop(0); loop < 50; ++loop)
+    {
+      //A random sequence of insertions, overwrites and erasures
+      //(assignments of zero)
+      std::vector<Operation> ops;
+      for (size_t i(0); i < 200; ++i)
+	{
+	  const size_t p1 = idgen(RNG);
+	  size_t p2 = idgen(RNG);
+	  if (p1 == p2) continue;
+	  ops.push_back(Operation(PairKey(p1, p2), stategen(RNG)));
+	}
+
+      CaptureMap map;
+      apply(map, ops);
+
+      //The final contents of the map
+      std::map<uint64_t, size_t> final_state;
+      for (const Operation& op : ops)
+	final_state[op.first] = op.second;
+
+      //Insert only the final (non-zero) states, in a shuffled order
+      std::vector<Operation> direct;
+      for (const auto& entry : final_state)
+	if (entry.second)
+	  direct.push_back(Operation(PairKey(entry.first), entry.second));
+      std::shuffle(direct.begin(), direct.end(), RNG);
+
+      CaptureMap map2;
+      apply(map2, direct);
+      BOOST_CHECK_EQUAL(map.size(), map2.size());
+      BOOST_CHECK_EQUAL(map.getHash(), map2.getHash());
+
+      //Reach the same state through a different history: insert
+      //every pair with a different state first, then overwrite and
+      //erase them in a shuffled order.
+      std::vector<Operation> history;
+      for (const auto& entry : final_state)
+	history.push_back(Operation(PairKey(entry.first), entry.second + 1));
+      std::shuffle(history.begin(), history.end(), RNG);
+      CaptureMap map3;
+      apply(map3, history);
+
+      std::vector<Operation> overwrite;
+      for (const auto& entry : final_state)
+	overwrite.push_back(Operation(PairKey(entry.first), entry.second));
+      std::shuffle(overwrite.begin(), overwrite.end(), RNG);
+      apply(map3, overwrite);
+      BOOST_CHECK_EQUAL(map.size(), map3.size());
+      BOOST_CHECK_EQUAL(map.getHash(), map3.getHash());
+
+      //Copies compare equal to the original through their keys
+      BOOST_CHECK(CaptureMapKey(map) == CaptureMapKey(map2));
+      BOOST_CHECK(CaptureMapKey(map) == CaptureMapKey(map3));
+    }
+}
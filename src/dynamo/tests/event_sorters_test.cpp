@@ -77,6 +77,30 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(PEL_standard, T, PEL_types){
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(PEL_partial_invalidation, T, PEL_types){
+  RNG.seed(std::random_device()());
+  const size_t N=5;
+
+  for (size_t test(0); test < 100; ++test) {
+    T sorter;
+    std::vector<dynamo::Event> standard = fillSorter(sorter, 10, N);
+    const size_t ID = std::uniform_int_distribution<size_t>(0, N-1)(RNG);
+    sorter.invalidate(ID);
+    
+    //None of the remaining events may involve ID, and the
+    //remaining events must still be in order
+    double last_dt = -HUGE_VAL;
+    while (!sorter.empty()) {
+      const dynamo::Event e = sorter.top();
+      if (e._type != dynamo::RECALCULATE)
+	BOOST_CHECK(e._particle2ID != ID);
+      BOOST_CHECK(e._dt >= last_dt);
+      last_dt = e._dt;
+      sorter.pop();
+    }
+  }
+}
+
 #include <dynamo/schedulers/sorters/referenceFEL.hpp>
 #include <dynamo/schedulers/sorters/CBTFEL.hpp>
 #include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
@@ -90,6 +114,10 @@ typedef boost::mpl::list<
   ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<2> >
   ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<5> >
   ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<30> >
+  ,dynamo::CBTFEL<dynamo::HeapPEL, true>
+  ,dynamo::CBTFEL<dynamo::MinMaxPEL<2>, true>
+  ,dynamo::BoundedPQFEL<dynamo::HeapPEL, true>
+  ,dynamo::BoundedPQFEL<dynamo::MinMaxPEL<2>, true>
 			 > FEL_types;
 
 #define validateEvents(e1, e2)						\
@@ -233,6 +261,46 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(FEL_standard, T, FEL_types){
   }
   BOOST_REQUIRE(FEL.empty());
 
+  //Test bulk loading, in a random particle order with invalidations
+  FEL.clear();
+  FEL.init(N);
+  FEL.beginBulkLoad();
+  for (size_t i(0); i < N * eventsPerParticle; ++i) {
+    const dynamo::Event e = genInteractionEvent(N, 1.0, 1);
+    reference.push_back(e);
+    FEL.push(e);
+  }
+  {
+    const size_t invalidID = reference.back()._particle1ID;
+    FEL.invalidate(invalidID);
+    auto test = [=](const dynamo::Event& e){
+      return (e._particle1ID == invalidID) || ((e._source == dynamo::INTERACTION) && (e._particle2ID == invalidID));
+    };
+    reference.erase(std::remove_if(reference.begin(), reference.end(), test), reference.end());
+  }
+  FEL.endBulkLoad();
+  while (!reference.empty()) {
+    const auto next_it = std::min_element(reference.begin(), reference.end());
+    const dynamo::Event nextEvent = *next_it;
+    if ((nextEvent._dt == std::numeric_limits<float>::infinity()) && FEL.empty())
+      break;
+    BOOST_REQUIRE(!FEL.empty());
+    const dynamo::Event testEvent = FEL.top();
+
+    if (testEvent._type == dynamo::RECALCULATE) {
+      FEL.pop();
+      for (const dynamo::Event& e: reference)
+	if (e._particle1ID == testEvent._particle1ID)
+	  FEL.push(e);
+      continue;
+    }
+
+    validateEvents(nextEvent,testEvent);
+    reference.erase(next_it);
+    FEL.pop();
+  }
+  BOOST_REQUIRE(FEL.empty());
+
   //Test particle invalidation
   FEL.clear();
   FEL.init(N);
@@ -321,3 +389,37 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(FEL_standard, T, FEL_types){
     }
   }
 }
+
+/*! Run the invalidation pattern of a simulation (invalidate the
+  particle of each event) on a FEL, and return the number of stale
+  events it discarded.
+ */
+template<class T>
+size_t countStaleEvents()
+{
+  RNG.seed(5489u);
+  const size_t N = 100;
+  T FEL;
+  FEL.init(N);
+  for (size_t i(0); i < 10 * N; ++i)
+    FEL.push(genInteractionEvent(N, 1.0, 1));
+
+  for (size_t i(0); i < 10 * N && !FEL.empty(); ++i)
+    {
+      const size_t ID = FEL.top()._particle1ID;
+      FEL.invalidate(ID);
+      for (size_t j(0); j < 5; ++j)
+	FEL.push(genInteractionEvent(N, 1.0, 1, ID));
+    }
+  return FEL.getStaleEventCount();
+}
+
+BOOST_AUTO_TEST_CASE(FEL_stale_events)
+{
+  //The lazy scheme discards stale events at the top of the queue,
+  //the indexed scheme purges them on invalidation
+  BOOST_CHECK(countStaleEvents<dynamo::CBTFEL<dynamo::HeapPEL> >() > 0);
+  BOOST_CHECK_EQUAL((countStaleEvents<dynamo::CBTFEL<dynamo::HeapPEL, true> >()), 0u);
+  BOOST_CHECK(countStaleEvents<dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > >() > 0);
+  BOOST_CHECK_EQUAL((countStaleEvents<dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3>, true> >()), 0u);
+}
@@ -31,7 +31,7 @@ dynamo::Vector getRandVelVec()
   return tmpVec;
 }
 
-void init(dynamo::Simulation& Sim, const double density)
+void init(dynamo::Simulation& Sim, const double density, const bool disordered = false)
 {
   RNG.seed(std::random_device()());
   Sim.ranGenerator.seed(std::random_device()());
@@ -42,16 +42,23 @@ void init(dynamo::Simulation& Sim, const double density)
   Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
   Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
 
-  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{7,7,7}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
-  packptr->initialise();
-  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  const size_t N = 1372;
   Sim.primaryCellSize = dynamo::Vector{1,1,1};
 
   double simVol = 1.0;
   for (size_t iDim = 0; iDim < NDIM; ++iDim)
     simVol *= Sim.primaryCellSize[iDim];
 
-  double particleDiam = std::cbrt(simVol * density / latticeSites.size());
+  double particleDiam = std::cbrt(simVol * density / N);
+
+  std::unique_ptr<dynamo::UCell> packptr;
+  if (disordered)
+    packptr.reset(new dynamo::CURSA(std::vector<double>(N, particleDiam), Sim.primaryCellSize, new dynamo::UParticle()));
+  else
+    packptr.reset(new dynamo::CUFCC(std::array<long, 3>{{7,7,7}}, dynamo::Vector{1,1,1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+
   Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, particleDiam, elasticity, new dynamo::IDPairRangeAll(), "Bulk")));
   Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
   Sim.units.setUnitLength(particleDiam);
@@ -66,7 +73,7 @@ void init(dynamo::Simulation& Sim, const double density)
   dynamo::InputPlugin(&Sim, "Rescaler").zeroMomentum();
   dynamo::InputPlugin(&Sim, "Rescaler").rescaleVels(1.0);
 
-  BOOST_CHECK_EQUAL(Sim.N(), 1372);
+  BOOST_CHECK_EQUAL(Sim.N(), N);
   BOOST_CHECK_CLOSE(Sim.getNumberDensity() * Sim.units.unitVolume(), density, 0.000000001);
   BOOST_CHECK_CLOSE(Sim.getPackingFraction(), Sim.getNumberDensity() * Sim.units.unitVolume() * M_PI / 6.0, 0.000000001);
 }
@@ -122,6 +129,95 @@ BOOST_AUTO_TEST_CASE( Equilibrium_Simulation )
   BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
 }
 
+BOOST_AUTO_TEST_CASE( FastKernel_Simulation )
+{
+  //The specialised kernel must give exactly the same trajectory as
+  //the generic interaction events, so any difference shows up as
+  //diverging positions.
+  {
+    dynamo::Simulation Sim;
+    init(Sim, 0.5);
+    Sim.writeXMLfile("HSfastkernel.xml");
+  }
+
+  std::vector<dynamo::Vector> positions[2];
+  for (size_t fast(0); fast < 2; ++fast)
+    {
+      dynamo::Simulation Sim;
+      Sim.loadXMLfile("HSfastkernel.xml");
+      Sim.ptrScheduler->setFastKernel(fast);
+      Sim.endEventCount = 100000;
+      Sim.initialise();
+      while (Sim.runSimulationStep()) {}
+      Sim.dynamics->updateAllParticles();
+
+      for (const dynamo::Particle& p : Sim.particles)
+	positions[fast].push_back(p.getPosition());
+    }
+
+  size_t differences(0);
+  for (size_t i(0); i < positions[0].size(); ++i)
+    differences += (positions[0][i] != positions[1][i]);
+  BOOST_CHECK_EQUAL(differences, 0);
+}
+
+BOOST_AUTO_TEST_CASE( Disordered_Simulation )
+{
+  //Start from a random sequential addition packing, which must be
+  //free of overlaps and equilibrate to the same state as the crystal
+  dynamo::Simulation Sim;
+  init(Sim, 0.5, true);
+
+  Sim.endEventCount = 100000;
+  Sim.addOutputPlugin("Misc");
+  Sim.initialise();
+  BOOST_CHECK_EQUAL(Sim.checkSystem(), 0);
+  while (Sim.runSimulationStep()) {}
+
+  Sim.reset();
+  Sim.endEventCount = 400000;
+  Sim.addOutputPlugin("Misc");
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+
+  //Taken from Lue 2005 DOI:10.1063/1.1834498
+  const double expectedMFT = 0.13031;
+  BOOST_CHECK_CLOSE(Sim.getOutputPlugin<dynamo::OPMisc>()->getMFT(), expectedMFT, 1);
+  BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
+}
+
+BOOST_AUTO_TEST_CASE( Polydisperse_RSA_Packing )
+{
+  const size_t N = 4000;
+  const dynamo::Vector box{1, 2, 0.5};
+  std::vector<double> diameters(N);
+  for (size_t i(0); i < N; ++i)
+    diameters[i] = (i < N / 4) ? 0.06 : 0.03;
+
+  dynamo::CURSA packroutine(diameters, box, new dynamo::UParticle());
+  std::vector<dynamo::Vector> sites;
+  packroutine.appendObjects(dynamo::Vector{0,0,0}, sites);
+  BOOST_REQUIRE_EQUAL(sites.size(), N);
+
+  size_t overlaps(0);
+  for (size_t i(0); i < N; ++i)
+    {
+      for (size_t iDim(0); iDim < NDIM; ++iDim)
+	BOOST_CHECK(std::abs(sites[i][iDim]) <= 0.5 * box[iDim]);
+
+      for (size_t j(i + 1); j < N; ++j)
+	{
+	  dynamo::Vector rij = sites[i] - sites[j];
+	  for (size_t iDim(0); iDim < NDIM; ++iDim)
+	    rij[iDim] -= box[iDim] * std::round(rij[iDim] / box[iDim]);
+	  const double d = 0.5 * (diameters[i] + diameters[j]);
+	  if (rij.nrm2() < d * d) ++overlaps;
+	}
+    }
+
+  BOOST_CHECK_EQUAL(overlaps, 0);
+}
+
 BOOST_AUTO_TEST_CASE( Compression_Simulation )
 {
   dynamo::Simulation Sim;
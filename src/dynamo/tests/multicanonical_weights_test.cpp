@@ -0,0 +1,292 @@
+#define BOOST_TEST_MODULE MulticanonicalWeights_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/multicanonical.hpp>
+#include <dynamo/dynamics/multicanonical_contactmap.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/interactions/squarewell.hpp>
+#include <dynamo/systems/andersenThermostat.hpp>
+#include <magnet/xmlreader.hpp>
+#include <random>
+#include <iomanip>
+#include <sstream>
+
+using namespace dynamo;
+using detail::PairKey;
+using detail::CaptureMap;
+using detail::CaptureMapKey;
+
+auto RNG = std::mt19937(std::random_device()());
+typedef BoundedPQFEL<MinMaxPEL<3> > DefaultSorter;
+
+//! \brief Holds a parsed XML string, for constructing the Dynamics.
+struct XMLString
+{
+  XMLString(const std::string& xml):
+    _buffer(xml.begin(), xml.end())
+  {
+    _buffer.push_back('\0');
+    _doc.parse<0>(_buffer.data());
+  }
+
+  magnet::xml::Node getNode() { return magnet::xml::Node(_doc.first_node(), NULL); }
+
+  std::vector<char> _buffer;
+  rapidxml::xml_document<> _doc;
+};
+
+void init(Simulation& Sim)
+{
+  Sim.ranGenerator.seed(std::random_device()());
+  Sim.BCs = shared_ptr<BoundaryCondition>(new BCPeriodic(&Sim));
+  Sim.ptrScheduler = shared_ptr<SNeighbourList>(new SNeighbourList(&Sim, new DefaultSorter()));
+
+  //The particles are far apart, the contact map is set by the tests
+  std::unique_ptr<UCell> packptr(new CUSC(std::array<long, 3>{{3, 3, 3}}, Vector{9, 9, 9}, new UParticle()));
+  packptr->initialise();
+  std::vector<Vector> latticeSites(packptr->placeObjects(Vector{0,0,0}));
+  Sim.primaryCellSize = Vector{9, 9, 9};
+
+  Sim.interactions.push_back(shared_ptr<Interaction>(new ISquareWell(&Sim, 1.0, 1.5, 1.0, 1.0, new IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(shared_ptr<Species>(new SpPoint(&Sim, new IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+
+  unsigned long nParticles = 0;
+  for (const Vector & position : latticeSites)
+    Sim.particles.push_back(Particle(position, Vector{0, 0, 0}, nParticles++));
+
+  Sim.systems.push_back(shared_ptr<System>(new SysAndersen(&Sim, 1.0, 1.0, "Thermostat")));
+  Sim.ensemble = Ensemble::loadEnsemble(Sim);
+}
+
+/////////////////// DynNewtonianMC
+
+std::string randomMCWeights(double step, long minKey, long maxKey, size_t count)
+{
+  std::uniform_int_distribution<long> keydist(minKey, maxKey);
+  std::normal_distribution<double> wdist;
+  std::ostringstream os;
+  os << std::setprecision(17)
+     << "<Dynamics Type=\"NewtonianMC\"><PotentialDeformation EnergyStep=\"" << step << "\">";
+  for (size_t i(0); i < count; ++i)
+    os << "<W Energy=\"" << keydist(RNG) * step << "\" Value=\"" << wdist(RNG) << "\"/>";
+  os << "</PotentialDeformation></Dynamics>";
+  return os.str();
+}
+
+//Check the tabulated W(E) against a search of the map
+void checkMCWeights(const DynNewtonianMC& dynamics, double minE, double maxE)
+{
+  std::uniform_real_distribution<double> Edist(minE, maxE);
+  for (size_t i(0); i < 10000; ++i)
+    {
+      const double E = Edist(RNG);
+      const auto it = dynamics.getMap().find(lrint(E / dynamics.getEnergyStep()));
+      const double expected = (it == dynamics.getMap().end()) ? 0 : it->second;
+      BOOST_CHECK_EQUAL(dynamics.W(E), expected);
+    }
+
+  //Every entry of the map
+  for (const auto& entry : dynamics.getMap())
+    BOOST_CHECK_EQUAL(dynamics.W(entry.first * dynamics.getEnergyStep()), entry.second);
+}
+
+BOOST_AUTO_TEST_CASE( NewtonianMC_weights )
+{
+  Simulation Sim;
+  init(Sim);
+
+  //A compact map which is tabulated, and a sparse map which is not
+  //completely tabulated
+  XMLString dense(randomMCWeights(0.5, -40, 10, 30));
+  XMLString sparse(randomMCWeights(0.25, -100000, 100000, 30));
+  DynNewtonianMC dyn1(&Sim, dense.getNode());
+  DynNewtonianMC dyn2(&Sim, sparse.getNode());
+
+  checkMCWeights(dyn1, -30, 10);
+  checkMCWeights(dyn2, -30000, 30000);
+
+  //The tables are exchanged along with the maps
+  dyn1.replicaExchange(dyn2);
+  checkMCWeights(dyn1, -30000, 30000);
+  checkMCWeights(dyn2, -30, 10);
+
+  dyn1.replicaExchange(dyn2);
+  checkMCWeights(dyn1, -30, 10);
+  checkMCWeights(dyn2, -30000, 30000);
+}
+
+/////////////////// DynNewtonianMCCMap
+
+//! \brief A map of W loaded by DynNewtonianMCCMap.
+struct WMap {
+  CaptureMapKey map;
+  size_t distance;
+  double W;
+};
+
+//! \brief The pairs of particles used in the contact maps.
+const size_t maxID = 6;
+
+PairKey randomPair()
+{
+  std::uniform_int_distribution<size_t> iddist(0, maxID - 1);
+  while (true)
+    {
+      const size_t ID1 = iddist(RNG), ID2 = iddist(RNG);
+      if (ID1 != ID2) return PairKey(ID1, ID2);
+    }
+}
+
+CaptureMap randomMap()
+{
+  CaptureMap map;
+  std::uniform_int_distribution<size_t> sizedist(0, 5);
+  std::uniform_int_distribution<size_t> statedist(1, 2);
+  for (size_t i(sizedist(RNG)); i > 0; --i)
+    map.set(randomPair(), statedist(RNG));
+  return map;
+}
+
+std::vector<WMap> randomCMapWeights()
+{
+  std::vector<WMap> maps;
+  std::normal_distribution<double> wdist;
+  std::uniform_int_distribution<size_t> distancedist(1, 3);
+  for (size_t i(0); i < 40; ++i)
+    maps.push_back(WMap{CaptureMapKey(randomMap()), 0, wdist(RNG)});
+
+  //Repeated single maps, where the last one loaded is used
+  for (size_t i(0); i < 5; ++i)
+    maps.push_back(WMap{maps[i].map, 0, wdist(RNG)});
+
+  for (size_t i(0); i < 5; ++i)
+    maps.push_back(WMap{CaptureMapKey(randomMap()), distancedist(RNG), wdist(RNG)});
+
+  return maps;
+}
+
+std::string toXML(const std::vector<WMap>& maps)
+{
+  std::ostringstream os;
+  os << std::setprecision(17) << "<Dynamics Type=\"NewtonianMCCMap\" Interaction=\"Bulk\"><Potential>";
+  for (const WMap& map : maps)
+    {
+      os << "<Map W=\"" << map.W << "\" Distance=\"" << map.distance << "\">";
+      for (const auto& entry : map.map)
+	os << "<Contact ID1=\"" << entry.first.first << "\" ID2=\"" << entry.first.second
+	   << "\" State=\"" << entry.second << "\"/>";
+      os << "</Map>";
+    }
+  os << "</Potential></Dynamics>";
+  return os.str();
+}
+
+//! \brief The W of a contact map, found by searching every map.
+double referenceW(const std::vector<WMap>& maps, const CaptureMapKey& map)
+{
+  size_t applicable = 0;
+  double W = 0;
+
+  //The last matching single map
+  for (auto it = maps.rbegin(); it != maps.rend(); ++it)
+    if (!it->distance && (it->map == map))
+      {
+	++applicable;
+	W += it->W;
+	break;
+      }
+
+  //The distance maps, where the distance is the number of pairs in
+  //only one of the maps
+  for (const WMap& tether : maps)
+    if (tether.distance)
+      {
+	std::map<uint64_t, size_t> pairs;
+	for (const auto& entry : tether.map)
+	  ++pairs[entry.first];
+	for (const auto& entry : map)
+	  ++pairs[entry.first];
+
+	size_t distance = 0;
+	for (const auto& entry : pairs)
+	  distance += (entry.second == 1);
+
+	if (distance <= tether.distance)
+	  {
+	    ++applicable;
+	    W += tether.W;
+	  }
+      }
+
+  return W / (applicable + (applicable == 0));
+}
+
+void checkCMapWeights(const DynNewtonianMCCMap& dynamics, CaptureMap& current, const std::vector<WMap>& maps)
+{
+  std::uniform_int_distribution<size_t> mapdist(0, maps.size() - 1);
+  for (size_t i(0); i < 200; ++i)
+    {
+      //Use a loaded map half of the time, so that there are matches
+      current.clear();
+      if (i % 2)
+	for (const auto& entry : maps[mapdist(RNG)].map)
+	  current.set(entry.first, entry.second);
+      else
+	{
+	  const CaptureMap map = randomMap();
+	  for (const auto& entry : map)
+	    current.set(entry.first, entry.second);
+	}
+
+      const CaptureMapKey key(current);
+      BOOST_CHECK_SMALL(dynamics.W(key) - referenceW(maps, key), 1e-12);
+
+      //Every change of the state of a single pair
+      for (size_t ID1(0); ID1 < maxID; ++ID1)
+	for (size_t ID2(ID1 + 1); ID2 < maxID; ++ID2)
+	  for (size_t state(0); state < 3; ++state)
+	    {
+	      const PairKey pair(ID1, ID2);
+	      CaptureMap changed;
+	      for (const auto& entry : current)
+		changed.set(entry.first, entry.second);
+	      changed.set(pair, state);
+	      BOOST_CHECK_SMALL(dynamics.W(pair, state) - referenceW(maps, CaptureMapKey(changed)), 1e-12);
+	    }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( NewtonianMCCMap_weights )
+{
+  Simulation Sim;
+  init(Sim);
+
+  const std::vector<WMap> maps1 = randomCMapWeights();
+  const std::vector<WMap> maps2 = randomCMapWeights();
+  XMLString xml1(toXML(maps1));
+  XMLString xml2(toXML(maps2));
+
+  Sim.dynamics = shared_ptr<Dynamics>(new DynNewtonianMCCMap(&Sim, xml1.getNode()));
+  DynNewtonianMCCMap other(&Sim, xml2.getNode());
+  Sim.initialise();
+
+  DynNewtonianMCCMap& dynamics = static_cast<DynNewtonianMCCMap&>(*Sim.dynamics);
+  CaptureMap& current = static_cast<ISquareWell&>(*Sim.interactions[0]);
+  checkCMapWeights(dynamics, current, maps1);
+
+  //The sorted single maps are exchanged along with the distance maps
+  dynamics.replicaExchange(other);
+  checkCMapWeights(dynamics, current, maps2);
+
+  for (size_t i(0); i < 100; ++i)
+    {
+      const CaptureMapKey key(randomMap());
+      BOOST_CHECK_SMALL(other.W(key) - referenceW(maps1, key), 1e-12);
+    }
+}
@@ -0,0 +1,135 @@
+#define BOOST_TEST_MODULE RandomStreams_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/randomstreams.hpp>
+#include <magnet/xmlwriter.hpp>
+#include <magnet/xmlreader.hpp>
+#include <random>
+#include <vector>
+
+using namespace dynamo;
+
+auto RNG = std::mt19937(std::random_device()());
+
+//Draw words from a stream
+std::vector<uint32_t> draw(magnet::math::Philox& stream, size_t N)
+{
+  std::vector<uint32_t> words;
+  for (size_t i(0); i < N; ++i)
+    words.push_back(stream());
+  return words;
+}
+
+//Checkpoint the streams through a configuration file and restore
+//them into a new store
+void checkpoint(const RandomStreams& streams, RandomStreams& restored)
+{
+  {
+    magnet::xml::XmlStream XML;
+    XML << streams;
+    XML.write_file("randomstreams.xml");
+  }
+  magnet::xml::Document doc("randomstreams.xml");
+  restored << doc.getNode("RandomStreams");
+}
+
+BOOST_AUTO_TEST_CASE( RandomStreams_checkpoint )
+{
+  RandomStreams streams;
+  streams.seed((uint64_t(RNG()) << 32) | RNG());
+
+  //The streams are left part way through a block of four words
+  draw(streams(RandomStreams::SYSTEM, 3), 7);
+  draw(streams(RandomStreams::PLUGIN, 0), 1);
+  streams(RandomStreams::THREAD, 2);
+
+  RandomStreams restored;
+  checkpoint(streams, restored);
+  BOOST_CHECK(restored.isSeeded());
+  BOOST_CHECK_EQUAL(restored.getSeed(), streams.getSeed());
+
+  //The restored streams continue where the checkpointed ones were,
+  //and are unaffected by the order they are fetched in
+  for (RandomStreams::Kind kind : {RandomStreams::THREAD, RandomStreams::PLUGIN, RandomStreams::SYSTEM})
+    {
+      const uint64_t index = (kind == RandomStreams::SYSTEM) ? 3 : ((kind == RandomStreams::THREAD) ? 2 : 0);
+      magnet::math::Philox& stream = streams(kind, index);
+      magnet::math::Philox& restoredStream = restored(kind, index);
+      BOOST_CHECK_EQUAL(restoredStream.tell(), stream.tell());
+      const std::vector<uint32_t> expected = draw(stream, 21);
+      const std::vector<uint32_t> words = draw(restoredStream, 21);
+      BOOST_CHECK_EQUAL_COLLECTIONS(words.begin(), words.end(), expected.begin(), expected.end());
+    }
+
+  //Loading a checkpoint discards the streams of the store
+  RandomStreams other;
+  other.seed(1);
+  draw(other(RandomStreams::PARTICLE, 5), 3);
+  checkpoint(streams, other);
+  BOOST_CHECK_EQUAL(other.getSeed(), streams.getSeed());
+  BOOST_CHECK_EQUAL(other(RandomStreams::PARTICLE, 5).tell(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( RandomStreams_seek )
+{
+  RandomStreams streams;
+  streams.seed(RNG());
+
+  magnet::math::Philox reference = streams.getStream(RandomStreams::PARTICLE, 11);
+  const std::vector<uint32_t> words = draw(reference, 40);
+
+  //A stateless stream started at any position, or seeked there
+  //after being part drawn, gives the words of an unbroken stream
+  for (uint64_t position(0); position < 14; ++position)
+    {
+      magnet::math::Philox stream = streams.getStream(RandomStreams::PARTICLE, 11, position);
+      BOOST_CHECK_EQUAL(stream.tell(), position);
+      for (size_t i(position); i < position + 13; ++i)
+	BOOST_CHECK_EQUAL(stream(), words[i]);
+      BOOST_CHECK_EQUAL(stream.tell(), position + 13);
+
+      stream.seek(position);
+      BOOST_CHECK_EQUAL(stream.tell(), position);
+      BOOST_CHECK_EQUAL(stream(), words[position]);
+      BOOST_CHECK_EQUAL(stream.tell(), position + 1);
+    }
+
+  //Streams of different indices and kinds are distinct
+  BOOST_CHECK(streams.getStream(RandomStreams::PARTICLE, 12)() != words[0]);
+  BOOST_CHECK(streams.getStream(RandomStreams::THREAD, 11)() != words[0]);
+}
+
+BOOST_AUTO_TEST_CASE( RandomStreams_startup_seed )
+{
+  RandomStreams streams;
+  streams.seed(RNG());
+  draw(streams(RandomStreams::SYSTEM, 0), 5);
+
+  //Without an explicit seed, a loaded state is continued
+  RandomStreams continued;
+  checkpoint(streams, continued);
+  continued.startupSeed(streams.getSeed() + 1, false);
+  BOOST_CHECK_EQUAL(continued.getSeed(), streams.getSeed());
+  BOOST_CHECK_EQUAL(continued(RandomStreams::SYSTEM, 0).tell(), 5);
+  BOOST_CHECK_EQUAL(continued(RandomStreams::SYSTEM, 0)(), streams(RandomStreams::SYSTEM, 0)());
+
+  //An explicit seed restarts the loaded streams, as if the store had
+  //been freshly seeded
+  const uint64_t seed = streams.getSeed() + 1;
+  RandomStreams fresh;
+  fresh.seed(seed);
+  RandomStreams reseeded;
+  checkpoint(streams, reseeded);
+  reseeded.startupSeed(seed, true);
+  BOOST_CHECK_EQUAL(reseeded.getSeed(), seed);
+  BOOST_CHECK_EQUAL(reseeded(RandomStreams::SYSTEM, 0).tell(), 0);
+  const std::vector<uint32_t> expected = draw(fresh(RandomStreams::SYSTEM, 0), 9);
+  const std::vector<uint32_t> words = draw(reseeded(RandomStreams::SYSTEM, 0), 9);
+  BOOST_CHECK_EQUAL_COLLECTIONS(words.begin(), words.end(), expected.begin(), expected.end());
+
+  //Without a loaded state, the passed seed is always used
+  RandomStreams unseeded;
+  BOOST_CHECK(!unseeded.isSeeded());
+  unseeded.startupSeed(seed, false);
+  BOOST_CHECK(unseeded.isSeeded());
+  BOOST_CHECK_EQUAL(unseeded.getSeed(), seed);
+}
@@ -14,6 +14,7 @@
 #include <dynamo/interactions/hardsphere.hpp>
 #include <dynamo/outputplugins/misc.hpp>
 #include <dynamo/outputplugins/msd.hpp>
+#include <dynamo/globals/cellsShearing.hpp>
 #include <random>
 
 std::mt19937 RNG;
@@ -104,6 +105,32 @@ BOOST_AUTO_TEST_CASE( Equilibrium_Simulation )
   BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
 }
 
+BOOST_AUTO_TEST_CASE( Overlinked_Simulation )
+{
+  dynamo::Simulation Sim;
+  init(Sim, 0.5);
+
+  //Provide the scheduler with an overlinked shearing neighbour list
+  dynamo::shared_ptr<dynamo::GCellsShearing> nblist(new dynamo::GCellsShearing(&Sim, "SchedulerNBList"));
+  nblist->setOverlink(2);
+  Sim.globals.push_back(nblist);
+
+  Sim.endEventCount = 500000;
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+
+  Sim.reset();
+  Sim.endEventCount = 1000000;
+  Sim.addOutputPlugin("Misc"); 
+  Sim.initialise();
+  while (Sim.runSimulationStep()) {}
+
+  const double expectedMFT = 0.113195634;
+  dynamo::OPMisc& opMisc = *Sim.getOutputPlugin<dynamo::OPMisc>();
+  BOOST_CHECK_CLOSE(opMisc.getMFT(), expectedMFT, 1);
+  BOOST_CHECK_MESSAGE(Sim.checkSystem() <= 1, "There are more than two invalid states in the final configuration");
+}
+
 BOOST_AUTO_TEST_CASE( Compression_Simulation )
 {
   dynamo::Simulation Sim;
@@ -0,0 +1,194 @@
+#define BOOST_TEST_MODULE SteppedTable_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/inputplugins/include.hpp>
+#include <dynamo/interactions/stepped.hpp>
+#include <dynamo/interactions/potentials/potential.hpp>
+#include <dynamo/interactions/potentials/lennard_jones.hpp>
+#include <random>
+#include <thread>
+
+auto RNG = std::mt19937(std::random_device()());
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+typedef std::pair<double,double> Step;
+
+//Exposes the compiled step table of IStepped
+struct TestStepped: public dynamo::IStepped
+{
+  TestStepped(dynamo::Simulation* sim, dynamo::shared_ptr<dynamo::Potential> potential):
+    IStepped(sim, potential, new dynamo::IDPairRangeAll(), "Bulk", 1.0, 1.0)
+  {}
+
+  using IStepped::StepData;
+  using IStepped::getStep;
+  using IStepped::calculateStepID;
+  using IStepped::_steps;
+  using IStepped::_radii;
+  using IStepped::_uniformSpacing;
+  using IStepped::_potential;
+};
+
+TestStepped& init(dynamo::Simulation& Sim, dynamo::shared_ptr<dynamo::Potential> potential, const double boxSize = 12)
+{
+  Sim.ranGenerator.seed(std::random_device()());
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  //By default, the lattice spacing is beyond the range of the potentials
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUSC(std::array<long, 3>{{4, 4, 4}}, dynamo::Vector{boxSize, boxSize, boxSize}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{boxSize, boxSize, boxSize};
+
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new TestStepped(&Sim, potential)));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+
+  std::normal_distribution<double> normal_dist;
+  unsigned long nParticles = 0;
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, dynamo::Vector{normal_dist(RNG), normal_dist(RNG), normal_dist(RNG)}, nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+  Sim.initialise();
+  return static_cast<TestStepped&>(*Sim.interactions.front());
+}
+
+//Check a step against the data calculated directly by the Potential
+void checkStep(const TestStepped& interaction, const size_t ID)
+{
+  const dynamo::Potential& potential = *interaction._potential;
+  const TestStepped::StepData step = interaction.getStep(ID);
+  const std::pair<double, double> bounds = potential.getStepBounds(ID);
+  BOOST_CHECK_EQUAL(step.inner, bounds.first);
+  BOOST_CHECK_EQUAL(step.outer, bounds.second);
+  BOOST_CHECK_EQUAL(step.inner2, bounds.first * bounds.first);
+  BOOST_CHECK_EQUAL(step.outer2, bounds.second * bounds.second);
+  BOOST_CHECK_EQUAL(step.energy, potential.getEnergyChange(0, ID));
+}
+
+void checkTable(const TestStepped& interaction)
+{
+  const dynamo::Potential& potential = *interaction._potential;
+  BOOST_CHECK_EQUAL(interaction._steps.size(), potential.steps() + 1);
+  BOOST_CHECK_EQUAL(interaction._radii.size(), potential.steps());
+
+  for (size_t ID(0); ID <= potential.steps(); ++ID)
+    checkStep(interaction, ID);
+
+  for (size_t ID(0); ID < potential.steps(); ++ID)
+    BOOST_CHECK_EQUAL(interaction._radii[ID], potential[ID].first);
+
+  //The step ID of a separation, including those on the
+  //discontinuities
+  std::uniform_real_distribution<double> rdist(0, 1.5);
+  for (size_t i(0); i < 1000; ++i)
+    {
+      const double r = rdist(RNG);
+      BOOST_CHECK_EQUAL(interaction.calculateStepID(r), potential.calculateStepID(r));
+    }
+
+  for (size_t ID(0); ID < potential.steps(); ++ID)
+    {
+      const double r = potential[ID].first;
+      BOOST_CHECK_EQUAL(interaction.calculateStepID(r), potential.calculateStepID(r));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Uniform_Steps )
+{
+  std::vector<Step> steps;
+  for (size_t i(0); i < 10; ++i)
+    steps.push_back(Step{1.0 - 0.1 * i, 0.1 * (i + 1)});
+
+  dynamo::Simulation Sim;
+  const TestStepped& interaction = init(Sim, dynamo::shared_ptr<dynamo::Potential>(new dynamo::PotentialStepped(steps, false)));
+  BOOST_CHECK(interaction._uniformSpacing != 0);
+  checkTable(interaction);
+}
+
+BOOST_AUTO_TEST_CASE( NonUniform_Steps )
+{
+  std::vector<Step> steps;
+  steps.push_back(Step{1.5, -0.5});
+  steps.push_back(Step{1.2, -1.0});
+  steps.push_back(Step{1.1, -0.2});
+  steps.push_back(Step{0.7, 2.0});
+  steps.push_back(Step{0.65, 5.0});
+  steps.push_back(Step{0.2, std::numeric_limits<double>::infinity()});
+
+  dynamo::Simulation Sim;
+  const TestStepped& interaction = init(Sim, dynamo::shared_ptr<dynamo::Potential>(new dynamo::PotentialStepped(steps, false)));
+  BOOST_CHECK_EQUAL(interaction._uniformSpacing, 0);
+  checkTable(interaction);
+}
+
+BOOST_AUTO_TEST_CASE( Unbounded_Steps )
+{
+  //Lennard-Jones with energy stepping has an unbounded number of
+  //steps, so steps beyond the table are calculated on demand.
+  dynamo::Simulation Sim;
+  const TestStepped& interaction = init(Sim, dynamo::shared_ptr<dynamo::Potential>(new dynamo::PotentialLennardJones(1.0, 1.0, 2.5, dynamo::PotentialLennardJones::MIDPOINT, dynamo::PotentialLennardJones::DELTAU, 10)));
+  const size_t tableSize = interaction._steps.size();
+  BOOST_CHECK(tableSize > 0);
+
+  //The steps beyond the table are accessed from several threads, as
+  //they are when events are predicted in parallel.
+  const size_t maxID = tableSize + 100;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<size_t> > stepIDs(4);
+  for (size_t t(0); t < stepIDs.size(); ++t)
+    threads.push_back(std::thread([&, t]() {
+	  for (size_t ID(maxID); ID > 0; --ID)
+	    {
+	      const TestStepped::StepData step = interaction.getStep(ID);
+	      stepIDs[t].push_back(interaction.calculateStepID(0.5 * (step.inner + step.outer)));
+	    }
+	}));
+  for (std::thread& thread : threads)
+    thread.join();
+
+  //The table has not been modified
+  BOOST_CHECK_EQUAL(interaction._steps.size(), tableSize);
+
+  for (const std::vector<size_t>& IDs : stepIDs)
+    for (size_t i(0); i < IDs.size(); ++i)
+      BOOST_CHECK_EQUAL(IDs[i], maxID - i);
+
+  for (size_t ID(0); ID <= maxID; ++ID)
+    checkStep(interaction, ID);
+}
+
+BOOST_AUTO_TEST_CASE( Unbounded_Steps_Growth )
+{
+  //The particles start within the range of the potential, so the
+  //pairs fall onto steps deeper than the initial table.
+  dynamo::Simulation Sim;
+  TestStepped& interaction = init(Sim, dynamo::shared_ptr<dynamo::Potential>(new dynamo::PotentialLennardJones(1.0, 1.0, 2.5, dynamo::PotentialLennardJones::MIDPOINT, dynamo::PotentialLennardJones::DELTAU, 10)), 6);
+  const size_t tableSize = interaction._steps.size();
+
+  Sim.endEventCount = 20000;
+  while (Sim.runSimulationStep()) {}
+
+  //The table is extended by the events, and always covers the steps
+  //of the captured pairs
+  size_t deepest = 0;
+  for (const auto& entry : static_cast<const dynamo::detail::CaptureMap&>(interaction))
+    deepest = std::max(deepest, entry.second);
+  BOOST_CHECK(deepest >= tableSize);
+  BOOST_CHECK(deepest < interaction._steps.size());
+
+  for (size_t ID(0); ID < interaction._steps.size(); ++ID)
+    checkStep(interaction, ID);
+  BOOST_CHECK_EQUAL(interaction._radii.size(), interaction._steps.size());
+  for (size_t ID(0); ID < interaction._radii.size(); ++ID)
+    BOOST_CHECK_EQUAL(interaction._radii[ID], (*interaction._potential)[ID].first);
+}
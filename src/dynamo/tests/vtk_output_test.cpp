@@ -0,0 +1,192 @@
+#define BOOST_TEST_MODULE VTKOutput_test
+#include <boost/test/included/unit_test.hpp>
+#include <dynamo/simulation.hpp>
+#include <dynamo/BC/include.hpp>
+#include <dynamo/ranges/include.hpp>
+#include <dynamo/inputplugins/cells/include.hpp>
+#include <dynamo/species/point.hpp>
+#include <dynamo/dynamics/newtonian.hpp>
+#include <dynamo/schedulers/include.hpp>
+#include <dynamo/schedulers/sorters/boundedPQFEL.hpp>
+#include <dynamo/schedulers/sorters/MinMaxPEL.hpp>
+#include <dynamo/interactions/hardsphere.hpp>
+#include <dynamo/outputplugins/tickerproperty/vtk.hpp>
+#include <magnet/xmlreader.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <regex>
+#include <sstream>
+#ifdef DYNAMO_zlib_support
+# include <zlib.h>
+#endif
+
+auto RNG = std::mt19937(std::random_device()());
+typedef dynamo::BoundedPQFEL<dynamo::MinMaxPEL<3> > DefaultSorter;
+
+//! \brief The values of a DataArray, as the raw bytes of its Float32 or Int32 data.
+typedef std::map<std::string, std::vector<char> > DataArrays;
+
+void init(dynamo::Simulation& Sim)
+{
+  Sim.ranGenerator.seed(std::random_device()());
+  Sim.dynamics = dynamo::shared_ptr<dynamo::Dynamics>(new dynamo::DynNewtonian(&Sim));
+  Sim.BCs = dynamo::shared_ptr<dynamo::BoundaryCondition>(new dynamo::BCPeriodic(&Sim));
+  Sim.ptrScheduler = dynamo::shared_ptr<dynamo::SNeighbourList>(new dynamo::SNeighbourList(&Sim, new DefaultSorter()));
+
+  std::unique_ptr<dynamo::UCell> packptr(new dynamo::CUFCC(std::array<long, 3>{{5, 5, 5}}, dynamo::Vector{1, 1, 1}, new dynamo::UParticle()));
+  packptr->initialise();
+  std::vector<dynamo::Vector> latticeSites(packptr->placeObjects(dynamo::Vector{0,0,0}));
+  Sim.primaryCellSize = dynamo::Vector{1, 1, 1};
+
+  Sim.interactions.push_back(dynamo::shared_ptr<dynamo::Interaction>(new dynamo::IHardSphere(&Sim, 0.05, 1.0, new dynamo::IDPairRangeAll(), "Bulk")));
+  Sim.addSpecies(dynamo::shared_ptr<dynamo::Species>(new dynamo::SpPoint(&Sim, new dynamo::IDRangeAll(&Sim), 1.0, "Bulk", 0)));
+
+  std::normal_distribution<double> normal_dist;
+  unsigned long nParticles = 0;
+  for (const dynamo::Vector & position : latticeSites)
+    Sim.particles.push_back(dynamo::Particle(position, dynamo::Vector{normal_dist(RNG), normal_dist(RNG), normal_dist(RNG)}, nParticles++));
+
+  Sim.ensemble = dynamo::Ensemble::loadEnsemble(Sim);
+  Sim.initialise();
+}
+
+//Write the first frame of an OPVTK with the passed options, returning the VTU file
+std::string writeFrame(dynamo::Simulation& Sim, const std::string& options)
+{
+  std::vector<char> xml;
+  const std::string tag = "<OP Type=\"VTK\" Fields=\"Velocity Species ID KineticEnergy\" " + options + "/>";
+  xml.assign(tag.begin(), tag.end());
+  xml.push_back('\0');
+  rapidxml::xml_document<> doc;
+  doc.parse<0>(xml.data());
+
+  {
+    dynamo::OPVTK vtk(&Sim, magnet::xml::Node(doc.first_node(), NULL));
+    vtk.initialise();
+    //The frame is written out by the destructor
+  }
+
+  std::ifstream file("paraview00000.vtu", std::ios::binary);
+  BOOST_REQUIRE(file);
+  std::ostringstream os;
+  os << file.rdbuf();
+  return os.str();
+}
+
+template<class T>
+void appendValues(std::vector<char>& data, const std::string& text)
+{
+  std::istringstream is(text);
+  T value;
+  while (is >> value)
+    {
+      const char* ptr = reinterpret_cast<const char*>(&value);
+      data.insert(data.end(), ptr, ptr + sizeof(T));
+    }
+}
+
+DataArrays parseAscii(const std::string& file)
+{
+  DataArrays arrays;
+  const std::regex dataArray("<DataArray type=\"(\\w+)\"(?: Name=\"(\\w+)\")? NumberOfComponents=\"\\d+\" format=\"ascii\">\n([^<]*)</DataArray>");
+  for (std::sregex_iterator it(file.begin(), file.end(), dataArray), end; it != end; ++it)
+    {
+      std::vector<char>& data = arrays[(*it)[2].matched ? (*it)[2].str() : "Points"];
+      if ((*it)[1] == "Int32")
+	appendValues<int32_t>(data, (*it)[3]);
+      else
+	appendValues<float>(data, (*it)[3]);
+    }
+  return arrays;
+}
+
+uint64_t readUInt64(const std::string& file, size_t& pos)
+{
+  BOOST_REQUIRE(pos + sizeof(uint64_t) <= file.size());
+  uint64_t value;
+  std::memcpy(&value, file.data() + pos, sizeof(uint64_t));
+  pos += sizeof(uint64_t);
+  return value;
+}
+
+//Decode the appended data arrays of a binary VTU file
+DataArrays parseAppended(const std::string& file, const bool compressed)
+{
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const size_t appended = file.find(marker);
+  BOOST_REQUIRE(appended != std::string::npos);
+  const std::string header = file.substr(0, appended);
+  BOOST_CHECK_EQUAL(compressed, header.find("compressor=\"vtkZLibDataCompressor\"") != std::string::npos);
+
+  DataArrays arrays;
+  const std::regex dataArray("<DataArray type=\"\\w+\"(?: Name=\"(\\w+)\")? NumberOfComponents=\"\\d+\" format=\"appended\" offset=\"(\\d+)\"/>");
+  for (std::sregex_iterator it(header.begin(), header.end(), dataArray), end; it != end; ++it)
+    {
+      std::vector<char>& data = arrays[(*it)[1].matched ? (*it)[1].str() : "Points"];
+      size_t pos = appended + marker.size() + std::stoull((*it)[2]);
+
+      if (!compressed)
+	{
+	  const uint64_t bytes = readUInt64(file, pos);
+	  BOOST_REQUIRE(pos + bytes <= file.size());
+	  data.assign(file.data() + pos, file.data() + pos + bytes);
+	  continue;
+	}
+
+#ifdef DYNAMO_zlib_support
+      //The vtkZLibDataCompressor header: the number of blocks, the
+      //block size, the size of the last block (zero if it is full),
+      //then the compressed size of each block.
+      const uint64_t blocks = readUInt64(file, pos);
+      const uint64_t blockSize = readUInt64(file, pos);
+      const uint64_t lastBlockSize = readUInt64(file, pos);
+      std::vector<uint64_t> compressedSizes;
+      for (size_t block(0); block < blocks; ++block)
+	compressedSizes.push_back(readUInt64(file, pos));
+
+      for (size_t block(0); block < blocks; ++block)
+	{
+	  uLongf size = ((block + 1 == blocks) && lastBlockSize) ? lastBlockSize : blockSize;
+	  std::vector<char> buffer(size);
+	  BOOST_REQUIRE(pos + compressedSizes[block] <= file.size());
+	  BOOST_REQUIRE_EQUAL(uncompress(reinterpret_cast<Bytef*>(buffer.data()), &size, reinterpret_cast<const Bytef*>(file.data() + pos), compressedSizes[block]), Z_OK);
+	  BOOST_CHECK_EQUAL(size, buffer.size());
+	  data.insert(data.end(), buffer.begin(), buffer.end());
+	  pos += compressedSizes[block];
+	}
+#endif
+    }
+  return arrays;
+}
+
+void checkArrays(const DataArrays& binary, const DataArrays& ascii, const size_t N)
+{
+  BOOST_REQUIRE_EQUAL(binary.size(), 5);
+  BOOST_REQUIRE_EQUAL(ascii.size(), binary.size());
+  BOOST_CHECK_EQUAL(ascii.at("Points").size(), N * 3 * 4);
+  BOOST_CHECK_EQUAL(ascii.at("Velocities").size(), N * 3 * 4);
+  BOOST_CHECK_EQUAL(ascii.at("ID").size(), N * 4);
+
+  //The ASCII output is written with enough digits to round trip
+  //exactly, so the values are compared bitwise
+  for (const auto& entry : binary)
+    {
+      BOOST_REQUIRE(ascii.count(entry.first));
+      BOOST_CHECK_MESSAGE(entry.second == ascii.at(entry.first), "The " << entry.first << " data arrays differ");
+    }
+}
+
+BOOST_AUTO_TEST_CASE( VTK_appended_data )
+{
+  dynamo::Simulation Sim;
+  init(Sim);
+
+  const DataArrays ascii = parseAscii(writeFrame(Sim, "Format=\"Ascii\""));
+  checkArrays(parseAppended(writeFrame(Sim, "Format=\"Binary\""), false), ascii, Sim.N());
+#ifdef DYNAMO_zlib_support
+  checkArrays(parseAppended(writeFrame(Sim, "Format=\"Binary\" Compress=\"\""), true), ascii, Sim.N());
+#endif
+}
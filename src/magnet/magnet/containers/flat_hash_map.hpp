@@ -0,0 +1,357 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+namespace magnet {
+  namespace containers {
+    template<class Key, class Mapped, class Hash> class FlatHashMap;
+
+    namespace detail {
+      /*! \brief The finaliser of MurmurHash3, used to spread the
+          bits of integer keys across the whole 64 bit word.
+
+	  Keys such as particle ID pairs are highly structured, and
+	  using them directly as a hash would leave most of the table
+	  groups unused.
+       */
+      inline uint64_t mix64(uint64_t k) {
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	return k;
+      }
+
+      //! \brief A hash functor for keys which convert to a 64 bit integer.
+      template<class Key>
+      struct WordHash {
+	uint64_t operator()(const Key& key) const { return mix64(uint64_t(key)); }
+      };
+
+      //! \brief Index of the lowest set bit of a non-zero mask.
+      inline size_t lowestBit(uint32_t mask) {
+#if defined(__GNUC__)
+	return __builtin_ctz(mask);
+#else
+	size_t i = 0;
+	while (!(mask & 1)) { mask >>= 1; ++i; }
+	return i;
+#endif
+      }
+
+      /*! \brief A group of control bytes of a FlatHashMap which are
+          tested together.
+
+	  Each control byte is either EMPTY, DELETED, or holds the low
+	  7 bits of the hash of the key stored in the corresponding
+	  slot. Where SSE2 is available the whole group is compared in
+	  a single instruction, otherwise a simple loop is used.
+       */
+      struct ProbeGroup {
+	static const size_t width = 16;
+	static const int8_t EMPTY = -128;
+	static const int8_t DELETED = -2;
+
+#ifdef __SSE2__
+	ProbeGroup(const int8_t* ctrl):
+	  _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+	//! \brief Bitmask of the slots whose control byte equals h2.
+	uint32_t match(int8_t h2) const
+	{ return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)); }
+
+	//! \brief Bitmask of the EMPTY slots.
+	uint32_t matchEmpty() const { return match(EMPTY); }
+
+	//! \brief Bitmask of the EMPTY or DELETED slots (sign bit set).
+	uint32_t matchFree() const { return _mm_movemask_epi8(_ctrl); }
+
+	__m128i _ctrl;
+#else
+	ProbeGroup(const int8_t* ctrl): _ctrl(ctrl) {}
+
+	uint32_t match(int8_t h2) const {
+	  uint32_t mask = 0;
+	  for (size_t i(0); i < width; ++i)
+	    mask |= uint32_t(_ctrl[i] == h2) << i;
+	  return mask;
+	}
+
+	uint32_t matchEmpty() const { return match(EMPTY); }
+
+	uint32_t matchFree() const {
+	  uint32_t mask = 0;
+	  for (size_t i(0); i < width; ++i)
+	    mask |= uint32_t(_ctrl[i] < 0) << i;
+	  return mask;
+	}
+
+	const int8_t* _ctrl;
+#endif
+      };
+
+      template<class Map, class Value>
+      class FlatHashMapIterator: public std::iterator<std::forward_iterator_tag, Value>
+      {
+      public:
+	FlatHashMapIterator(Map* map, size_t idx): _map(map), _idx(idx) { skip(); }
+
+	//Allow conversion from iterator to const_iterator
+	template<class OMap, class OValue>
+	FlatHashMapIterator(const FlatHashMapIterator<OMap, OValue>& o): _map(o._map), _idx(o._idx) {}
+
+	FlatHashMapIterator& operator++() { ++_idx; skip(); return *this; }
+	Value& operator*() const { return _map->_slots[_idx]; }
+	Value* operator->() const { return &(_map->_slots[_idx]); }
+	bool operator==(const FlatHashMapIterator& o) const { return _idx == o._idx; }
+	bool operator!=(const FlatHashMapIterator& o) const { return _idx != o._idx; }
+
+      private:
+	template<class OMap, class OValue> friend class FlatHashMapIterator;
+	template<class K, class M, class H> friend class containers::FlatHashMap;
+
+	void skip() { while ((_idx < _map->_capacity) && (_map->_ctrl[_idx] < 0)) ++_idx; }
+
+	Map* _map;
+	size_t _idx;
+      };
+    }
+
+    /*! \brief An open addressing hash map for keys which are a
+        single machine word.
+
+	All keys and values are stored in a single flat array, which
+	is probed in groups of 16 slots using a separate array of one
+	byte hash fragments (as in the "Swiss table" design). A lookup
+	therefore usually touches a single cache line of control bytes
+	and a single slot, which is considerably faster than the node
+	based std::unordered_map for the large and heavily modified
+	maps used to store pair states.
+
+	The Key type must be default constructible, comparable, and
+	convertible to a uint64_t for hashing. Iteration order is
+	arbitrary and depends on the insertion history.
+     */
+    template<class Key, class Mapped, class Hash = detail::WordHash<Key> >
+    class FlatHashMap
+    {
+      typedef detail::ProbeGroup Group;
+    public:
+      typedef Key key_type;
+      typedef Mapped mapped_type;
+      typedef std::pair<Key, Mapped> value_type;
+      typedef detail::FlatHashMapIterator<FlatHashMap, value_type> iterator;
+      typedef detail::FlatHashMapIterator<const FlatHashMap, const value_type> const_iterator;
+
+      FlatHashMap(): _capacity(0), _size(0), _deleted(0) {}
+
+      FlatHashMap(const FlatHashMap& o): _capacity(0), _size(0), _deleted(0) { *this = o; }
+
+      FlatHashMap(FlatHashMap&& o):
+	_ctrl(std::move(o._ctrl)), _slots(std::move(o._slots)),
+	_capacity(o._capacity), _size(o._size), _deleted(o._deleted)
+      { o._capacity = o._size = o._deleted = 0; }
+
+      FlatHashMap& operator=(const FlatHashMap& o) {
+	if (this == &o) return *this;
+	allocate(o._capacity);
+	if (_capacity)
+	  {
+	    std::memcpy(_ctrl.get(), o._ctrl.get(), _capacity);
+	    std::copy(o._slots.get(), o._slots.get() + _capacity, _slots.get());
+	  }
+	_size = o._size;
+	_deleted = o._deleted;
+	return *this;
+      }
+
+      FlatHashMap& operator=(FlatHashMap&& o) { swap(o); return *this; }
+
+      void swap(FlatHashMap& o) {
+	std::swap(_ctrl, o._ctrl);
+	std::swap(_slots, o._slots);
+	std::swap(_capacity, o._capacity);
+	std::swap(_size, o._size);
+	std::swap(_deleted, o._deleted);
+      }
+
+      iterator begin() { return iterator(this, 0); }
+      iterator end() { return iterator(this, _capacity); }
+      const_iterator begin() const { return const_iterator(this, 0); }
+      const_iterator end() const { return const_iterator(this, _capacity); }
+
+      size_t size() const { return _size; }
+      bool empty() const { return _size == 0; }
+      size_t capacity() const { return _capacity; }
+
+      iterator find(const key_type& key) { return iterator(this, findIndex(key)); }
+      const_iterator find(const key_type& key) const { return const_iterator(this, findIndex(key)); }
+      size_t count(const key_type& key) const { return findIndex(key) != _capacity; }
+
+      std::pair<iterator, bool> insert(const value_type& value) {
+	const size_t idx = findIndex(value.first);
+	if (idx != _capacity)
+	  return std::make_pair(iterator(this, idx), false);
+	return std::make_pair(iterator(this, insertNew(value)), true);
+      }
+
+      //! \brief Access an entry, inserting a default value if it is missing.
+      mapped_type& operator[](const key_type& key) {
+	size_t idx = findIndex(key);
+	if (idx == _capacity)
+	  idx = insertNew(value_type(key, mapped_type()));
+	return _slots[idx].second;
+      }
+
+      size_t erase(const key_type& key) {
+	const size_t idx = findIndex(key);
+	if (idx == _capacity) return 0;
+	eraseIndex(idx);
+	return 1;
+      }
+
+      void erase(const const_iterator& it) { eraseIndex(it._idx); }
+
+      //! \brief Remove all entries while keeping the allocated storage.
+      void clear() {
+	if (_capacity)
+	  std::memset(_ctrl.get(), Group::EMPTY, _capacity);
+	_size = _deleted = 0;
+      }
+
+      //! \brief Ensure n entries can be stored without a rehash.
+      void reserve(size_t n) {
+	size_t newcap = Group::width;
+	while (newcap * 7 < n * 8) newcap *= 2;
+	if (newcap > _capacity) rehash(newcap);
+      }
+
+    private:
+      template<class M, class V> friend class detail::FlatHashMapIterator;
+
+      size_t groupMask() const { return _capacity / Group::width - 1; }
+
+      /*! \brief Returns the slot index of the key, or _capacity if it
+          is not present.
+
+	  Groups are visited using triangular probing, which visits
+	  every group exactly once as the number of groups is a power
+	  of two. The search terminates at the first group containing
+	  an EMPTY slot, as an insertion would have used it.
+       */
+      size_t findIndex(const key_type& key) const {
+	if (_size == 0) return _capacity;
+	const uint64_t h = Hash()(key);
+	const int8_t h2 = h & 0x7F;
+	const size_t mask = groupMask();
+	size_t g = (h >> 7) & mask;
+	for (size_t step(1); ; ++step)
+	  {
+	    const Group group(_ctrl.get() + g * Group::width);
+	    for (uint32_t m = group.match(h2); m; m &= m - 1)
+	      {
+		const size_t idx = g * Group::width + detail::lowestBit(m);
+		if (_slots[idx].first == key) return idx;
+	      }
+	    if (group.matchEmpty()) return _capacity;
+	    g = (g + step) & mask;
+	  }
+      }
+
+      //! \brief Insert a value whose key is known not to be present.
+      size_t insertNew(const value_type& value) {
+	if ((_size + _deleted + 1) * 8 > _capacity * 7)
+	  //Grow if the live entries are the problem, otherwise just
+	  //clear out the DELETED markers
+	  rehash(((_size + 1) * 16 > _capacity * 7) ? std::max(2 * _capacity, size_t(Group::width)) : _capacity);
+
+	const uint64_t h = Hash()(value.first);
+	const size_t mask = groupMask();
+	size_t g = (h >> 7) & mask;
+	for (size_t step(1); ; ++step)
+	  {
+	    const uint32_t m = Group(_ctrl.get() + g * Group::width).matchFree();
+	    if (m)
+	      {
+		const size_t idx = g * Group::width + detail::lowestBit(m);
+		if (_ctrl[idx] == Group::DELETED) --_deleted;
+		_ctrl[idx] = h & 0x7F;
+		_slots[idx] = value;
+		++_size;
+		return idx;
+	      }
+	    g = (g + step) & mask;
+	  }
+      }
+
+      void eraseIndex(size_t idx) {
+#ifdef MAGNET_DEBUG
+	if ((idx >= _capacity) || (_ctrl[idx] < 0))
+	  M_throw() << "Erasing an invalid FlatHashMap entry";
+#endif
+	//If this group already has an EMPTY slot, no probe sequence
+	//can have continued past it and the slot may be simply
+	//emptied. Otherwise a DELETED marker must be left in place.
+	const size_t group_start = idx - idx % Group::width;
+	if (Group(_ctrl.get() + group_start).matchEmpty())
+	  _ctrl[idx] = Group::EMPTY;
+	else
+	  {
+	    _ctrl[idx] = Group::DELETED;
+	    ++_deleted;
+	  }
+	--_size;
+      }
+
+      void allocate(size_t capacity) {
+	_capacity = capacity;
+	_ctrl.reset(capacity ? new int8_t[capacity] : nullptr);
+	_slots.reset(capacity ? new value_type[capacity] : nullptr);
+	_size = _deleted = 0;
+      }
+
+      void rehash(size_t newcap) {
+	std::unique_ptr<int8_t[]> oldctrl(std::move(_ctrl));
+	std::unique_ptr<value_type[]> oldslots(std::move(_slots));
+	const size_t oldcap = _capacity;
+	allocate(newcap);
+	clear();
+	for (size_t i(0); i < oldcap; ++i)
+	  if (oldctrl[i] >= 0)
+	    insertNew(oldslots[i]);
+      }
+
+      std::unique_ptr<int8_t[]> _ctrl;
+      std::unique_ptr<value_type[]> _slots;
+      size_t _capacity;
+      size_t _size;
+      size_t _deleted;
+    };
+  }
+}
@@ -0,0 +1,207 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace magnet {
+  namespace containers {
+    /*! \brief A std::vector-like container with inline storage for
+        its first Ninline elements.
+
+      Unlike the StackVector, this container has no maximum size. It
+      only allocates memory on the heap once it grows beyond Ninline
+      elements, and this memory is retained by clear() so a
+      container which is reused does not allocate again.
+     */
+    template<class T, size_t Ninline>
+    class SmallVector
+    {
+    public:
+      typedef T value_type;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef T* iterator;
+      typedef const T* const_iterator;
+      typedef size_t size_type;
+
+      SmallVector(): _data(inlineData()), _size(0), _capacity(Ninline) {}
+
+      SmallVector(const SmallVector& other):
+	_data(inlineData()), _size(0), _capacity(Ninline)
+      {
+	reserve(other.size());
+	for (const T& val : other)
+	  push_back(val);
+      }
+
+      SmallVector(SmallVector&& other):
+	_data(inlineData()), _size(0), _capacity(Ninline)
+      { take(std::move(other)); }
+
+      ~SmallVector() { clear(); release(); }
+
+      SmallVector& operator=(const SmallVector& other)
+      {
+	if (this == &other) return *this;
+	clear();
+	reserve(other.size());
+	for (const T& val : other)
+	  push_back(val);
+	return *this;
+      }
+
+      SmallVector& operator=(SmallVector&& other)
+      {
+	if (this == &other) return *this;
+	clear();
+	release();
+	take(std::move(other));
+	return *this;
+      }
+
+      size_type size() const { return _size; }
+      size_type capacity() const { return _capacity; }
+      bool empty() const { return _size == 0; }
+      //! \brief Test if the elements are stored on the heap.
+      bool onHeap() const { return _data != inlineData(); }
+
+      iterator begin() { return _data; }
+      iterator end() { return _data + _size; }
+      const_iterator begin() const { return _data; }
+      const_iterator end() const { return _data + _size; }
+      const_iterator cbegin() const { return _data; }
+      const_iterator cend() const { return _data + _size; }
+
+      reference operator[](size_type i) { return _data[i]; }
+      const_reference operator[](size_type i) const { return _data[i]; }
+
+      reference front() { return _data[0]; }
+      const_reference front() const { return _data[0]; }
+      reference back() { return _data[_size - 1]; }
+      const_reference back() const { return _data[_size - 1]; }
+
+      void push_back(const T& val) { emplace_back(val); }
+      void push_back(T&& val) { emplace_back(std::move(val)); }
+
+      template<class... Args>
+      void emplace_back(Args&&... args)
+      {
+	if (_size == _capacity)
+	  {
+	    //The arguments may refer to an element of this container,
+	    //so the new element is constructed before the old storage
+	    //is released.
+	    const size_type n = std::max(2 * _capacity, size_type(1));
+	    T* newData = allocate(n);
+	    try {
+	      new (newData + _size) T(std::forward<Args>(args)...);
+	    } catch (...) {
+	      ::operator delete(newData);
+	      throw;
+	    }
+	    relocate(newData, n);
+	  }
+	else
+	  new (_data + _size) T(std::forward<Args>(args)...);
+	++_size;
+      }
+
+      void pop_back() {
+#ifdef MAGNET_DEBUG
+	if (empty())
+	  M_throw() << "Cannot pop elements from an empty SmallVector";
+#endif
+	_data[--_size].~T();
+      }
+
+      //! \brief Destroy all elements, but keep the allocated storage.
+      void clear()
+      {
+	for (size_t i(0); i < _size; ++i)
+	  _data[i].~T();
+	_size = 0;
+      }
+
+      void reserve(size_type n) { if (n > _capacity) grow(n); }
+
+    private:
+      T* inlineData() { return reinterpret_cast<T*>(&_inline); }
+      const T* inlineData() const { return reinterpret_cast<const T*>(&_inline); }
+
+      static T* allocate(size_type n)
+      { return static_cast<T*>(::operator new(n * sizeof(T))); }
+
+      void grow(size_type n)
+      {
+	n = std::max(n, size_type(1));
+	relocate(allocate(n), n);
+      }
+
+      //! \brief Move the elements into newData (of capacity n) and free the old storage.
+      void relocate(T* newData, size_type n)
+      {
+	for (size_t i(0); i < _size; ++i)
+	  {
+	    new (newData + i) T(std::move(_data[i]));
+	    _data[i].~T();
+	  }
+	release();
+	_data = newData;
+	_capacity = n;
+      }
+
+      //! \brief Free any heap storage (the container must be empty).
+      void release()
+      {
+	if (onHeap())
+	  ::operator delete(_data);
+	_data = inlineData();
+	_capacity = Ninline;
+      }
+
+      //! \brief Steal the contents of another (this must be empty and inline).
+      void take(SmallVector&& other)
+      {
+	if (other.onHeap())
+	  {
+	    _data = other._data;
+	    _size = other._size;
+	    _capacity = other._capacity;
+	    other._data = other.inlineData();
+	    other._size = 0;
+	    other._capacity = Ninline;
+	    return;
+	  }
+
+	for (T& val : other)
+	  emplace_back(std::move(val));
+	other.clear();
+      }
+
+      T* _data;
+      size_type _size;
+      size_type _capacity;
+      typename std::aligned_storage<sizeof(T) * (Ninline ? Ninline : 1), alignof(T)>::type _inline;
+    };
+  }
+}
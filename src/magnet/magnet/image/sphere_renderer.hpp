@@ -0,0 +1,162 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/vector.hpp>
+#include <magnet/exception.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace magnet {
+  namespace image {
+    /*! \brief A CPU renderer of shaded spheres, for generating images
+        without a display or an OpenGL context.
+
+      The spheres are viewed with an orthographic camera. Each sphere
+      is ray cast over the pixels of its bounding square, the exact
+      depth of the sphere surface is tested against a depth buffer
+      and the surface is lit by a single directional light (fixed
+      relative to the camera) with Lambertian and Blinn-Phong
+      shading. The cost is proportional to the number of pixels
+      covered by the spheres, so no acceleration structure is
+      required.
+
+      The image is stored as 8-bit RGB, top row first, ready to be
+      passed to writePNGFile().
+     */
+    class SphereRenderer
+    {
+    public:
+      typedef std::array<uint8_t, 3> Colour;
+
+      SphereRenderer(size_t width, size_t height):
+	_width(width), _height(height),
+	_image(3 * width * height), _depth(width * height)
+      {
+	if (!width || !height)
+	  M_throw() << "Cannot render an image of zero size";
+
+	setView(math::Vector{0, 0, 0}, math::Vector{0, 0, -1}, math::Vector{0, 1, 0}, 1);
+	clear();
+      }
+
+      /*! \brief Set the camera.
+
+	\param centre The point at the centre of the image.
+	\param viewDirection The direction the camera looks in.
+	\param up The direction which is up in the image (it is
+	orthogonalised against the view direction).
+	\param viewWidth The width of the image in simulation units.
+       */
+      void setView(const math::Vector& centre, const math::Vector& viewDirection,
+		   const math::Vector& up, double viewWidth)
+      {
+	_centre = centre;
+	_back = -viewDirection / viewDirection.nrm();
+	_up = up - (up | _back) * _back;
+	if (_up.nrm() == 0)
+	  M_throw() << "The up direction of the camera is parallel to the view direction";
+	_up /= _up.nrm();
+	_right = _up ^ _back;
+	_scale = _width / viewWidth;
+      }
+
+      //! \brief Fill the image with the background colour and reset the depth buffer.
+      void clear(const Colour& background = Colour{{255, 255, 255}})
+      {
+	for (size_t i(0); i < _width * _height; ++i)
+	  std::copy(background.begin(), background.end(), _image.begin() + 3 * i);
+	std::fill(_depth.begin(), _depth.end(), -std::numeric_limits<float>::infinity());
+      }
+
+      //! \brief Draw a sphere into the image.
+      void drawSphere(const math::Vector& position, double radius, const Colour& colour)
+      {
+	const math::Vector rel = position - _centre;
+	//The position of the sphere centre in pixels, and its depth
+	//(increasing towards the camera).
+	const double px = (rel | _right) * _scale + 0.5 * _width;
+	const double py = 0.5 * _height - (rel | _up) * _scale;
+	const double pz = rel | _back;
+	const double pr = radius * _scale;
+
+	const long xmin = std::max(long(0), long(std::floor(px - pr)));
+	const long xmax = std::min(long(_width) - 1, long(std::ceil(px + pr)));
+	const long ymin = std::max(long(0), long(std::floor(py - pr)));
+	const long ymax = std::min(long(_height) - 1, long(std::ceil(py + pr)));
+
+	//The light comes from the upper left, in camera coordinates,
+	//and the halfway vector between it and the viewer is used for
+	//the specular highlights.
+	const math::Vector light = math::Vector{-1, 1, 2} / std::sqrt(6.0);
+	math::Vector halfway = light + math::Vector{0, 0, 1};
+	halfway /= halfway.nrm();
+	const double ambient = 0.25;
+
+	const double pr2 = pr * pr;
+	for (long y(ymin); y <= ymax; ++y)
+	  for (long x(xmin); x <= xmax; ++x)
+	    {
+	      //The ray through the pixel centre
+	      const double dx = x + 0.5 - px;
+	      const double dy = py - (y + 0.5);
+	      const double d2 = dx * dx + dy * dy;
+	      if (d2 >= pr2) continue;
+
+	      const double dz = std::sqrt(pr2 - d2);
+	      const float depth = pz + dz / _scale;
+	      float& zbuf = _depth[y * _width + x];
+	      if (depth <= zbuf) continue;
+	      zbuf = depth;
+
+	      //The surface normal in camera coordinates, the light and
+	      //the viewer are fixed relative to the camera.
+	      const math::Vector normal{dx / pr, dy / pr, dz / pr};
+	      const double diffuse = std::max(0.0, normal | light);
+	      const double specular = std::pow(std::max(0.0, normal | halfway), 32);
+
+	      uint8_t* pixel = &_image[3 * (y * _width + x)];
+	      for (size_t c(0); c < 3; ++c)
+		pixel[c] = uint8_t(std::min(255.0, colour[c] * (ambient + (1 - ambient) * diffuse) + 96 * specular));
+	    }
+      }
+
+      std::vector<uint8_t>& getImage() { return _image; }
+      const std::vector<uint8_t>& getImage() const { return _image; }
+      size_t getWidth() const { return _width; }
+      size_t getHeight() const { return _height; }
+
+    private:
+      size_t _width;
+      size_t _height;
+      std::vector<uint8_t> _image;
+      std::vector<float> _depth;
+
+      math::Vector _centre;
+      math::Vector _right;
+      math::Vector _up;
+      //! \brief The direction towards the camera.
+      math::Vector _back;
+      //! \brief Pixels per simulation unit.
+      double _scale;
+    };
+  }
+}
@@ -18,6 +18,7 @@
 #pragma once
 #include <magnet/math/frenkelroot.hpp>
 #include <magnet/math/bisect.hpp>
+#include <magnet/math/vector.hpp>
 #include <array>
 #include <limits>
 
@@ -42,6 +43,55 @@ namespace magnet {
 	template<size_t d> double max() const { return _f.template max<d+derivative>(); }
       };
 
+      /*! \brief The time window in which two (possibly growing)
+	bounding spheres overlap.
+
+	This is a cheap and conservative pre-filter for the generic
+	algorithm: if two bodies are contained in spheres of
+	(combined) radius \f$G(t)\,R\f$ about their centres, where
+	\f$G(t)=1+\gamma^{-1}\,t\f$, they can only be in contact while
+	\f$|r_{ij}+v_{ij}\,\Delta t| \le G(t+\Delta t)\,R\f$. The root
+	search can then be restricted to this window.
+
+	\param rij2 The squared separation of the centres.
+	\param rvdot The dot product of the separation and relative velocity.
+	\param vij2 The squared relative velocity of the centres.
+	\param R The sum of the bounding radii at unit growth.
+	\param t The current time (used for the growth factor).
+	\param invgamma The growth rate.
+	\return The window [t_in, t_out] in \f$\Delta t\f$. If the
+	bounding spheres never overlap, t_in is HUGE_VAL. If the
+	window is unbounded (the spheres grow faster than they move)
+	the window is [-HUGE_VAL, HUGE_VAL].
+       */
+      inline std::pair<double, double>
+      boundingSphereWindow(const double rij2, const double rvdot, const double vij2, double R, const double t, const double invgamma)
+      {
+	//Slightly enlarge the spheres to keep the window
+	//conservative in the face of rounding errors.
+	R *= 1 + 1e-8;
+	const double G0 = 1 + invgamma * t;
+	const double a = vij2 - invgamma * invgamma * R * R;
+	const double b = 2 * (rvdot - G0 * invgamma * R * R);
+	const double c = rij2 - G0 * G0 * R * R;
+
+	if (a <= 0) return std::pair<double, double>(-HUGE_VAL, HUGE_VAL);
+
+	const double arg = b * b - 4 * a * c;
+	if (arg < 0) return std::pair<double, double>(HUGE_VAL, HUGE_VAL);
+
+	//Stable form of the quadratic roots
+	const double q = -0.5 * (b + std::copysign(std::sqrt(arg), b));
+	const double root1 = q / a;
+	const double root2 = (q != 0) ? c / q : 0;
+	return std::pair<double, double>(std::min(root1, root2), std::max(root1, root2));
+      }
+
+      //! \brief A convenience form of boundingSphereWindow taking the centre kinematics.
+      inline std::pair<double, double>
+      boundingSphereWindow(const math::Vector& rij, const math::Vector& vij, const double R, const double t, const double invgamma)
+      { return boundingSphereWindow(rij.nrm2(), (rij | vij), vij.nrm2(), R, t, invgamma); }
+
       template <class Base> 
       class FBisect_Wrapper
       {
@@ -19,6 +19,9 @@
 #include <magnet/math/vector.hpp>
 #include <magnet/math/quaternion.hpp>
 #include <magnet/intersection/generic_algorithm.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace magnet {
   namespace intersection {
@@ -32,7 +35,8 @@ namespace magnet {
 	OffcentreSpheresOverlapFunction(const math::Vector& rij, const math::Vector& vij, const math::Vector& omegai, const math::Vector& omegaj,
 					const math::Vector& nu1, const math::Vector& nu2, const double diameter1, const double diameter2, 
 					const double maxdist, const double t, const double invgamma, const double t_min, const double t_max):
-	  w1(omegai), w2(omegaj), u1(nu1), u2(nu2), r12(rij), v12(vij), _diameter1(diameter1), _diameter2(diameter2), _invgamma(invgamma), _t(t), _t_min(t_min), _t_max(t_max)
+	  w1(omegai), w2(omegaj), u1(nu1), u2(nu2), r12(rij), v12(vij), _diameter1(diameter1), _diameter2(diameter2), _invgamma(invgamma), _t(t), _t_min(t_min), _t_max(t_max),
+	  _cached_dt(std::numeric_limits<double>::quiet_NaN())
 	{
 	  double Gmax = std::max(1 + t * invgamma, 1 + (t + t_max) * invgamma);
 	  const double sigmaij = 0.5 * (_diameter1 + _diameter2);
@@ -56,8 +60,16 @@ namespace magnet {
 	template<size_t first_deriv=0, size_t nderivs = 1>
 	std::array<double, nderivs> eval(const double dt = 0) const
 	{
-	  math::Vector u1new = Rodrigues(w1 * dt) * math::Vector(u1);
-	  math::Vector u2new = Rodrigues(w2 * dt) * math::Vector(u2);
+	  //The root finders repeatedly evaluate the function at the same
+	  //time, so the rotated offsets of the last time are cached.
+	  if (dt != _cached_dt)
+	    {
+	      _u1new = Rodrigues(w1 * dt) * math::Vector(u1);
+	      _u2new = Rodrigues(w2 * dt) * math::Vector(u2);
+	      _cached_dt = dt;
+	    }
+	  const math::Vector& u1new = _u1new;
+	  const math::Vector& u2new = _u2new;
 
 	  const double colldiam = 0.5 * (_diameter1 + _diameter2);
 	  const double growthfactor = 1 + _invgamma * (_t + dt);
@@ -92,8 +104,18 @@ namespace magnet {
 	    }
 	}
 
+	/*! \brief The next event in [t_min, t_max].
+	  
+	  The search is first restricted to the window where the
+	  spheres bounding the two offcentre spheres (about the
+	  centres of rotation) overlap.
+	 */
 	std::pair<bool, double> nextEvent() const {
-	  return magnet::intersection::nextEvent(*this, _t_min, _t_max);
+	  const std::pair<double, double> window = boundingSphereWindow(r12, v12, u1.nrm() + u2.nrm() + 0.5 * (_diameter1 + _diameter2), _t, _invgamma);
+	  const double t_min = std::max(_t_min, window.first);
+	  const double t_max = std::min(_t_max, window.second);
+	  if (t_min > t_max) return std::pair<bool, double>(false, HUGE_VAL);
+	  return magnet::intersection::nextEvent(*this, t_min, t_max);
 	}
   
       private:
@@ -107,7 +129,118 @@ namespace magnet {
 	const double _diameter1, _diameter2, _invgamma;
 	double _t, _f1max, _f2max, _f3max;
 	const double _t_min, _t_max;
+
+	mutable double _cached_dt;
+	mutable math::Vector _u1new, _u2new;
       };
     }
+
+    /*! \brief Event detection between two bodies built from several
+        offcentre spheres (e.g., dumbbells).
+
+      Every pair of spheres between the two bodies is a candidate
+      for the next event. The bounding sphere windows of all the
+      candidates are calculated together, in a single pass over flat
+      arrays, as they only differ in their bounding radii. The
+      candidates are then root searched in order of their window
+      opening, with the search window capped at the earliest event
+      found so far. Once a window opens after this event, all the
+      remaining candidates are skipped without evaluating their
+      overlap functions.
+     */
+    class OffcentreSpheresBatch
+    {
+    public:
+      /*! \param rij The separation of the centres of rotation.
+        \param vij The relative velocity of the centres.
+        \param omegai The angular velocity of the first body.
+        \param omegaj The angular velocity of the second body.
+        \param maxdist The maximum separation of the centres over the search.
+        \param t The current time (used for the growth factor).
+        \param invgamma The growth rate.
+       */
+      OffcentreSpheresBatch(const math::Vector& rij, const math::Vector& vij, const math::Vector& omegai, const math::Vector& omegaj,
+			    const double maxdist, const double t, const double invgamma):
+	_rij(rij), _vij(vij), _omegai(omegai), _omegaj(omegaj), _maxdist(maxdist), _t(t), _invgamma(invgamma)
+      {}
+
+      //! \brief Add a sphere of the first body, at offset u from its centre.
+      void addSphere1(const math::Vector& u, const double diameter)
+      { _spheres1.push_back(Sphere{u, diameter, u.nrm() + 0.5 * diameter}); }
+
+      //! \brief Add a sphere of the second body, at offset u from its centre.
+      void addSphere2(const math::Vector& u, const double diameter)
+      { _spheres2.push_back(Sphere{u, diameter, u.nrm() + 0.5 * diameter}); }
+
+      /*! \brief The earliest event of any pair of spheres in [t_min, t_max).
+
+	\return The earliest result of the per-pair nextEvent()
+	calls, or (false, HUGE_VAL) if no pair has an event before
+	t_max.
+       */
+      std::pair<bool, double> nextEvent(const double t_min, const double t_max) const
+      {
+	const size_t N1 = _spheres1.size();
+	const size_t N2 = _spheres2.size();
+	const size_t N = N1 * N2;
+
+	//All candidates share the same centre kinematics, and only
+	//differ in their bounding radii.
+	const double r2 = _rij.nrm2();
+	const double rv = (_rij | _vij);
+	const double v2 = _vij.nrm2();
+	_windowStart.resize(N);
+	_windowEnd.resize(N);
+	for (size_t i(0); i < N1; ++i)
+	  for (size_t j(0); j < N2; ++j)
+	    {
+	      const std::pair<double, double> window = detail::boundingSphereWindow(r2, rv, v2, _spheres1[i]._bound + _spheres2[j]._bound, _t, _invgamma);
+	      _windowStart[i * N2 + j] = std::max(t_min, window.first);
+	      _windowEnd[i * N2 + j] = std::min(t_max, window.second);
+	    }
+
+	_order.clear();
+	for (size_t id(0); id < N; ++id)
+	  if (_windowStart[id] <= _windowEnd[id])
+	    _order.push_back(id);
+	std::sort(_order.begin(), _order.end(), [&](const size_t a, const size_t b) { return _windowStart[a] < _windowStart[b]; });
+
+	std::pair<bool, double> current(false, HUGE_VAL);
+	double limit = t_max;
+	for (const size_t id : _order)
+	  {
+	    const double start = _windowStart[id];
+	    if (start >= limit) break;
+	    const double end = std::min(limit, _windowEnd[id]);
+	    const Sphere& s1 = _spheres1[id / N2];
+	    const Sphere& s2 = _spheres2[id % N2];
+	    detail::OffcentreSpheresOverlapFunction f(_rij, _vij, _omegai, _omegaj, s1._u, s2._u, s1._diameter, s2._diameter,
+						      _maxdist, _t, _invgamma, start, end);
+	    const std::pair<bool, double> test = magnet::intersection::nextEvent(f, start, end);
+	    if (test.second < current.second)
+	      {
+		current = test;
+		limit = std::min(limit, test.second);
+	      }
+	  }
+	return current;
+      }
+
+    private:
+      struct Sphere
+      {
+	math::Vector _u;
+	double _diameter;
+	//! \brief The radius of the sphere bounding this sphere (about the centre of rotation).
+	double _bound;
+      };
+
+      const math::Vector _rij, _vij, _omegai, _omegaj;
+      const double _maxdist, _t, _invgamma;
+      std::vector<Sphere> _spheres1, _spheres2;
+      //Scratch space, kept to avoid reallocation
+      mutable std::vector<double> _windowStart, _windowEnd;
+      mutable std::vector<size_t> _order;
+    };
   }
 }
@@ -0,0 +1,102 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/exception.hpp>
+#include <complex>
+#include <vector>
+#include <cmath>
+
+namespace magnet {
+  namespace math {
+    /*! \brief A radix-2 fast Fourier transform of complex sequences.
+
+      The twiddle factors and the bit reversal permutation are
+      tabulated when the transform is constructed, so a single FFT
+      object can be reused for many sequences of the same length
+      (e.g., the lines of a multidimensional grid). The forward
+      transform is
+      \f$F_n=\sum_{j=0}^{N-1} f_j\,e^{-2\pi i\,n j/N}\f$
+      and the inverse transform is not normalised.
+     */
+    class FFT
+    {
+    public:
+      /*! \param n The length of the sequences, which must be a power
+          of two.
+       */
+      FFT(size_t n = 1):
+	_n(n),
+	_twiddles(n / 2),
+	_reversed(n)
+      {
+	if (!n || (n & (n - 1)))
+	  M_throw() << "The FFT length (" << n << ") must be a power of two";
+
+	for (size_t i(0); i < n / 2; ++i)
+	  _twiddles[i] = std::polar(1.0, -2 * M_PI * double(i) / n);
+
+	size_t bits(0);
+	while ((size_t(1) << bits) < n) ++bits;
+
+	for (size_t i(0); i < n; ++i)
+	  {
+	    size_t r(0);
+	    for (size_t b(0); b < bits; ++b)
+	      r |= ((i >> b) & 1) << (bits - 1 - b);
+	    _reversed[i] = r;
+	  }
+      }
+
+      size_t size() const { return _n; }
+
+      /*! \brief Transform a sequence in place.
+
+	\param data The first element of the sequence.
+	\param stride The distance between successive elements of the
+	sequence.
+	\param inverse Perform the (unnormalised) inverse transform.
+       */
+      void operator()(std::complex<double>* data, size_t stride = 1, bool inverse = false) const
+      {
+	for (size_t i(0); i < _n; ++i)
+	  if (i < _reversed[i])
+	    std::swap(data[i * stride], data[_reversed[i] * stride]);
+
+	for (size_t half(1); half < _n; half *= 2)
+	  {
+	    const size_t step = _n / (2 * half);
+	    for (size_t start(0); start < _n; start += 2 * half)
+	      for (size_t j(0); j < half; ++j)
+		{
+		  const std::complex<double> w = inverse ? std::conj(_twiddles[j * step]) : _twiddles[j * step];
+		  std::complex<double>& a = data[(start + j) * stride];
+		  std::complex<double>& b = data[(start + j + half) * stride];
+		  const std::complex<double> t = w * b;
+		  b = a - t;
+		  a += t;
+		}
+	  }
+      }
+
+    private:
+      size_t _n;
+      std::vector<std::complex<double> > _twiddles;
+      std::vector<size_t> _reversed;
+    };
+  }
+}
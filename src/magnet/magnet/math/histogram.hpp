@@ -41,6 +41,17 @@ namespace magnet {
 	++(Container::operator[](val));
 	++sampleCount;
       }
+
+      //! \brief Add the samples of another Histogram with the same bin width.
+      Histogram& operator+=(const Histogram& other)
+      {
+	//The bins are addressed directly by their index in the map
+	std::map<long, unsigned long>& bins = *this;
+	for (const typename Container::value_type &p1 : other)
+	  bins[p1.first] += p1.second;
+	sampleCount += other.sampleCount;
+	return *this;
+      }
   
       void outputHistogram(magnet::xml::XmlStream& XML, double scalex) const
       {
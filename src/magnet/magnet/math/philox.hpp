@@ -0,0 +1,196 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace magnet {
+  namespace math {
+    /*! \brief The Philox4x32-10 counter-based random number
+        generator.
+
+      A counter-based generator has no internal state other than a
+      counter and a key. Each value of the counter is mapped to four
+      random 32 bit words by a bijection (ten rounds of multiplies and
+      xors) which is keyed by the seed. Seeking to any position of the
+      sequence is therefore free, and generators with different keys
+      or counter ranges give independent streams (see Salmon et al.,
+      "Parallel random numbers: as easy as 1, 2, 3", SC11).
+
+      Here the upper half of the counter holds a stream number and the
+      lower half the position in the stream, so a single seed gives
+      \f$2^{64}\f$ independent streams. The class models the
+      UniformRandomBitGenerator concept, so it may be used with the
+      distributions of the standard library, but it also generates
+      whole blocks of uniform and normal variates at once, which is
+      much cheaper than drawing them one at a time.
+     */
+    class Philox
+    {
+    public:
+      typedef uint32_t result_type;
+      typedef std::array<uint32_t, 4> Counter;
+      typedef std::array<uint32_t, 2> Key;
+
+      Philox(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+      //! \brief Select the seed and stream, and rewind to the start of the stream.
+      void seed(uint64_t seed, uint64_t stream = 0) {
+	_key = Key{{uint32_t(seed), uint32_t(seed >> 32)}};
+	_stream = stream;
+	seek(0);
+      }
+
+      uint64_t getSeed() const { return uint64_t(_key[0]) | (uint64_t(_key[1]) << 32); }
+
+      uint64_t getStream() const { return _stream; }
+
+      //! \brief The number of 32 bit words drawn from the stream so far.
+      uint64_t tell() const { return 4 * _block - (4 - _index); }
+
+      //! \brief Move to a position (in 32 bit words) of the stream.
+      void seek(uint64_t position) {
+	_block = position / 4;
+	_index = 4;
+	if (position % 4)
+	  {
+	    refill();
+	    _index = position % 4;
+	  }
+      }
+
+      void discard(unsigned long long n) { seek(tell() + n); }
+
+      result_type operator()() {
+	if (_index == 4) refill();
+	return _buffer[_index++];
+      }
+
+      //! \brief The Philox4x32-10 bijection of a counter.
+      static Counter block(Counter ctr, Key key) {
+	for (size_t round(0); round < 10; ++round)
+	  {
+	    if (round)
+	      {
+		key[0] += 0x9E3779B9;
+		key[1] += 0xBB67AE85;
+	      }
+	    const uint64_t prod0 = uint64_t(0xD2511F53) * ctr[0];
+	    const uint64_t prod1 = uint64_t(0xCD9E8D57) * ctr[2];
+	    ctr = Counter{{uint32_t(prod1 >> 32) ^ ctr[1] ^ key[0], uint32_t(prod1),
+			   uint32_t(prod0 >> 32) ^ ctr[3] ^ key[1], uint32_t(prod0)}};
+	  }
+	return ctr;
+      }
+
+      /*! \brief Fill an array with random words.
+
+	Whole blocks are written directly to the output, so this
+	gives the same sequence as calling operator() n times.
+       */
+      void generate(uint32_t* out, size_t n) {
+	while (n && (_index != 4)) { *out++ = _buffer[_index++]; --n; }
+	for (; n >= 4; n -= 4, out += 4)
+	  {
+	    const Counter r = block(counter(_block++), _key);
+	    out[0] = r[0]; out[1] = r[1]; out[2] = r[2]; out[3] = r[3];
+	  }
+	while (n--) *out++ = operator()();
+      }
+
+      //! \brief Convert two random words to a double, uniform on [0,1), with 53 random bits.
+      static double toUniform(uint32_t a, uint32_t b)
+      { return ((a >> 5) * 67108864.0 + (b >> 6)) * (1.0 / 9007199254740992.0); }
+
+      //! \brief Map a random word to an integer, uniform on [0,n), without division.
+      static size_t toIndex(uint32_t a, size_t n)
+      { return size_t((uint64_t(a) * n) >> 32); }
+
+      //! \brief Draw a single double, uniform on [0,1).
+      double uniform() {
+	const uint32_t a = operator()();
+	return toUniform(a, operator()());
+      }
+
+      //! \brief Fill an array with doubles, uniform on [0,1).
+      void uniform(double* out, size_t n) {
+	uint32_t words[2 * _bulk];
+	while (n)
+	  {
+	    const size_t count = std::min(n, size_t(_bulk));
+	    generate(words, 2 * count);
+	    for (size_t i(0); i < count; ++i)
+	      out[i] = toUniform(words[2 * i], words[2 * i + 1]);
+	    out += count;
+	    n -= count;
+	  }
+      }
+
+      /*! \brief Fill an array with standard normal variates.
+
+	The variates are generated in pairs by the Box-Muller
+	transform, so if n is odd one variate is discarded.
+       */
+      void normal(double* out, size_t n) {
+	double u[2 * _bulk];
+	while (n)
+	  {
+	    const size_t pairs = std::min((n + 1) / 2, size_t(_bulk));
+	    uniform(u, 2 * pairs);
+	    for (size_t i(0); i < pairs; ++i)
+	      {
+		//1-u is on (0,1], avoiding the log of zero
+		const double r = std::sqrt(-2 * std::log(1 - u[2 * i]));
+		const double theta = 2 * M_PI * u[2 * i + 1];
+		out[2 * i] = r * std::cos(theta);
+		if (2 * i + 1 < n) out[2 * i + 1] = r * std::sin(theta);
+	      }
+	    const size_t count = std::min(n, 2 * pairs);
+	    out += count;
+	    n -= count;
+	  }
+      }
+
+    private:
+      static const size_t _bulk = 64;
+
+      Counter counter(uint64_t block) const
+      { return Counter{{uint32_t(block), uint32_t(block >> 32), uint32_t(_stream), uint32_t(_stream >> 32)}}; }
+
+      void refill() {
+	_buffer = block(counter(_block++), _key);
+	_index = 0;
+      }
+
+      Key _key;
+      uint64_t _stream;
+      //! \brief The counter of the next block to be generated.
+      uint64_t _block;
+      Counter _buffer;
+      //! \brief The next word of the buffer to be returned (4 if it is used up).
+      size_t _index;
+    };
+  }
+}
@@ -0,0 +1,112 @@
+/*  dynamo:- Event driven molecular dynamics simulator 
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <magnet/math/vector.hpp>
+#include <complex>
+#include <vector>
+#include <cmath>
+
+namespace magnet {
+  namespace math {
+    /*! \brief Evaluates all of the spherical harmonics \f$Y_l^m\f$ up
+        to a maximum \f$l\f$ for a direction, in a single pass.
+
+      The harmonics match boost::math::spherical_harmonic (including
+      the Condon-Shortley phase), with the polar angle \f$\theta\f$
+      measured from the z axis. Only the harmonics with \f$m\ge0\f$
+      are calculated, the others follow from
+      \f$Y_l^{-m}=(-1)^m\,{Y_l^m}^*\f$.
+
+      The normalised associated Legendre functions are generated with
+      the stable recurrences in \f$l\f$. The factor of
+      \f$\sin^m\theta\f$ is taken out of the functions and combined
+      with \f$e^{im\phi}\f$, as \f$(x+iy)^m\f$ for a unit vector, so no
+      trigonometric functions are evaluated and the poles need no
+      special treatment.
+     */
+    class SphericalHarmonics
+    {
+    public:
+      /*! \param maxl The harmonics with \f$l<\f$ maxl are evaluated.
+       */
+      SphericalHarmonics(size_t maxl = 0):
+	_maxl(maxl),
+	_a(size()),
+	_b(size()),
+	_diagonal(maxl)
+      {
+	for (size_t m(0); m < _maxl; ++m)
+	  {
+	    //The sectoral functions, P_m^m
+	    _diagonal[m] = (m == 0) ? std::sqrt(1.0 / (4.0 * M_PI)) : -std::sqrt((2.0 * m + 1.0) / (2.0 * m));
+	    for (size_t l(m + 1); l < _maxl; ++l)
+	      {
+		const double l2 = double(l) * l, m2 = double(m) * m;
+		_a[index(l, m)] = std::sqrt((4.0 * l2 - 1.0) / (l2 - m2));
+		_b[index(l, m)] = std::sqrt(((l - 1.0) * (l - 1.0) - m2) / (4.0 * (l - 1.0) * (l - 1.0) - 1.0));
+	      }
+	  }
+      }
+
+      //! \brief The position of \f$Y_l^m\f$ in the output array.
+      static size_t index(size_t l, size_t m) { return l * (l + 1) / 2 + m; }
+
+      //! \brief The number of harmonics evaluated (the length of the output array).
+      size_t size() const { return _maxl * (_maxl + 1) / 2; }
+
+      size_t getMaxL() const { return _maxl; }
+
+      /*! \brief Evaluate the harmonics for a direction.
+
+	\param dir A unit vector giving the direction.
+	\param Y An array of size() elements where \f$Y_l^m\f$ is
+	written to Y[index(l,m)].
+       */
+      void operator()(const Vector& dir, std::complex<double>* Y) const
+      {
+	const double z = dir[2];
+	const std::complex<double> phase(dir[0], dir[1]);
+	//(x+iy)^m
+	std::complex<double> phasePower(1, 0);
+	//The sectoral function divided by sin^m(theta)
+	double sectoral = 1;
+	for (size_t m(0); m < _maxl; ++m)
+	  {
+	    sectoral *= _diagonal[m];
+	    double Pl2 = 0, Pl1 = sectoral;
+	    Y[index(m, m)] = Pl1 * phasePower;
+	    for (size_t l(m + 1); l < _maxl; ++l)
+	      {
+		const size_t id = index(l, m);
+		const double Pl = _a[id] * (z * Pl1 - _b[id] * Pl2);
+		Y[id] = Pl * phasePower;
+		Pl2 = Pl1;
+		Pl1 = Pl;
+	      }
+	    phasePower *= phase;
+	  }
+      }
+
+    private:
+      size_t _maxl;
+      std::vector<double> _a;
+      std::vector<double> _b;
+      std::vector<double> _diagonal;
+    };
+  }
+}
@@ -0,0 +1,146 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file backgroundqueue.hpp
+ * \brief Contains the definition of BackgroundQueue
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace magnet {
+  namespace thread {
+    /*! \brief A bounded queue of work items which are processed in
+        order by a single background thread.
+
+      This is used to move slow output (e.g., compressing and writing
+      files) off of the thread which produces the items. The producer
+      only waits in \ref push() if more than maxQueued items are
+      waiting, so no items are dropped.
+
+      The first exception thrown while processing an item stops the
+      background thread. It is rethrown to the producer by the next
+      call of \ref push() or \ref flush(), or returned by \ref
+      finish().
+     */
+    template<class T>
+    class BackgroundQueue
+    {
+    public:
+      BackgroundQueue(size_t maxQueued):
+	_maxQueued(maxQueued), _shutdown(false) {}
+
+      ~BackgroundQueue() { finish(); }
+
+      /*! \brief Start the background thread, if it is not already
+          running, processing each item with the passed function.
+       */
+      void start(std::function<void(T&)> process)
+      {
+	if (_thread.joinable()) return;
+	_process = process;
+	_shutdown = false;
+	_thread = std::thread(&BackgroundQueue::loop, this);
+      }
+
+      //! \brief Queue an item, waiting if the queue is full.
+      void push(T&& item)
+      {
+	{
+	  std::unique_lock<std::mutex> lock(_mutex);
+	  _condition.wait(lock, [&]() { return (_queue.size() < _maxQueued) || _error; });
+	  if (_error)
+	    std::rethrow_exception(_error);
+	  _queue.push_back(std::move(item));
+	}
+	_condition.notify_all();
+      }
+
+      //! \brief Wait until all queued items have been processed.
+      void flush()
+      {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_condition.wait(lock, [&]() { return _queue.empty() || _error; });
+	if (_error)
+	  std::rethrow_exception(_error);
+      }
+
+      /*! \brief Process the remaining items and stop the background
+          thread.
+
+	\return The error of the background thread, if any.
+       */
+      std::exception_ptr finish()
+      {
+	{
+	  std::lock_guard<std::mutex> lock(_mutex);
+	  _shutdown = true;
+	}
+	_condition.notify_all();
+
+	if (_thread.joinable())
+	  _thread.join();
+
+	return _error;
+      }
+
+    private:
+      void loop()
+      {
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true)
+	  {
+	    _condition.wait(lock, [&]() { return !_queue.empty() || _shutdown; });
+	    if (_queue.empty()) return;
+
+	    //The item stays in the queue while it is processed, so
+	    //flush() waits for it.
+	    T& item = _queue.front();
+	    lock.unlock();
+
+	    std::exception_ptr error;
+	    try {
+	      _process(item);
+	    } catch (...) {
+	      error = std::current_exception();
+	    }
+
+	    lock.lock();
+	    _queue.pop_front();
+	    if (error && !_error)
+	      _error = error;
+	    _condition.notify_all();
+	    if (_error) return;
+	  }
+      }
+
+      size_t _maxQueued;
+      std::function<void(T&)> _process;
+      std::thread _thread;
+      std::mutex _mutex;
+      std::condition_variable _condition;
+      std::deque<T> _queue;
+      bool _shutdown;
+      std::exception_ptr _error;
+    };
+  }
+}
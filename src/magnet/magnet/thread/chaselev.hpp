@@ -0,0 +1,173 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file chaselev.hpp
+ * \brief Contains the definition of ChaseLevDeque
+ */
+
+#pragma once
+
+#include <magnet/thread/task.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace magnet {
+  namespace thread {
+    /*! \brief A lock-free work stealing deque of Task's.
+
+      This is the dynamic circular work stealing deque of Chase and
+      Lev, using the C11 memory orderings of Lê et al., "Correct and
+      Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+
+      Only a single "owner" thread may call push() and pop(), which
+      operate on the bottom of the deque. Any number of threads may
+      call steal(), which removes tasks from the top.
+
+      When the deque fills, its circular array is doubled in
+      size. The old arrays may still be read by concurrent thieves,
+      so they are only freed when the deque is destroyed.
+     */
+    class ChaseLevDeque
+    {
+      class Array
+      {
+      public:
+	Array(size_t logSize):
+	  _logSize(logSize),
+	  _mask((int64_t(1) << logSize) - 1),
+	  _slots(new std::atomic<uint64_t>[Task::words << logSize])
+	{}
+
+	int64_t capacity() const { return _mask + 1; }
+
+	void put(int64_t i, const Task& task)
+	{ task.storeTo(&_slots[Task::words * (i & _mask)]); }
+
+	void get(int64_t i, Task& task) const
+	{ task.loadFrom(&_slots[Task::words * (i & _mask)]); }
+
+	Array* grow(int64_t bottom, int64_t top) const
+	{
+	  Array* newArray = new Array(_logSize + 1);
+	  Task task;
+	  for (int64_t i(top); i < bottom; ++i)
+	    {
+	      get(i, task);
+	      newArray->put(i, task);
+	    }
+	  return newArray;
+	}
+
+      private:
+	size_t _logSize;
+	int64_t _mask;
+	std::unique_ptr<std::atomic<uint64_t>[]> _slots;
+      };
+
+    public:
+      ChaseLevDeque(size_t logSize = 8):
+	_top(0), _bottom(0)
+      {
+	_arrays.push_back(std::unique_ptr<Array>(new Array(logSize)));
+	_array.store(_arrays.back().get(), std::memory_order_relaxed);
+      }
+
+      /*! \brief Add a task to the bottom of the deque (owner only). */
+      void push(const Task& task)
+      {
+	const int64_t b = _bottom.load(std::memory_order_relaxed);
+	const int64_t t = _top.load(std::memory_order_acquire);
+	Array* a = _array.load(std::memory_order_relaxed);
+	if (b - t > a->capacity() - 1)
+	  {
+	    a = a->grow(b, t);
+	    _arrays.push_back(std::unique_ptr<Array>(a));
+	    _array.store(a, std::memory_order_release);
+	  }
+	a->put(b, task);
+	std::atomic_thread_fence(std::memory_order_release);
+	_bottom.store(b + 1, std::memory_order_relaxed);
+      }
+
+      /*! \brief Remove a task from the bottom of the deque (owner only).
+
+        \return false if the deque was empty or the last task was
+        stolen.
+       */
+      bool pop(Task& task)
+      {
+	const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+	Array* a = _array.load(std::memory_order_relaxed);
+	_bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = _top.load(std::memory_order_relaxed);
+
+	if (t > b)
+	  {
+	    //Empty deque
+	    _bottom.store(b + 1, std::memory_order_relaxed);
+	    return false;
+	  }
+
+	a->get(b, task);
+	if (t == b)
+	  {
+	    //The last task, race against the thieves for it
+	    const bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	    _bottom.store(b + 1, std::memory_order_relaxed);
+	    return won;
+	  }
+	return true;
+      }
+
+      /*! \brief Remove a task from the top of the deque (any thread).
+
+        \return false if the deque was empty or the steal lost a race
+        with another thread.
+       */
+      bool steal(Task& task)
+      {
+	int64_t t = _top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64_t b = _bottom.load(std::memory_order_acquire);
+	if (t >= b) return false;
+
+	Array* a = _array.load(std::memory_order_acquire);
+	a->get(t, task);
+	return _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      }
+
+      /*! \brief An estimate of whether the deque is empty. */
+      bool empty() const
+      {
+	return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+      }
+
+    private:
+      ChaseLevDeque(const ChaseLevDeque&);
+      ChaseLevDeque& operator=(const ChaseLevDeque&);
+
+      //Padded onto separate cache lines, as top is contended by thieves
+      std::atomic<int64_t> _top;
+      char _padding[64 - sizeof(std::atomic<int64_t>)];
+      std::atomic<int64_t> _bottom;
+      std::atomic<Array*> _array;
+      //All arrays ever allocated, freed on destruction
+      std::vector<std::unique_ptr<Array> > _arrays;
+    };
+  }
+}
@@ -0,0 +1,177 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file task.hpp
+ * \brief Contains the definition of Task and WaitGroup
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace magnet {
+  namespace thread {
+    /*! \brief A counter of outstanding tasks, which may be waited on.
+
+      Each task submitted to a WorkStealingPool is associated with a
+      WaitGroup, which is incremented when the task is submitted and
+      decremented once it has completed. The first exception thrown
+      by any of the tasks is stored and rethrown by
+      WorkStealingPool::wait().
+     */
+    class WaitGroup
+    {
+    public:
+      WaitGroup(): _count(0) {}
+
+      void add(size_t n = 1) { _count.fetch_add(n, std::memory_order_relaxed); }
+      void done() { _count.fetch_sub(1, std::memory_order_release); }
+      bool finished() const { return _count.load(std::memory_order_acquire) == 0; }
+
+      void setException(std::exception_ptr e) {
+	std::lock_guard<std::mutex> lock(_exception_mutex);
+	if (!_exception) _exception = e;
+      }
+
+      //! \brief Rethrow the first exception of the tasks (if any).
+      void rethrow() {
+	std::lock_guard<std::mutex> lock(_exception_mutex);
+	if (_exception)
+	  {
+	    std::exception_ptr e = _exception;
+	    _exception = std::exception_ptr();
+	    std::rethrow_exception(e);
+	  }
+      }
+
+    private:
+      WaitGroup(const WaitGroup&);
+      WaitGroup& operator=(const WaitGroup&);
+
+      std::atomic<size_t> _count;
+      std::mutex _exception_mutex;
+      std::exception_ptr _exception;
+    };
+
+    /*! \brief A type erased task, stored as a fixed number of
+        machine words.
+
+      Small, trivially copyable callables (e.g., lambdas capturing a
+      few references or indices) are stored inline, avoiding the heap
+      allocation std::function performs. Larger callables are moved
+      to the heap and only their pointer is stored.
+
+      The words are read and written through relaxed atomics, which
+      allows a task to be copied out of a work stealing deque while
+      another thread may be writing to the same slot (the copy is then
+      discarded).
+     */
+    class Task
+    {
+    public:
+      //! \brief The number of words of a task, including the bookkeeping.
+      static const size_t words = 8;
+      //! \brief The bytes available for a callable stored inline.
+      static const size_t inline_size = (words - 2) * sizeof(uint64_t);
+
+      typedef void (*Invoker)(const uint64_t*);
+
+      Task() { clear(); }
+
+      template<class F>
+      Task(F&& f, WaitGroup* wg) {
+	clear();
+	typedef typename std::decay<F>::type Func;
+	store(std::forward<F>(f), wg, std::integral_constant<bool, fitsInline<Func>()>());
+      }
+
+      //! \brief Call the stored callable and notify its WaitGroup.
+      void operator()() const {
+	WaitGroup* wg = reinterpret_cast<WaitGroup*>(static_cast<uintptr_t>(_data[1]));
+	try {
+	  reinterpret_cast<Invoker>(static_cast<uintptr_t>(_data[0]))(_data + 2);
+	} catch (...) {
+	  if (wg) wg->setException(std::current_exception());
+	}
+	if (wg) wg->done();
+      }
+
+      bool valid() const { return _data[0] != 0; }
+
+      //! \brief Write the task into an atomic slot.
+      void storeTo(std::atomic<uint64_t>* slot) const {
+	for (size_t i(0); i < words; ++i)
+	  slot[i].store(_data[i], std::memory_order_relaxed);
+      }
+
+      //! \brief Read the task from an atomic slot.
+      void loadFrom(const std::atomic<uint64_t>* slot) {
+	for (size_t i(0); i < words; ++i)
+	  _data[i] = slot[i].load(std::memory_order_relaxed);
+      }
+
+    private:
+      template<class Func>
+      static constexpr bool fitsInline() {
+	return std::is_trivially_copyable<Func>::value
+	  && (sizeof(Func) <= inline_size)
+	  && (alignof(Func) <= alignof(uint64_t));
+      }
+
+      void clear() { for (size_t i(0); i < words; ++i) _data[i] = 0; }
+
+      template<class Func>
+      static void invokeInline(const uint64_t* storage) {
+	//Copy out to correctly aligned storage before calling
+	typename std::aligned_storage<sizeof(Func), alignof(Func)>::type buf;
+	std::memcpy(&buf, storage, sizeof(Func));
+	(*reinterpret_cast<Func*>(&buf))();
+      }
+
+      template<class Func>
+      static void invokeHeap(const uint64_t* storage) {
+	Func* f = reinterpret_cast<Func*>(static_cast<uintptr_t>(storage[0]));
+	struct Deleter { Func* _f; ~Deleter() { delete _f; } } deleter{f};
+	(*f)();
+      }
+
+      template<class F>
+      void store(F&& f, WaitGroup* wg, std::true_type) {
+	typedef typename std::decay<F>::type Func;
+	_data[0] = reinterpret_cast<uintptr_t>(&invokeInline<Func>);
+	_data[1] = reinterpret_cast<uintptr_t>(wg);
+	const Func func(std::forward<F>(f));
+	std::memcpy(_data + 2, &func, sizeof(Func));
+      }
+
+      template<class F>
+      void store(F&& f, WaitGroup* wg, std::false_type) {
+	typedef typename std::decay<F>::type Func;
+	_data[0] = reinterpret_cast<uintptr_t>(&invokeHeap<Func>);
+	_data[1] = reinterpret_cast<uintptr_t>(wg);
+	_data[2] = reinterpret_cast<uintptr_t>(new Func(std::forward<F>(f)));
+      }
+
+      uint64_t _data[words];
+    };
+  }
+}
@@ -0,0 +1,92 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file triplebuffer.hpp
+ * \brief Contains the definition of TripleBuffer
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace magnet {
+  namespace thread {
+    /*! \brief A lock-free, single producer/single consumer exchange
+        of the latest value of some data.
+
+      The producer fills the back buffer (\ref back()) and calls \ref
+      publish() to make it the latest value. The consumer calls \ref
+      consume() to take the latest published value into the front
+      buffer (\ref front()), which it may read until it next calls
+      consume(). Neither thread ever waits on the other: if the
+      producer publishes faster than the consumer consumes, the
+      unconsumed values are simply overwritten.
+
+      The three buffers are allocated once, so if T is a container
+      which is reused (e.g., a std::vector which is assigned to but
+      not shrunk) no allocations take place in the steady state.
+     */
+    template<class T>
+    class TripleBuffer
+    {
+    public:
+      TripleBuffer(): _back(0), _middle(1), _front(2) {}
+
+      //! \brief The buffer the producer may write to.
+      T& back() { return _buffers[_back]; }
+
+      /*! \brief Make the back buffer the latest published value, and
+          take a new back buffer.
+       */
+      void publish()
+      { _back = _middle.exchange(_back | _fresh, std::memory_order_acq_rel) & ~_fresh; }
+
+      //! \brief The buffer the consumer may read from.
+      const T& front() const { return _buffers[_front]; }
+      T& front() { return _buffers[_front]; }
+
+      /*! \brief Take the latest published value into the front
+          buffer.
+
+	\return false if nothing has been published since the last
+	call, in which case the front buffer is unchanged.
+       */
+      bool consume()
+      {
+	if (!(_middle.load(std::memory_order_relaxed) & _fresh))
+	  return false;
+	_front = _middle.exchange(_front, std::memory_order_acq_rel) & ~_fresh;
+	return true;
+      }
+
+      /*! \brief Direct access to all buffers, e.g., for sizing them
+          before either thread starts.
+       */
+      T& operator[](size_t i) { return _buffers[i]; }
+
+    private:
+      //! \brief The flag, set in _middle, marking an unconsumed value.
+      static const unsigned _fresh = 4;
+
+      std::array<T, 3> _buffers;
+      unsigned _back;
+      //! \brief The index of the spare buffer, with the _fresh flag.
+      std::atomic<unsigned> _middle;
+      unsigned _front;
+    };
+  }
+}
@@ -0,0 +1,324 @@
+/*  dynamo:- Event driven molecular dynamics simulator
+    http://www.dynamomd.org
+    Copyright (C) 2011  Marcus N Campbell Bannerman <m.bannerman@gmail.com>
+
+    This program is free software: you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    version 3 as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*! \file workstealingpool.hpp
+ * \brief Contains the definition of WorkStealingPool
+ */
+
+#pragma once
+
+#include <magnet/thread/threadgroup.hpp>
+#include <magnet/thread/chaselev.hpp>
+#include <magnet/thread/task.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace magnet {
+  namespace thread {
+    /*! \brief A pool of worker threads which share tasks by work
+      stealing.
+
+      Each worker owns a ChaseLevDeque. Tasks submitted from within a
+      task are pushed onto the deque of the executing worker, and idle
+      workers steal from the top of randomly selected deques. Tasks
+      submitted from outside the pool are placed on a shared
+      injection deque, which is pushed to under a lock but stolen
+      from without one. Tasks are stored as Task objects, so small
+      callables do not require a heap allocation.
+
+      Completion is tracked with WaitGroup's. A thread calling wait()
+      will execute tasks until the WaitGroup has finished, so this
+      pool also runs in 0 thread mode, and tasks may wait on tasks
+      they have submitted without deadlocking.
+     */
+    class WorkStealingPool
+    {
+    public:
+      /*! \brief Default Constructor
+
+        This initialises the pool to 0 threads.
+       */
+      WorkStealingPool():
+	_stop_flag(false),
+	_queued(0),
+	_sleepers(0)
+      { _deques.push_back(std::unique_ptr<ChaseLevDeque>(new ChaseLevDeque)); }
+
+      /*! \brief Destructor
+
+        Join all threads in the pool. Any tasks not yet executed are
+        discarded.
+       */
+      ~WorkStealingPool() { stop(); }
+
+      /*! \brief Set the number of threads in the pool.
+
+        This must not be called while tasks are outstanding.
+       */
+      void setThreadCount(size_t x)
+      {
+	if (x == getThreadCount()) return;
+	stop();
+	_stop_flag = false;
+
+	_deques.clear();
+	for (size_t i(0); i < x + 1; ++i)
+	  _deques.push_back(std::unique_ptr<ChaseLevDeque>(new ChaseLevDeque));
+
+	for (size_t i(0); i < x; ++i)
+	  _threads.create_thread(&WorkStealingPool::beginThread, this, i);
+      }
+
+      /*! \brief The current number of threads in the pool */
+      size_t getThreadCount() const { return _deques.size() - 1; }
+
+      /*! \brief Queue a task for execution, which is tracked by the
+        passed WaitGroup.
+       */
+      template<class F>
+      void submit(WaitGroup& wg, F&& f)
+      {
+	wg.add();
+	//The queue count is raised first, so it is never below the
+	//number of tasks which can be found
+	_queued.fetch_add(1, std::memory_order_seq_cst);
+	const Task task(std::forward<F>(f), &wg);
+	const WorkerInfo& info = workerInfo();
+	if (info.pool == this)
+	  _deques[info.index]->push(task);
+	else
+	  {
+	    std::lock_guard<std::mutex> lock(_inject_mutex);
+	    injectionDeque().push(task);
+	  }
+
+	if (_sleepers.load(std::memory_order_seq_cst))
+	  {
+	    std::lock_guard<std::mutex> lock(_sleep_mutex);
+	    _wake_condition.notify_one();
+	  }
+      }
+
+      /*! \brief Execute tasks until all tasks of the WaitGroup have
+        completed.
+
+        If any of the tasks threw an exception, the first one is
+        rethrown here.
+       */
+      void wait(WaitGroup& wg)
+      {
+	Task task;
+	while (!wg.finished())
+	  if (findTask(task))
+	    runTask(task);
+	  else
+	    std::this_thread::yield();
+
+	wg.rethrow();
+      }
+
+      /*! \brief Call f(i) for every i in [begin, end), in parallel.
+
+        The range is split into at most four chunks per thread (plus
+        one for the calling thread, which also executes chunks).
+       */
+      template<class F>
+      void parallel_for(size_t begin, size_t end, const F& f)
+      {
+	const size_t chunks = chunkCount(begin, end);
+	if (chunks <= 1)
+	  {
+	    for (size_t i(begin); i < end; ++i) f(i);
+	    return;
+	  }
+
+	WaitGroup wg;
+	const F* func = &f;
+	for (size_t c(0); c < chunks; ++c)
+	  {
+	    const size_t b = chunkBegin(begin, end, chunks, c);
+	    const size_t e = chunkBegin(begin, end, chunks, c + 1);
+	    submit(wg, [func, b, e]() { for (size_t i(b); i < e; ++i) (*func)(i); });
+	  }
+	wait(wg);
+      }
+
+      /*! \brief Reduce the range [begin, end) in parallel.
+
+        The range is split into chunks, and map(b, e) is called to
+        compute the value of each chunk [b, e). These partial values
+        are then combined in chunk order, starting from init, using
+        reduce(a, b). The result is therefore independent of the
+        scheduling of the chunks (but not of the thread count).
+       */
+      template<class T, class Map, class Reduce>
+      T parallel_reduce(size_t begin, size_t end, T init, const Map& map, const Reduce& reduce)
+      {
+	const size_t chunks = chunkCount(begin, end);
+	if (chunks <= 1)
+	  return (begin < end) ? reduce(init, map(begin, end)) : init;
+
+	std::vector<T> partials(chunks);
+	WaitGroup wg;
+	const Map* func = &map;
+	T* out = partials.data();
+	for (size_t c(0); c < chunks; ++c)
+	  {
+	    const size_t b = chunkBegin(begin, end, chunks, c);
+	    const size_t e = chunkBegin(begin, end, chunks, c + 1);
+	    submit(wg, [func, out, c, b, e]() { out[c] = (*func)(b, e); });
+	  }
+	wait(wg);
+
+	for (const T& partial : partials)
+	  init = reduce(init, partial);
+	return init;
+      }
+
+    private:
+      WorkStealingPool(const WorkStealingPool&);
+      WorkStealingPool& operator=(const WorkStealingPool&);
+
+      struct WorkerInfo
+      {
+	WorkerInfo(): pool(NULL), index(0), seed(0x9E3779B97F4A7C15ULL) {}
+	WorkStealingPool* pool;
+	size_t index;
+	uint64_t seed;
+      };
+
+      static WorkerInfo& workerInfo()
+      {
+	static thread_local WorkerInfo info;
+	return info;
+      }
+
+      ChaseLevDeque& injectionDeque() { return *_deques.back(); }
+
+      size_t chunkCount(size_t begin, size_t end) const
+      { return std::min(end - std::min(begin, end), 4 * (getThreadCount() + 1)); }
+
+      static size_t chunkBegin(size_t begin, size_t end, size_t chunks, size_t c)
+      { return begin + ((end - begin) * c) / chunks; }
+
+      void runTask(const Task& task)
+      {
+	_queued.fetch_sub(1, std::memory_order_relaxed);
+	task();
+      }
+
+      /*! \brief Look for a task for the calling thread.
+
+        Workers first pop from their own deque. Then the injection
+        deque is tried, followed by the deques of the other workers,
+        starting from a random victim.
+       */
+      bool findTask(Task& task)
+      {
+	WorkerInfo& info = workerInfo();
+	const bool isWorker = (info.pool == this);
+	if (isWorker && _deques[info.index]->pop(task)) return true;
+	if (injectionDeque().steal(task)) return true;
+
+	const size_t workers = getThreadCount();
+	if (!workers) return false;
+
+	//xorshift64
+	info.seed ^= info.seed << 13;
+	info.seed ^= info.seed >> 7;
+	info.seed ^= info.seed << 17;
+	const size_t start = info.seed % workers;
+	for (size_t i(0); i < workers; ++i)
+	  {
+	    const size_t victim = (start + i) % workers;
+	    if (isWorker && (victim == info.index)) continue;
+	    if (_deques[victim]->steal(task)) return true;
+	  }
+	return false;
+      }
+
+      /*! \brief Thread worker loop. */
+      void beginThread(size_t index)
+      {
+	WorkerInfo& info = workerInfo();
+	info.pool = this;
+	info.index = index;
+	info.seed += index;
+
+	Task task;
+	size_t failures(0);
+	while (!_stop_flag.load(std::memory_order_relaxed))
+	  {
+	    if (findTask(task))
+	      {
+		runTask(task);
+		failures = 0;
+		continue;
+	      }
+
+	    if (++failures < 64)
+	      {
+		std::this_thread::yield();
+		continue;
+	      }
+
+	    //Go to sleep until a task is submitted. The sleeper count
+	    //is raised before checking the queue count, while
+	    //submit() raises the queue count before checking the
+	    //sleeper count, so a wake up cannot be missed.
+	    _sleepers.fetch_add(1, std::memory_order_seq_cst);
+	    {
+	      std::unique_lock<std::mutex> lock(_sleep_mutex);
+	      while (!_stop_flag.load(std::memory_order_relaxed)
+		     && !_queued.load(std::memory_order_seq_cst))
+		_wake_condition.wait(lock);
+	    }
+	    _sleepers.fetch_sub(1, std::memory_order_seq_cst);
+	    failures = 0;
+	  }
+
+	info.pool = NULL;
+      }
+
+      /*! \brief Halt the pool and terminate all the threads. */
+      void stop()
+      {
+	{
+	  std::lock_guard<std::mutex> lock(_sleep_mutex);
+	  _stop_flag = true;
+	}
+	_wake_condition.notify_all();
+	_threads.join_all();
+      }
+
+      ThreadGroup _threads;
+      //One deque per worker, followed by the injection deque
+      std::vector<std::unique_ptr<ChaseLevDeque> > _deques;
+      std::mutex _inject_mutex;
+
+      std::atomic<bool> _stop_flag;
+      //The number of submitted tasks not yet started
+      std::atomic<size_t> _queued;
+      std::atomic<size_t> _sleepers;
+      std::mutex _sleep_mutex;
+      std::condition_variable _wake_condition;
+    };
+  }
+}
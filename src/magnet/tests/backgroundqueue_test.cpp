@@ -0,0 +1,71 @@
+#define BOOST_TEST_MODULE BackgroundQueue_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/thread/backgroundqueue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace magnet::thread;
+
+BOOST_AUTO_TEST_CASE( BackgroundQueue_order )
+{
+  std::vector<int> processed;
+  std::atomic<size_t> maxQueued(0);
+  std::atomic<size_t> queued(0);
+
+  BackgroundQueue<int> queue(2);
+  queue.start([&](int& item) {
+      maxQueued = std::max(maxQueued.load(), queued.load());
+      processed.push_back(item);
+      --queued;
+    });
+
+  for (int i(0); i < 1000; ++i)
+    {
+      ++queued;
+      queue.push(int(i));
+    }
+
+  //All items are processed once flushed, in the order they were queued
+  queue.flush();
+  BOOST_CHECK_EQUAL(processed.size(), 1000);
+  for (int i(0); i < int(processed.size()); ++i)
+    BOOST_CHECK_EQUAL(processed[i], i);
+
+  //The producer is held, rather than items dropped, when the queue
+  //is full
+  BOOST_CHECK(maxQueued <= 3);
+
+  //The remaining items are processed when the queue is finished
+  for (int i(0); i < 10; ++i)
+    queue.push(int(i));
+  BOOST_CHECK(!queue.finish());
+  BOOST_CHECK_EQUAL(processed.size(), 1010);
+}
+
+BOOST_AUTO_TEST_CASE( BackgroundQueue_error )
+{
+  std::vector<int> processed;
+  BackgroundQueue<int> queue(1);
+  queue.start([&](int& item) {
+      if (item == 3)
+	throw std::runtime_error("Failed");
+      processed.push_back(item);
+    });
+
+  //The error is rethrown to the producer
+  bool thrown = false;
+  try {
+    for (int i(0); i < 100; ++i)
+      queue.push(int(i));
+    queue.flush();
+  } catch (std::runtime_error&)
+    { thrown = true; }
+  BOOST_CHECK(thrown);
+  BOOST_CHECK_THROW(queue.flush(), std::runtime_error);
+
+  //No items are processed after the failed one
+  BOOST_CHECK_EQUAL(processed.size(), 3);
+  BOOST_CHECK(queue.finish());
+}
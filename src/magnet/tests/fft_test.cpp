@@ -0,0 +1,65 @@
+#define BOOST_TEST_MODULE FFT_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/math/fft.hpp>
+#include <random>
+
+std::mt19937 RNG;
+std::normal_distribution<double> normal_dist(0, 1);
+using namespace magnet::math;
+
+const double errlvl = 1e-10;
+
+std::vector<std::complex<double> > naiveDFT(const std::vector<std::complex<double> >& data, bool inverse)
+{
+  const size_t N = data.size();
+  std::vector<std::complex<double> > result(N);
+  for (size_t n(0); n < N; ++n)
+    for (size_t j(0); j < N; ++j)
+      result[n] += data[j] * std::polar(1.0, (inverse ? 2 : -2) * M_PI * double((n * j) % N) / N);
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE( FFT_naive_DFT )
+{
+  RNG.seed();
+  for (size_t N(1); N <= 256; N *= 2)
+    for (int inverse(0); inverse < 2; ++inverse)
+      {
+	std::vector<std::complex<double> > data(N);
+	for (std::complex<double>& val : data)
+	  val = std::complex<double>(normal_dist(RNG), normal_dist(RNG));
+
+	const std::vector<std::complex<double> > expected = naiveDFT(data, inverse);
+	FFT fft(N);
+	fft(data.data(), 1, inverse);
+
+	for (size_t n(0); n < N; ++n)
+	  BOOST_CHECK_SMALL(std::abs(data[n] - expected[n]), errlvl);
+      }
+}
+
+BOOST_AUTO_TEST_CASE( FFT_strided_roundtrip )
+{
+  RNG.seed();
+  const size_t N = 64, stride = 3;
+  std::vector<std::complex<double> > data(N * stride), original;
+  for (std::complex<double>& val : data)
+    val = std::complex<double>(normal_dist(RNG), normal_dist(RNG));
+  original = data;
+
+  FFT fft(N);
+  fft(data.data() + 1, stride);
+  fft(data.data() + 1, stride, true);
+
+  for (size_t i(0); i < N * stride; ++i)
+    {
+      const double scale = (i % stride == 1) ? 1.0 / N : 1.0;
+      BOOST_CHECK_SMALL(std::abs(data[i] * scale - original[i]), errlvl);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FFT_bad_length )
+{
+  BOOST_CHECK_THROW(FFT(12), std::exception);
+  BOOST_CHECK_THROW(FFT(0), std::exception);
+}
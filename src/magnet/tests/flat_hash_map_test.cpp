@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE FlatHashMap_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/containers/flat_hash_map.hpp>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace magnet::containers;
+
+auto rng = std::mt19937(std::random_device()());
+
+#define CompareContainers(test, reference)				\
+  {BOOST_CHECK_EQUAL(test.size(), reference.size());			\
+    std::map<uint64_t, size_t> copy(test.begin(), test.end());		\
+    BOOST_CHECK(copy == reference);}
+
+BOOST_AUTO_TEST_CASE( FlatHashMap_basic )
+{
+  FlatHashMap<uint64_t, size_t> test;
+
+  BOOST_CHECK(test.begin() == test.end());
+  BOOST_CHECK(test.empty());
+  BOOST_CHECK(test.find(10) == test.end());
+  BOOST_CHECK_EQUAL(test.erase(10), 0);
+
+  test[10] = 5;
+  BOOST_CHECK_EQUAL(test.size(), 1);
+  BOOST_CHECK(test.find(10) != test.end());
+  BOOST_CHECK_EQUAL(test.find(10)->second, 5);
+  BOOST_CHECK(!test.insert(std::make_pair(uint64_t(10), size_t(2))).second);
+  BOOST_CHECK_EQUAL(test[10], 5);
+
+  BOOST_CHECK_EQUAL(test.erase(10), 1);
+  BOOST_CHECK(test.empty());
+  BOOST_CHECK(test.begin() == test.end());
+}
+
+BOOST_AUTO_TEST_CASE( FlatHashMap_random )
+{
+  //Test against a std::map under a random mix of insertions and
+  //deletions, including many deletions to exercise the DELETED
+  //markers and the rehashing.
+  FlatHashMap<uint64_t, size_t> test;
+  std::map<uint64_t, size_t> reference;
+  std::uniform_int_distribution<uint64_t> keygen(0, 5000);
+
+  for (size_t loop(0); loop < 20; ++loop)
+    {
+      for (size_t i(0); i < 2000; ++i)
+	{
+	  const uint64_t key = keygen(rng);
+	  test[key] = i + 1;
+	  reference[key] = i + 1;
+	}
+
+      CompareContainers(test, reference);
+
+      for (size_t i(0); i < 2000; ++i)
+	{
+	  const uint64_t key = keygen(rng);
+	  BOOST_CHECK_EQUAL(test.erase(key), reference.erase(key));
+	}
+
+      CompareContainers(test, reference);
+
+      for (const auto& entry : reference)
+	BOOST_CHECK_EQUAL(test.find(entry.first)->second, entry.second);
+    }
+
+  FlatHashMap<uint64_t, size_t> duplicate(test);
+  CompareContainers(duplicate, reference);
+
+  test.clear();
+  BOOST_CHECK(test.empty());
+  BOOST_CHECK(test.begin() == test.end());
+  CompareContainers(duplicate, reference);
+}
+
+/* Benchmark the map against std::unordered_map using an access
+   pattern similar to a capture map of a dense square-well fluid:
+   a large number of stored pairs, with each "event" looking up a
+   pair and toggling its state.
+*/
+template<class Map>
+double benchmark(const std::vector<uint64_t>& keys, const std::vector<size_t>& ops, size_t& checksum)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  Map map;
+  for (size_t i(0); i < keys.size(); i += 2)
+    map[keys[i]] = 1;
+
+  for (const size_t op : ops)
+    {
+      auto it = map.find(keys[op]);
+      if (it == map.end())
+	map[keys[op]] = 1;
+      else
+	map.erase(keys[op]);
+    }
+
+  checksum = map.size();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+BOOST_AUTO_TEST_CASE( FlatHashMap_benchmark )
+{
+  const size_t Npairs = 2000000;
+  const size_t Nops = 10000000;
+  std::vector<uint64_t> keys;
+  keys.reserve(Npairs);
+  //Pairs of particle IDs which are close in ID, as generated by
+  //spatially sorted particles.
+  std::uniform_int_distribution<uint32_t> IDgen(0, 100000), offsetgen(1, 50);
+  for (size_t i(0); i < Npairs; ++i)
+    {
+      const uint64_t ID = IDgen(rng);
+      keys.push_back(ID | ((ID + offsetgen(rng)) << 32));
+    }
+
+  std::vector<size_t> ops(Nops);
+  std::uniform_int_distribution<size_t> opgen(0, Npairs - 1);
+  for (size_t& op : ops)
+    op = opgen(rng);
+
+  size_t flat_result(0), std_result(0);
+  const double flat_time = benchmark<FlatHashMap<uint64_t, size_t> >(keys, ops, flat_result);
+  const double std_time = benchmark<std::unordered_map<uint64_t, size_t> >(keys, ops, std_result);
+  BOOST_CHECK_EQUAL(flat_result, std_result);
+
+  std::cout << "FlatHashMap: " << flat_time << "s, std::unordered_map: " << std_time
+	    << "s, speedup " << std_time / flat_time << std::endl;
+}
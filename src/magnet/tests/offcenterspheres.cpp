@@ -98,3 +98,107 @@ BOOST_AUTO_TEST_CASE( OffCentreSphereGrowing_Test )
   std::cout << "f = " << f1.eval(result1.second).front() << "Result1.second = " << result1.second << std::endl;
   
 }
+
+namespace {
+  //The time over which the random configurations are searched
+  const double search_time = 1.0;
+
+  /*! \brief The unfiltered event time of two offcentre spheres, as a
+      reference for the bounding sphere window pre-filter.
+   */
+  std::pair<bool, double> reference_event(const Vector& rij, const Vector& vij, const Vector& angvi, const Vector& angvj,
+					  const Vector& ui, const Vector& uj, const double diami, const double diamj,
+					  const double invgamma, const double t_max)
+  {
+    const double maxdist = rij.nrm() + vij.nrm() * t_max;
+    magnet::intersection::detail::OffcentreSpheresOverlapFunction f(rij, vij, angvi, angvj, ui, uj, diami, diamj, maxdist, 0, invgamma, 0, t_max);
+    return magnet::intersection::nextEvent(f, 0, t_max);
+  }
+
+  //If there is no event, the flag is irrelevant.
+  void check_same_event(const std::pair<bool, double>& result, const std::pair<bool, double>& reference)
+  {
+    if (reference.second == HUGE_VAL)
+      BOOST_CHECK_EQUAL(result.second, HUGE_VAL);
+    else
+      {
+	BOOST_CHECK_EQUAL(result.first, reference.first);
+	BOOST_CHECK_CLOSE(result.second, reference.second, 1e-6);
+      }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( OffCentreSphere_BoundingWindow_Test )
+{
+  RNG.seed(5489u);
+  size_t events = 0;
+  for (size_t i(0); i < 20000; ++i)
+    {
+      const Vector rij = (1.5 + 2 * dist01(RNG)) * random_unit_vec();
+      const Vector vij = 3 * random_vec();
+      const Vector angvi = 4 * random_vec(), angvj = 4 * random_vec();
+      const Vector ui = 0.5 * random_unit_vec(), uj = 0.5 * random_unit_vec();
+      const double diami = 0.5 + dist01(RNG), diamj = 0.5 + dist01(RNG);
+      const double invgamma = (i % 2) ? 0 : 0.1 * dist01(RNG);
+      const double maxdist = rij.nrm() + vij.nrm() * search_time;
+
+      //Only sample valid (non-overlapping) initial configurations
+      if ((rij + ui - uj).nrm() < 0.5 * (diami + diamj)) continue;
+
+      magnet::intersection::detail::OffcentreSpheresOverlapFunction f(rij, vij, angvi, angvj, ui, uj, diami, diamj, maxdist, 0, invgamma, 0, search_time);
+      const auto result = f.nextEvent();
+      const auto reference = reference_event(rij, vij, angvi, angvj, ui, uj, diami, diamj, invgamma, search_time);
+      check_same_event(result, reference);
+      events += (reference.second != HUGE_VAL);
+    }
+  //Make sure the test actually samples events
+  BOOST_CHECK(events > 1000);
+}
+
+BOOST_AUTO_TEST_CASE( OffCentreSphere_Batch_Test )
+{
+  RNG.seed(5489u);
+  size_t events = 0;
+  for (size_t i(0); i < 5000; ++i)
+    {
+      const Vector rij = (1.0 + 1.5 * dist01(RNG)) * random_unit_vec();
+      const Vector vij = 3 * random_vec();
+      const Vector angvi = 4 * random_vec(), angvj = 4 * random_vec();
+      const double invgamma = (i % 2) ? 0 : 0.1 * dist01(RNG);
+      const double maxdist = rij.nrm() + vij.nrm() * search_time;
+
+      //Two bodies of up to four spheres each
+      std::vector<std::pair<Vector, double> > spheresi, spheresj;
+      for (size_t j(0); j < 1 + i % 4; ++j)
+	{
+	  spheresi.push_back(std::make_pair(0.5 * dist01(RNG) * random_unit_vec(), 0.25 + 0.5 * dist01(RNG)));
+	  spheresj.push_back(std::make_pair(0.5 * dist01(RNG) * random_unit_vec(), 0.25 + 0.5 * dist01(RNG)));
+	}
+
+      bool overlapping = false;
+      for (const auto& si : spheresi)
+	for (const auto& sj : spheresj)
+	  overlapping |= (rij + si.first - sj.first).nrm() < 0.5 * (si.second + sj.second);
+      if (overlapping) continue;
+
+      magnet::intersection::OffcentreSpheresBatch batch(rij, vij, angvi, angvj, maxdist, 0, invgamma);
+      for (const auto& sphere : spheresi)
+	batch.addSphere1(sphere.first, sphere.second);
+      for (const auto& sphere : spheresj)
+	batch.addSphere2(sphere.first, sphere.second);
+
+      //The reference is the earliest event of the pairs, each solved individually
+      std::pair<bool, double> reference(false, HUGE_VAL);
+      for (const auto& si : spheresi)
+	for (const auto& sj : spheresj)
+	  {
+	    const auto test = reference_event(rij, vij, angvi, angvj, si.first, sj.first, si.second, sj.second, invgamma, search_time);
+	    if (test.second < reference.second)
+	      reference = test;
+	  }
+
+      check_same_event(batch.nextEvent(0, search_time), reference);
+      events += (reference.second != HUGE_VAL);
+    }
+  BOOST_CHECK(events > 200);
+}
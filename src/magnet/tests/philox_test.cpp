@@ -0,0 +1,112 @@
+#define BOOST_TEST_MODULE Philox_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/math/philox.hpp>
+#include <vector>
+#include <cmath>
+
+using namespace magnet::math;
+
+//Known answer tests from the Random123 distribution
+BOOST_AUTO_TEST_CASE( Philox_known_answers )
+{
+  {
+    const Philox::Counter r = Philox::block(Philox::Counter{{0, 0, 0, 0}}, Philox::Key{{0, 0}});
+    BOOST_CHECK_EQUAL(r[0], 0x6627e8d5u);
+    BOOST_CHECK_EQUAL(r[1], 0xe169c58du);
+    BOOST_CHECK_EQUAL(r[2], 0xbc57ac4cu);
+    BOOST_CHECK_EQUAL(r[3], 0x9b00dbd8u);
+  }
+
+  {
+    const Philox::Counter r = Philox::block(Philox::Counter{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, Philox::Key{{0xffffffff, 0xffffffff}});
+    BOOST_CHECK_EQUAL(r[0], 0x408f276du);
+    BOOST_CHECK_EQUAL(r[1], 0x41c83b0eu);
+    BOOST_CHECK_EQUAL(r[2], 0xa20bc7c6u);
+    BOOST_CHECK_EQUAL(r[3], 0x6d5451fdu);
+  }
+
+  {
+    const Philox::Counter r = Philox::block(Philox::Counter{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, Philox::Key{{0xa4093822, 0x299f31d0}});
+    BOOST_CHECK_EQUAL(r[0], 0xd16cfe09u);
+    BOOST_CHECK_EQUAL(r[1], 0x94fdccebu);
+    BOOST_CHECK_EQUAL(r[2], 0x5001e420u);
+    BOOST_CHECK_EQUAL(r[3], 0x24126ea1u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( Philox_seek_and_bulk )
+{
+  Philox reference(12345, 7);
+  std::vector<uint32_t> sequence(103);
+  for (uint32_t& val : sequence)
+    val = reference();
+  BOOST_CHECK_EQUAL(reference.tell(), sequence.size());
+
+  //Bulk generation from an unaligned position matches the scalar sequence
+  Philox bulk(12345, 7);
+  bulk();
+  std::vector<uint32_t> words(sequence.size() - 1);
+  bulk.generate(words.data(), words.size());
+  for (size_t i(0); i < words.size(); ++i)
+    BOOST_CHECK_EQUAL(words[i], sequence[i + 1]);
+
+  //Seeking to any position resumes the sequence
+  for (size_t pos : {0, 1, 4, 5, 10, 57})
+    {
+      Philox seeker(12345, 7);
+      seeker.seek(pos);
+      BOOST_CHECK_EQUAL(seeker.tell(), pos);
+      BOOST_CHECK_EQUAL(seeker(), sequence[pos]);
+    }
+
+  //Different streams differ
+  Philox other(12345, 8);
+  size_t matches = 0;
+  for (size_t i(0); i < sequence.size(); ++i)
+    matches += (other() == sequence[i]);
+  BOOST_CHECK(matches < 3);
+}
+
+BOOST_AUTO_TEST_CASE( Philox_distributions )
+{
+  Philox rng(42);
+  const size_t N = 1000000;
+  std::vector<double> vals(N);
+
+  rng.uniform(vals.data(), N);
+  double sum = 0, sum2 = 0;
+  for (double v : vals)
+    {
+      BOOST_CHECK(v >= 0 && v < 1);
+      sum += v;
+      sum2 += v * v;
+    }
+  BOOST_CHECK_SMALL(sum / N - 0.5, 0.002);
+  BOOST_CHECK_SMALL(sum2 / N - 1.0 / 3, 0.002);
+
+  //An odd count checks the unpaired variate
+  rng.normal(vals.data(), N - 1);
+  sum = sum2 = 0;
+  double sum4 = 0;
+  for (size_t i(0); i < N - 1; ++i)
+    {
+      const double v2 = vals[i] * vals[i];
+      sum += vals[i];
+      sum2 += v2;
+      sum4 += v2 * v2;
+    }
+  BOOST_CHECK_SMALL(sum / N, 0.005);
+  BOOST_CHECK_SMALL(sum2 / N - 1, 0.01);
+  BOOST_CHECK_SMALL(sum4 / N - 3, 0.05);
+
+  //Indices are in range and evenly spread
+  std::vector<size_t> counts(10);
+  for (size_t i(0); i < N; ++i)
+    {
+      const size_t idx = Philox::toIndex(rng(), counts.size());
+      BOOST_REQUIRE(idx < counts.size());
+      ++counts[idx];
+    }
+  for (size_t c : counts)
+    BOOST_CHECK_SMALL(double(c) / N - 0.1, 0.002);
+}
@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE SmallVector_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/containers/small_vector.hpp>
+#include <memory>
+#include <vector>
+
+using namespace magnet::containers;
+
+BOOST_AUTO_TEST_CASE( SmallVector_inline )
+{
+  SmallVector<int, 2> vec;
+  BOOST_CHECK(vec.empty());
+  BOOST_CHECK(!vec.onHeap());
+
+  vec.push_back(1);
+  vec.push_back(2);
+  BOOST_CHECK_EQUAL(vec.size(), 2);
+  BOOST_CHECK(!vec.onHeap());
+  BOOST_CHECK_EQUAL(vec.front(), 1);
+  BOOST_CHECK_EQUAL(vec.back(), 2);
+
+  int sum = 0;
+  for (const int& val : vec)
+    sum += val;
+  BOOST_CHECK_EQUAL(sum, 3);
+}
+
+BOOST_AUTO_TEST_CASE( SmallVector_spill )
+{
+  SmallVector<int, 2> vec;
+  for (int i(0); i < 100; ++i)
+    vec.push_back(i);
+  BOOST_CHECK(vec.onHeap());
+  BOOST_CHECK_EQUAL(vec.size(), 100);
+  for (int i(0); i < 100; ++i)
+    BOOST_CHECK_EQUAL(vec[i], i);
+
+  //Clearing keeps the heap storage for reuse
+  const size_t capacity = vec.capacity();
+  vec.clear();
+  BOOST_CHECK(vec.empty());
+  BOOST_CHECK_EQUAL(vec.capacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE( SmallVector_copy_move )
+{
+  //Use a type with a non-trivial destructor to check for leaks and
+  //double deletions
+  typedef std::shared_ptr<int> Ptr;
+  Ptr counter = std::make_shared<int>(0);
+  
+  for (size_t N : std::vector<size_t>{1, 2, 10})
+    {
+      {
+	SmallVector<Ptr, 2> vec;
+	for (size_t i(0); i < N; ++i)
+	  vec.push_back(counter);
+	BOOST_CHECK_EQUAL(counter.use_count(), N + 1);
+
+	SmallVector<Ptr, 2> copy(vec);
+	BOOST_CHECK_EQUAL(counter.use_count(), 2 * N + 1);
+	
+	SmallVector<Ptr, 2> moved(std::move(copy));
+	BOOST_CHECK(copy.empty());
+	BOOST_CHECK_EQUAL(moved.size(), N);
+	BOOST_CHECK_EQUAL(counter.use_count(), 2 * N + 1);
+
+	vec = std::move(moved);
+	BOOST_CHECK_EQUAL(vec.size(), N);
+	BOOST_CHECK_EQUAL(counter.use_count(), N + 1);
+
+	moved = vec;
+	BOOST_CHECK_EQUAL(counter.use_count(), 2 * N + 1);
+
+	vec.pop_back();
+	BOOST_CHECK_EQUAL(counter.use_count(), 2 * N);
+      }
+      BOOST_CHECK_EQUAL(counter.use_count(), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SmallVector_self_append )
+{
+  //Appending an element of the container itself must remain valid
+  //when the append forces the storage to grow
+  typedef std::shared_ptr<int> Ptr;
+  SmallVector<Ptr, 2> vec;
+  vec.push_back(std::make_shared<int>(0));
+  for (int i(1); i < 20; ++i)
+    {
+      vec.push_back(vec[0]);
+      vec.emplace_back(vec.back());
+    }
+  BOOST_CHECK_EQUAL(vec.size(), 39);
+  BOOST_CHECK_EQUAL(vec[0].use_count(), 39);
+  for (const Ptr& val : vec)
+    BOOST_CHECK(val == vec[0]);
+
+  SmallVector<std::vector<int>, 1> vecs;
+  vecs.push_back(std::vector<int>(100, 7));
+  for (int i(0); i < 10; ++i)
+    vecs.push_back(vecs[i]);
+  for (const std::vector<int>& val : vecs)
+    BOOST_CHECK(val == std::vector<int>(100, 7));
+}
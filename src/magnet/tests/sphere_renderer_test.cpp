@@ -0,0 +1,65 @@
+#define BOOST_TEST_MODULE SphereRenderer_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/image/sphere_renderer.hpp>
+
+using namespace magnet::image;
+using namespace magnet::math;
+
+namespace {
+  SphereRenderer::Colour pixel(const SphereRenderer& renderer, size_t x, size_t y)
+  {
+    const uint8_t* p = &renderer.getImage()[3 * (y * renderer.getWidth() + x)];
+    return SphereRenderer::Colour{{p[0], p[1], p[2]}};
+  }
+}
+
+BOOST_AUTO_TEST_CASE( SphereRenderer_single )
+{
+  //A 2x2 view of the z=0 plane, with a unit diameter sphere at the
+  //centre of the upper right quadrant.
+  SphereRenderer renderer(100, 100);
+  renderer.setView(Vector{0, 0, 0}, Vector{0, 0, -1}, Vector{0, 1, 0}, 2);
+  renderer.drawSphere(Vector{0.5, 0.5, 0}, 0.5, SphereRenderer::Colour{{255, 0, 0}});
+
+  //The background is untouched
+  const SphereRenderer::Colour white{{255, 255, 255}};
+  BOOST_CHECK(pixel(renderer, 5, 5) == white);
+  BOOST_CHECK(pixel(renderer, 25, 75) == white);
+  BOOST_CHECK(pixel(renderer, 95, 95) == white);
+
+  //The sphere is drawn red, in the upper right of the image (the
+  //first row is the top of the image)
+  const SphereRenderer::Colour centre = pixel(renderer, 75, 25);
+  BOOST_CHECK(centre[0] > 100);
+  BOOST_CHECK(centre[1] < centre[0]);
+
+  //The light comes from the upper left
+  BOOST_CHECK(pixel(renderer, 60, 10)[0] > pixel(renderer, 90, 40)[0]);
+}
+
+BOOST_AUTO_TEST_CASE( SphereRenderer_depth )
+{
+  //The nearest sphere must be visible, whatever the drawing order
+  for (size_t order(0); order < 2; ++order)
+    {
+      SphereRenderer renderer(64, 64);
+      renderer.setView(Vector{0, 0, 0}, Vector{1, 0, 0}, Vector{0, 0, 1}, 4);
+
+      const Vector nearPos{-1, 0, 0}, farPos{1, 0, 0};
+      const SphereRenderer::Colour green{{0, 255, 0}}, blue{{0, 0, 255}};
+      if (order)
+	{
+	  renderer.drawSphere(nearPos, 1, green);
+	  renderer.drawSphere(farPos, 1, blue);
+	}
+      else
+	{
+	  renderer.drawSphere(farPos, 1, blue);
+	  renderer.drawSphere(nearPos, 1, green);
+	}
+
+      const SphereRenderer::Colour centre = pixel(renderer, 32, 32);
+      BOOST_CHECK(centre[1] > 0);
+      BOOST_CHECK_EQUAL(int(centre[2]), int(centre[0]));
+    }
+}
@@ -0,0 +1,50 @@
+#define BOOST_TEST_MODULE SphericalHarmonics_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/math/special_functions/spherical_harmonic.hpp>
+#include <magnet/math/spherical_harmonics.hpp>
+#include <random>
+
+std::mt19937 RNG;
+std::normal_distribution<double> normal_dist(0, 1);
+using namespace magnet::math;
+
+const size_t testcount = 1000;
+const size_t maxl = 13;
+const double errlvl = 1e-11;
+
+void check(const SphericalHarmonics& harmonics, Vector dir)
+{
+  std::vector<std::complex<double> > Y(harmonics.size());
+  harmonics(dir, Y.data());
+
+  const double theta = std::acos(dir[2]);
+  const double phi = std::atan2(dir[1], dir[0]);
+  for (size_t l(0); l < maxl; ++l)
+    for (size_t m(0); m <= l; ++m)
+      {
+	const std::complex<double> expected = boost::math::spherical_harmonic(l, m, theta, phi);
+	BOOST_CHECK_SMALL(std::abs(Y[SphericalHarmonics::index(l, m)] - expected), errlvl);
+      }
+}
+
+BOOST_AUTO_TEST_CASE( SphericalHarmonics_boost )
+{
+  RNG.seed();
+  SphericalHarmonics harmonics(maxl);
+  BOOST_CHECK_EQUAL(harmonics.size(), maxl * (maxl + 1) / 2);
+
+  for (size_t i(0); i < testcount; ++i)
+    {
+      Vector dir{normal_dist(RNG), normal_dist(RNG), normal_dist(RNG)};
+      check(harmonics, dir / dir.nrm());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SphericalHarmonics_poles )
+{
+  SphericalHarmonics harmonics(maxl);
+  check(harmonics, Vector{0, 0, 1});
+  check(harmonics, Vector{0, 0, -1});
+  check(harmonics, Vector{1, 0, 0});
+  check(harmonics, Vector{0, -1, 0});
+}
@@ -1,7 +1,10 @@
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <chrono>
+#include <atomic>
 #include <magnet/thread/threadpool.hpp>
+#include <magnet/thread/workstealingpool.hpp>
 
 std::vector<float> sums;
 
@@ -33,8 +36,108 @@ struct A
   { std::cerr << "Inside memberfunc3, i=" << i << ", j=" << j << "\n"; }
 };
 
+double seconds_since(std::chrono::high_resolution_clock::time_point start)
+{ return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count(); }
+
+std::atomic<size_t> counter;
+
+void increment() { counter.fetch_add(1, std::memory_order_relaxed); }
+
+void workStealingTests()
+{
+  magnet::thread::WorkStealingPool pool;
+  
+  for (size_t threads(0); threads < 5; threads += 2)
+    {
+      pool.setThreadCount(threads);
+
+      //parallel_for must visit every index exactly once
+      std::vector<int> visits(100003, 0);
+      pool.parallel_for(0, visits.size(), [&](size_t i) { ++visits[i]; });
+      for (size_t i(0); i < visits.size(); ++i)
+	if (visits[i] != 1)
+	  throw std::runtime_error("parallel_for did not visit every index once");
+
+      //parallel_reduce must match the serial sum
+      const size_t N = 1000001;
+      const size_t sum = pool.parallel_reduce(size_t(0), N, size_t(0), 
+					      [](size_t b, size_t e) { size_t s(0); for (size_t i(b); i < e; ++i) s += i; return s; },
+					      [](size_t a, size_t b) { return a + b; });
+      if (sum != N * (N - 1) / 2)
+	throw std::runtime_error("parallel_reduce gave the wrong sum");
+
+      //Nested submissions and waits from within tasks
+      counter = 0;
+      magnet::thread::WaitGroup outer;
+      for (size_t i(0); i < 100; ++i)
+	pool.submit(outer, [&pool]() {
+	    magnet::thread::WaitGroup inner;
+	    for (size_t j(0); j < 100; ++j)
+	      pool.submit(inner, increment);
+	    pool.wait(inner);
+	  });
+      pool.wait(outer);
+      if (counter != 100 * 100)
+	throw std::runtime_error("Nested tasks were lost");
+
+      //Exceptions are passed to the waiting thread
+      magnet::thread::WaitGroup wg;
+      pool.submit(wg, []() { throw std::runtime_error("Expected"); });
+      bool caught = false;
+      try { pool.wait(wg); } catch (std::runtime_error&) { caught = true; }
+      if (!caught)
+	throw std::runtime_error("Task exception was not rethrown");
+    }
+}
+
+/* Compare the throughput of tiny tasks submitted from the main
+   thread to the ThreadPool and the WorkStealingPool.
+*/
+void throughputBenchmark()
+{
+  const size_t tasks = 100000;
+  const size_t threads = 4;
+
+  magnet::thread::ThreadPool oldpool;
+  oldpool.setThreadCount(threads);
+  counter = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i(0); i < tasks; ++i)
+    oldpool.queueTask(std::function<void()>(increment));
+  oldpool.wait();
+  const double oldtime = seconds_since(start);
+  if (counter != tasks)
+    throw std::runtime_error("ThreadPool lost tasks");
+
+  magnet::thread::WorkStealingPool newpool;
+  newpool.setThreadCount(threads);
+  counter = 0;
+  start = std::chrono::high_resolution_clock::now();
+  magnet::thread::WaitGroup wg;
+  for (size_t i(0); i < tasks; ++i)
+    newpool.submit(wg, increment);
+  newpool.wait(wg);
+  const double newtime = seconds_since(start);
+  if (counter != tasks)
+    throw std::runtime_error("WorkStealingPool lost tasks");
+
+  counter = 0;
+  start = std::chrono::high_resolution_clock::now();
+  newpool.parallel_for(0, tasks, [](size_t) { increment(); });
+  const double fortime = seconds_since(start);
+  if (counter != tasks)
+    throw std::runtime_error("WorkStealingPool::parallel_for lost tasks");
+
+  std::cerr << tasks << " tasks on " << threads << " threads: ThreadPool " << oldtime
+	    << "s, WorkStealingPool " << newtime << "s (parallel_for " << fortime
+	    << "s), speedup " << oldtime / newtime << "\n";
+}
+
 int main()
 {
+  workStealingTests();
+  throughputBenchmark();
+
   int N = 1000;
   sums.resize(N);
 
@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE TripleBuffer_test
+#include <boost/test/included/unit_test.hpp>
+#include <magnet/thread/triplebuffer.hpp>
+#include <thread>
+#include <vector>
+
+using namespace magnet::thread;
+
+BOOST_AUTO_TEST_CASE( TripleBuffer_sequential )
+{
+  TripleBuffer<int> buf;
+  BOOST_CHECK(!buf.consume());
+
+  buf.back() = 1;
+  buf.publish();
+  BOOST_CHECK(buf.consume());
+  BOOST_CHECK_EQUAL(buf.front(), 1);
+  //Nothing new has been published
+  BOOST_CHECK(!buf.consume());
+  BOOST_CHECK_EQUAL(buf.front(), 1);
+
+  //Only the latest value is consumed
+  buf.back() = 2;
+  buf.publish();
+  buf.back() = 3;
+  buf.publish();
+  BOOST_CHECK(buf.consume());
+  BOOST_CHECK_EQUAL(buf.front(), 3);
+  BOOST_CHECK(!buf.consume());
+
+  //The front buffer is not disturbed by the producer
+  buf.back() = 4;
+  BOOST_CHECK_EQUAL(buf.front(), 3);
+  buf.publish();
+  buf.back() = 5;
+  BOOST_CHECK_EQUAL(buf.front(), 3);
+}
+
+BOOST_AUTO_TEST_CASE( TripleBuffer_threaded )
+{
+  //The producer writes whole frames of a single value, the consumer
+  //must never see a torn frame or a frame older than the last one
+  //it saw.
+  const size_t frames = 100000;
+  const size_t frameSize = 64;
+  TripleBuffer<std::vector<size_t> > buf;
+  for (size_t i(0); i < 3; ++i)
+    buf[i].assign(frameSize, 0);
+
+  std::thread producer([&]() {
+      for (size_t frame(1); frame <= frames; ++frame)
+	{
+	  for (size_t& val : buf.back())
+	    val = frame;
+	  buf.publish();
+	}
+    });
+
+  size_t last = 0, torn = 0, reversed = 0;
+  while (last != frames)
+    {
+      if (!buf.consume()) continue;
+      const std::vector<size_t>& data = buf.front();
+      for (size_t val : data)
+	torn += (val != data[0]);
+      reversed += (data[0] <= last);
+      last = data[0];
+    }
+  producer.join();
+
+  BOOST_CHECK_EQUAL(torn, 0);
+  BOOST_CHECK_EQUAL(reversed, 0);
+}